@@ -0,0 +1,25 @@
+/**
+ * @file audio.c
+ * @brief Plays the sounds for the events raised by the simulation.
+ * 
+ */
+
+#include "game.h"
+
+// Rapid flaps overlap up to a limit instead of cutting each other off, and
+// the hit sound outranks them when the voices run out.
+static const ClipPlayback flapPlayback = { .priority = 0, .maxInstances = FLAP_MAX_VOICES, .volume = 1.0f };
+static const ClipPlayback hitPlayback = { .priority = 1, .maxInstances = 1, .volume = 1.0f };
+
+/**
+ * @brief Plays the sounds for the events raised by the last update.
+ * 
+ * Playing only queues a command for the mixer's audio thread, so this never
+ * blocks on the audio device.
+ * 
+ * @param game A pointer to the game.
+ */
+void PlayGameSounds(Game *game) {
+    if (game->events & GAME_EVENT_FLAP) PlayAudioClip(game->flapClip, flapPlayback);
+    if (game->events & GAME_EVENT_HIT) PlayAudioClip(game->hitClip, hitPlayback);
+}
@@ -11,11 +11,64 @@
 
 #define SCREEN_WIDTH 512        /**< The width of the screen in pixels. */
 #define SCREEN_HEIGHT 768       /**< The height of the screen in pixels. */
+
+// Gameplay tunables can be overridden from the compiler command line
+// (e.g. -DPIPE_GAP=180) when sweeping values with the headless runner.
+#ifndef GRAVITY
 #define GRAVITY 980.0f          /**< The force of gravity. */
+#endif
+#ifndef JUMP_FORCE
 #define JUMP_FORCE -400.0f      /**< The force of the bird's jump. */
+#endif
 #define PIPE_WIDTH 80           /**< The width of the pipes. */
+#ifndef PIPE_GAP
 #define PIPE_GAP 200            /**< The gap between the pipes. */
+#endif
+#ifndef PIPE_SPEED
 #define PIPE_SPEED 200.0f       /**< The speed of the pipes. */
+#endif
+#ifndef PIPE_SPACING
+#define PIPE_SPACING 200        /**< The horizontal distance between new pipes. */
+#endif
+
+// Debug builds of the windowed game read the tunables above through
+// TUNED(), from values TUNABLES_FILE overrides while the game runs. Other
+// builds fold TUNED() back to the constant.
+#define GAME_TUNABLES(X) X(GRAVITY) X(JUMP_FORCE) X(PIPE_GAP) X(PIPE_SPEED) X(PIPE_SPACING)
+#define TUNABLES_FILE "assets/foss_flapper/tunables.txt"   /**< The live overrides of debug builds. */
+#if defined(DEBUG) && !defined(HEADLESS)
+#define GAME_TUNABLES_LIVE
+#define TUNED(game, name) ((game)->tunables[TUNABLE_##name])
+#else
+#define TUNED(game, name) (name)
+#endif
+#define PIPE_CAPACITY 8         /**< The most pipes in play at once. */
 #define BIRD_RADIUS 16.0f       /**< The radius of the bird. */
+#define SPRITE_BATCH_CAPACITY 256   /**< The most sprites batched before an early flush. */
+#define HUD_TEXT_GLYPHS 32      /**< The most glyphs in one HUD string. */
+#define LEVEL_ARENA_SIZE (64 * 1024)    /**< The bytes reserved for one round's state. */
+#define FRAME_ARENA_SIZE (16 * 1024)    /**< The bytes of per-update scratch memory. */
+#define GAME_SNAPSHOT_VERSION 1 /**< The layout version of SaveGameState; bump when the state changes. */
+#define GAME_SNAPSHOT_SIZE (LEVEL_ARENA_SIZE + 1024)  /**< The bytes a snapshot of the whole simulation needs at most. */
+#define GAME_CHECKSUM_SIZE (PIPE_CAPACITY * 3 * sizeof(float) + 256)  /**< The bytes GetGameStateChecksum hashes at most. */
+#define TARGET_FPS 60           /**< The frame rate cap, paced to the display (0 for uncapped). */
+#define LATENCY_FLASH_SIZE 64    /**< The side of the latency test's photodiode patch in pixels. */
+#define IDLE_POLL_RATE 60.0     /**< The input polls per second while a skipped screen cannot block for input. */
+#define TICK_RATE 120.0f        /**< The fixed simulation rate in ticks per second. */
+#define MAX_CATCHUP_STEPS 8     /**< The most simulation ticks run in a single frame. */
+#define JOB_WORKERS -1          /**< The job system's worker threads (-1 for one per extra core). */
+#define ASSET_CAPACITY 16       /**< The most assets the loader tracks. */
+#define ASSET_UPLOAD_BUDGET 0.002   /**< The seconds per frame spent on GPU and audio uploads. */
+#define MIXER_VOICES 8          /**< The voices the audio mixer can play at once. */
+#define FLAP_MAX_VOICES 3       /**< The most flap sounds that overlap. */
+#define FEATHER_CAPACITY 1024   /**< The most feather particles alive at once. */
+#define FEATHERS_PER_FLAP 12    /**< The feathers shed on each flap. */
+#define FEATHER_GRAVITY 300.0f  /**< The pull on falling feathers. */
+#define FEATHER_DRAG 2.0f       /**< The air drag on feathers. */
+#define DEBRIS_CAPACITY (128 * 1024)    /**< The most debris particles alive at once. */
+#define DEBRIS_PER_HIT 2000     /**< The debris thrown off by a hit. */
+#define DEBRIS_DRAG 0.5f        /**< The air drag on debris. */
+#define METRICS_INTERVAL 10.0   /**< The seconds between telemetry flushes with --metrics. */
+#define METRICS_PREFIX "foss_flapper"   /**< The StatsD prefix of the game's metrics. */
 
 #endif // CONFIG_H
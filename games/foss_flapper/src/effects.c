@@ -0,0 +1,103 @@
+/**
+ * @file effects.c
+ * @brief The particle effects: feathers when the bird flaps, debris when it hits.
+ * 
+ * The effects are cosmetic and live outside the simulation, so they never
+ * change how a seed or a recording plays out. They only run windowed.
+ * 
+ */
+
+#include "game.h"
+
+// Feathers drift back and down from the bird; debris bursts from the impact.
+static const ParticleBurst featherBurst = {
+    .speedMin = 40.0f, .speedMax = 120.0f, .direction = PI * 0.75f, .spread = PI * 0.35f,
+    .lifeMin = 0.4f, .lifeMax = 0.9f, .sizeStart = 6.0f, .sizeEnd = 2.0f,
+    .colorStart = { 255, 255, 255, 255 }, .colorEnd = { 255, 255, 255, 0 }
+};
+static const ParticleBurst debrisBurst = {
+    .speedMin = 60.0f, .speedMax = 420.0f, .direction = 0.0f, .spread = PI,
+    .lifeMin = 0.6f, .lifeMax = 1.6f, .sizeStart = 5.0f, .sizeEnd = 1.0f,
+    .colorStart = { 255, 255, 255, 255 }, .colorEnd = { 255, 255, 255, 0 }
+};
+
+/**
+ * @brief Creates the particle systems.
+ * 
+ * @param game A pointer to the game.
+ * @param load The debris particles to keep alive at all times, for stress tests (0 for none).
+ */
+void InitEffects(Game *game, int load) {
+    game->feathers = CreateParticleSystem(NULL, FEATHER_CAPACITY, FEATHER_GRAVITY, FEATHER_DRAG);
+    game->debris = CreateParticleSystem(NULL, DEBRIS_CAPACITY, TUNED(game, GRAVITY), DEBRIS_DRAG);
+    game->effectsRng = CreateRng(1);
+    game->particleLoad = load < game->debris.capacity ? load : game->debris.capacity;
+}
+
+/**
+ * @brief Frees the particle systems.
+ * 
+ * @param game A pointer to the game.
+ */
+void UnloadEffects(Game *game) {
+    DestroyParticleSystem(&game->feathers);
+    DestroyParticleSystem(&game->debris);
+}
+
+/**
+ * @brief Moves the particles on and retires the dead ones.
+ * 
+ * Only the effects are touched, so this runs while an update is in flight.
+ * 
+ * @param game A pointer to the game.
+ * @param dt The real time since the last call, in seconds.
+ */
+void UpdateEffects(Game *game, float dt) {
+    PROFILE_SCOPE("UpdateEffects");
+    UpdateParticles(&game->feathers, dt);
+    UpdateParticles(&game->debris, dt);
+}
+
+/**
+ * @brief Emits the particles for the events raised by the last update.
+ * 
+ * @param game A pointer to the game.
+ */
+void EmitGameEffects(Game *game) {
+    Bird *bird = &game->bird;
+    
+    if (game->events & GAME_EVENT_FLAP) {
+        Vector2 drift = { -TUNED(game, PIPE_SPEED) * 0.5f, bird->velocity.y * 0.25f };
+        EmitParticles(&game->feathers, &featherBurst, bird->position, drift, FEATHERS_PER_FLAP, &game->effectsRng);
+    }
+    if (game->events & GAME_EVENT_HIT) {
+        EmitParticles(&game->debris, &debrisBurst, bird->position, (Vector2){ 0, 0 }, DEBRIS_PER_HIT, &game->effectsRng);
+    }
+    
+    // Under a stress load, top the debris up from the middle of the screen.
+    int missing = game->particleLoad - game->debris.count;
+    if (missing > 0) {
+        Vector2 center = { SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f };
+        EmitParticles(&game->debris, &debrisBurst, center, (Vector2){ 0, -200.0f }, missing, &game->effectsRng);
+    }
+}
+
+/**
+ * @brief Checks whether any particle is still alive, so the screen is changing.
+ * 
+ * @param game A pointer to the game.
+ * @return true if particles are alive, false otherwise.
+ */
+bool HasLiveEffects(const Game *game) {
+    return game->feathers.count > 0 || game->debris.count > 0;
+}
+
+/**
+ * @brief Draws the particles, one batched run per system.
+ * 
+ * @param game A pointer to the game.
+ */
+void DrawEffects(const Game *game) {
+    DrawParticles(&game->feathers);
+    DrawParticles(&game->debris);
+}
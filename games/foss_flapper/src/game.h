@@ -0,0 +1,224 @@
+/**
+ * @file game.h
+ * @brief The FOSS Flapper game state shared by its modules.
+ * 
+ * The game is split into physics (the fixed-tick simulation), render,
+ * audio, effects and the entry points in main.c and headless.c. Everything they
+ * share is declared here.
+ * 
+ */
+
+#ifndef FOSS_FLAPPER_GAME_H
+#define FOSS_FLAPPER_GAME_H
+
+#include "raylib.h"
+#include "corelib.h"
+#include "config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief The current state of the game.
+ * 
+ */
+typedef enum {
+    READY,      /**< The game is ready to be played. */
+    PLAYING,    /**< The game is currently being played. */
+    GAME_OVER   /**< The game is over. */
+} GameState;
+
+/**
+ * @brief Things that happened during an update, for audio and other observers.
+ * 
+ */
+typedef enum {
+    GAME_EVENT_FLAP  = 1 << 0,  /**< The bird flapped. */
+    GAME_EVENT_HIT   = 1 << 1,  /**< The bird hit a pipe or the screen edge. */
+    GAME_EVENT_SCORE = 1 << 2,  /**< The bird passed a pipe. */
+    GAME_EVENT_INPUT = 1 << 3,  /**< A tick had input; the update's view responds to a press. */
+    GAME_EVENT_START = 1 << 4   /**< A round started. */
+} GameEvent;
+
+/**
+ * @brief The player actions, one InputBits flag each.
+ * 
+ */
+typedef enum {
+    ACTION_FLAP = 1 << 0    /**< Flap, start or restart. */
+} GameAction;
+
+/**
+ * @brief The sprite batch layers, drawn from lowest to highest.
+ * 
+ */
+typedef enum {
+    LAYER_PIPES,    /**< The pipes. */
+    LAYER_BIRD,     /**< The bird, drawn over the pipes. */
+    LAYER_HUD       /**< The score and messages, drawn over everything. */
+} DrawLayer;
+
+#ifdef GAME_TUNABLES_LIVE
+/**
+ * @brief The index of each live tunable in Game.tunables.
+ * 
+ */
+#define TUNABLE_INDEX(name) TUNABLE_##name,
+typedef enum {
+    GAME_TUNABLES(TUNABLE_INDEX)
+    TUNABLE_COUNT
+} Tunable;
+#endif
+
+/**
+ * @brief A struct that represents the bird.
+ * 
+ */
+typedef struct {
+    Vector2 position;       /**< The bird's position. */
+    Vector2 prevPosition;   /**< The bird's position at the previous tick. */
+    Vector2 velocity;       /**< The bird's velocity. */
+    float radius;           /**< The bird's radius. */
+    Animation animation;    /**< The bird's animation. */
+} Bird;
+
+/**
+ * @brief A struct that manages the pipes.
+ * 
+ * Each pipe pair is one obstacle in a structure-of-arrays field, so moving,
+ * recycling and testing the pipes runs as batch kernels. The pool hands out
+ * a handle per pipe and keeps the field's order: pool index i is obstacle i.
+ * Both live in the level arena, so spawning never allocates.
+ * 
+ */
+typedef struct {
+    ObstacleField pipes;    /**< The pipes, one obstacle per top/bottom pair. */
+    ObjectPool pool;        /**< The pipe handles, in the same dense order as the pipes. */
+    float spacing;          /**< The horizontal distance between spawned pipes. */
+    float nextSpawnX;       /**< Where the next pipe spawns; scrolls with the pipes. */
+} PipeManager;
+
+/**
+ * @brief The HUD strings.
+ * 
+ * Each string keeps its laid out glyphs and is only laid out again when its
+ * text changes, so the fixed messages are laid out once and the scores once
+ * per change. The strings are drawn into two cached layers, which are in
+ * turn only redrawn when their content changes.
+ * 
+ */
+typedef struct {
+    CachedText score;       /**< The current score. */
+    CachedText highScore;   /**< The high score. */
+    CachedText title;       /**< The title on the ready screen. */
+    CachedText startHint;   /**< The start prompt on the ready screen. */
+    CachedText gameOver;    /**< The game over banner. */
+    CachedText finalScore;  /**< The score on the game over screen. */
+    CachedText restartHint; /**< The restart prompt on the game over screen. */
+    CachedLayer scoreLayer;     /**< The scores, redrawn when they change. */
+    CachedLayer messageLayer;   /**< The READY or GAME_OVER messages, redrawn when they change. */
+} Hud;
+
+/**
+ * @brief What one frame draws, copied out of the simulation.
+ * 
+ * The update publishes a view when it finishes and DrawGame only reads
+ * views, so the next update can run on a worker while the last view is
+ * drawn. A view owns copies of everything it shows, already interpolated,
+ * and nothing in it points into the simulation's arenas.
+ * 
+ */
+typedef struct {
+    bool respondsToInput;       /**< Whether the update that published the view applied a press. */
+    GameState gameState;        /**< The game state. */
+    int score;                  /**< The player's score. */
+    int highScore;              /**< The player's high score. */
+    Vector2 birdPosition;       /**< The bird's interpolated position. */
+    Animation bird;             /**< The bird's current frame as a one-frame animation. */
+    AnimationFrame birdFrame;   /**< The storage bird.frames points at. */
+    ObstacleField pipes;        /**< The pipes at their interpolated positions. */
+} FrameView;
+
+/**
+ * @brief A struct that represents the game's state.
+ * 
+ */
+typedef struct {
+    Bird bird;                  /**< The bird. */
+    PipeManager pipeManager;    /**< The pipe manager. */
+    GameState gameState;        /**< The current game state. */
+    FixedStep step;             /**< The fixed-timestep simulation clock. */
+    InputStream input;          /**< The per-tick input, live, recorded or replayed. */
+    Rng rng;                    /**< The random source for pipe gaps. */
+    unsigned int events;        /**< The GameEvent flags raised by the last update. */
+    int score;                  /**< The player's score. */
+    int highScore;              /**< The player's high score. */
+    AssetHandle atlasAsset;     /**< The loader handle of the texture atlas. */
+    AssetHandle flapAsset;      /**< The loader handle of the flap sound. */
+    AssetHandle hitAsset;       /**< The loader handle of the hit sound. */
+    AssetHandle animationsAsset;    /**< The loader handle of the animation frame table. */
+    TextureAtlas atlas;         /**< The packed texture atlas holding every sprite (owned by the loader). */
+    AnimationTable animations;  /**< The frame table every animation shares (owned by the loader). */
+    int birdClip;               /**< The frame table clip of the bird. */
+    int pipeRegion;             /**< The atlas region of the pipe. */
+    const AudioClip *flapClip;  /**< The clip played when the bird flaps (owned by the loader). */
+    const AudioClip *hitClip;   /**< The clip played when the bird hits something (owned by the loader). */
+    SpriteBatch spriteBatch;    /**< The batch that collects the frame's sprites. */
+    Hud hud;                    /**< The cached HUD text. */
+    ParticleSystem feathers;    /**< The feathers shed by flaps. */
+    ParticleSystem debris;      /**< The debris thrown off by hits. */
+    Rng effectsRng;             /**< The random source for particles, apart from the simulation's. */
+    int particleLoad;           /**< The debris kept alive at all times for stress tests, 0 normally. */
+    FrameView views[2];         /**< The double-buffered views: one drawn while the update fills the other. */
+    Arena levelArena;           /**< The memory for one round, released on restart. */
+    Arena frameArena;           /**< The scratch memory for one update, released every update. */
+    bool showProfiler;          /**< Whether the profiler overlay is drawn (profile builds only). */
+    bool allowIdleFrames;       /**< Whether DrawGame may skip frames that would not change. */
+    bool latencyFlash;          /**< Whether views that respond to input flash a corner for a photodiode. */
+    uint64_t presentedKey;      /**< The content key of the last drawn frame, 0 if it was changing. */
+    Snapshot checkpoint;        /**< The simulation at the start of the round, for retries. */
+#ifdef GAME_TUNABLES_LIVE
+    float tunables[TUNABLE_COUNT];  /**< The live tunable values TUNED() reads. */
+    TunableSet tuning;          /**< Reloads tunables from TUNABLES_FILE. */
+#endif
+} Game;
+
+// physics.c
+void StartSession(Game *game, uint64_t seed);
+void InitGame(Game *game);
+void UpdateGame(Game *game, InputBits pressed, float frameTime);
+void UpdateGameTimed(Game *game, const InputEvent *events, int eventCount, double now, float frameTime);
+void StepGame(Game *game, InputBits input, float dt);
+void StepPipes(Game *game, float dt);
+bool CheckCollision(const Bird *bird, const ObstacleField *pipes);
+PoolHandle SpawnPipe(Game *game, float x);
+void ReleasePipe(PipeManager *manager, PoolHandle pipe);
+bool SaveGameState(Game *game, Snapshot *snap);
+bool LoadGameState(Game *game, Snapshot *snap);
+uint32_t GetGameStateChecksum(Game *game);
+
+// render.c
+void InitHud(Game *game);
+void UnloadHud(Game *game);
+FrameView CreateFrameView(void);
+void DestroyFrameView(FrameView *view);
+void PublishFrameView(const Game *game, FrameView *view);
+bool IsFrameViewShown(const Game *game, const FrameView *view);
+bool DrawGame(Game *game, const FrameView *view);
+
+// audio.c
+void PlayGameSounds(Game *game);
+
+// effects.c
+void InitEffects(Game *game, int load);
+void UnloadEffects(Game *game);
+void UpdateEffects(Game *game, float dt);
+void EmitGameEffects(Game *game);
+bool HasLiveEffects(const Game *game);
+void DrawEffects(const Game *game);
+
+#ifdef HEADLESS
+// trainer.c
+int TrainPopulation(int generations, int population, int threads, uint64_t seed, long maxTicks);
+#endif
+
+#endif
@@ -0,0 +1,405 @@
+/**
+ * @file headless.c
+ * @brief The headless entry point: batch episodes, recording, replay and training.
+ * 
+ * Built only with -DHEADLESS, which the Makefile's headless rules pass
+ * together with the POSIX feature macro the worker pool needs.
+ * 
+ */
+
+#ifdef HEADLESS
+
+#include "game.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief The input source that drives a headless episode.
+ * 
+ */
+typedef enum {
+    POLICY_RANDOM,      /**< Flap with a fixed chance every tick. */
+    POLICY_AUTOPILOT    /**< Flap when the bird drops below the next gap's center. */
+} InputPolicy;
+
+/**
+ * @brief The settings shared by every headless worker.
+ * 
+ */
+typedef struct {
+    long episodes;          /**< The number of episodes to run in total. */
+    int threads;            /**< The number of worker threads. */
+    uint64_t seed;          /**< The base seed; episode i uses seed + i. */
+    long maxTicks;          /**< The tick limit for a single episode. */
+    InputPolicy policy;     /**< How flaps are chosen. */
+    float flapChance;       /**< The per-tick flap probability for POLICY_RANDOM. */
+    const char *recordFile; /**< Record one session of episodes rounds here, if set. */
+    char **replayFiles;     /**< The recordings to replay instead of running episodes. */
+    int replayCount;        /**< The number of entries in replayFiles. */
+    int trainGenerations;   /**< Evolve flapping policies for this many generations, if set. */
+    int population;         /**< The number of agents per training generation. */
+    const char *jsonFile;   /**< Write the replay tick timings here as benchmark JSON, if set. */
+} SimConfig;
+
+/**
+ * @brief The results gathered by one worker.
+ * 
+ */
+typedef struct {
+    const SimConfig *config;    /**< The shared settings. */
+    atomic_long *nextEpisode;   /**< The shared episode counter. */
+    long episodes;              /**< The episodes this worker ran. */
+    long long ticks;            /**< The simulation ticks this worker ran. */
+    long long scoreSum;         /**< The sum of final scores. */
+    int bestScore;              /**< The best final score. */
+    long timeouts;              /**< The episodes that hit the tick limit. */
+    SampleSet tickNanos;        /**< The wall time of each replayed tick. */
+    int failures;               /**< The recordings that could not be replayed or did not reproduce. */
+} SimWorker;
+
+/**
+ * @brief Decides whether the autopilot flaps this tick.
+ * 
+ * @param game A pointer to the game.
+ * @return true to flap, false otherwise.
+ */
+static bool AutopilotFlap(const Game *game) {
+    const Bird *bird = &game->bird;
+    
+    // Aim for the center of the nearest pipe gap still ahead of the bird.
+    float targetY = SCREEN_HEIGHT / 2.0f;
+    float nearestX = 1e9f;
+    const ObstacleField *pipes = &game->pipeManager.pipes;
+    for (int i = 0; i < pipes->count; i++) {
+        if (pipes->x[i] + pipes->width[i] < bird->position.x - bird->radius) continue;
+        if (pipes->x[i] < nearestX) {
+            nearestX = pipes->x[i];
+            targetY = pipes->gapY[i] + PIPE_GAP * 0.5f;
+        }
+    }
+    
+    return bird->velocity.y > 0.0f && bird->position.y > targetY + PIPE_GAP * 0.1f;
+}
+
+/**
+ * @brief Plays one round from READY until the bird dies or the tick limit.
+ * 
+ * @param game A pointer to a game in the READY state.
+ * @param config The shared settings.
+ * @param input The random source for POLICY_RANDOM.
+ * @param ticks Receives the number of ticks simulated after the start.
+ * @return int The final score.
+ */
+static int PlayRound(Game *game, const SimConfig *config, Rng *input, long *ticks) {
+    // Leave READY with the opening flap, then feed exactly one tick per update.
+    UpdateGame(game, ACTION_FLAP, game->step.dt);
+    long t = 0;
+    while (game->gameState == PLAYING && t < config->maxTicks) {
+        bool flap = (config->policy == POLICY_AUTOPILOT)
+            ? AutopilotFlap(game)
+            : RandomFloat(input) < config->flapChance;
+        UpdateGame(game, flap ? ACTION_FLAP : 0, game->step.dt);
+        t++;
+    }
+    
+    *ticks = t;
+    return game->score;
+}
+
+/**
+ * @brief Runs one complete episode and returns its final score.
+ * 
+ * @param game A pointer to scratch game storage.
+ * @param config The shared settings.
+ * @param episode The episode index, which selects the seed.
+ * @param ticks Receives the number of ticks simulated.
+ * @return int The final score.
+ */
+static int RunEpisode(Game *game, const SimConfig *config, long episode, long *ticks) {
+    Rng input = CreateRng(config->seed + (uint64_t)episode + 0x5EEDull);
+    StartSession(game, config->seed + (uint64_t)episode);
+    return PlayRound(game, config, &input, ticks);
+}
+
+/**
+ * @brief Replays one recording to its end, timing every tick.
+ * 
+ * The replay has to end on the recorded tick, score and state checksum;
+ * one that does not has simulated a different session, and fails.
+ * 
+ * @param game A pointer to scratch game storage.
+ * @param worker The worker that collects the results.
+ * @param fileName The recording to replay.
+ * @return true if the recording was replayed and reproduced, false otherwise.
+ */
+static bool ReplayRecording(Game *game, SimWorker *worker, const char *fileName) {
+    if (!StartInputReplay(&game->input, fileName)) {
+        fprintf(stderr, "Cannot read input recording: %s\n", fileName);
+        return false;
+    }
+    if (game->input.recording.tickRate != TICK_RATE) {
+        fprintf(stderr, "%s was recorded at %.0f Hz, this build ticks at %.0f Hz\n",
+                fileName, (double)game->input.recording.tickRate, (double)TICK_RATE);
+        CloseInputStream(&game->input);
+        return false;
+    }
+    
+    StartSession(game, game->input.recording.seed);
+    while (!IsInputReplayFinished(&game->input)) {
+        uint64_t start = GetClockNanos();
+        UpdateGame(game, 0, game->step.dt);
+        AddSample(&worker->tickNanos, (double)(GetClockNanos() - start));
+        
+        // Count each round as it ends.
+        if (game->events & GAME_EVENT_HIT) {
+            worker->episodes++;
+            worker->scoreSum += game->score;
+            if (game->score > worker->bestScore) worker->bestScore = game->score;
+        }
+    }
+    
+    worker->ticks += game->input.tick;
+    bool reproduced = CheckInputReplayOutcome(&game->input, game->score, GetGameStateChecksum(game));
+    if (!reproduced) fprintf(stderr, "%s did not replay to its recorded end\n", fileName);
+    CloseInputStream(&game->input);
+    return reproduced;
+}
+
+/**
+ * @brief Records one session of config->episodes rounds to config->recordFile.
+ * 
+ * @param config The shared settings.
+ * @return int The exit code.
+ */
+static int RecordSession(const SimConfig *config) {
+    Game game = {0};
+    game.levelArena = CreateArena(LEVEL_ARENA_SIZE);
+    game.frameArena = CreateArena(FRAME_ARENA_SIZE);
+    
+    Rng input = CreateRng(config->seed + 0x5EEDull);
+    StartSession(&game, config->seed);
+    StartInputRecording(&game.input, config->seed, TICK_RATE);
+    
+    // Restart with a flap after every round but the last.
+    long long scoreSum = 0;
+    long rounds = 0;
+    for (; rounds < config->episodes; rounds++) {
+        long ticks = 0;
+        scoreSum += PlayRound(&game, config, &input, &ticks);
+        if (game.gameState == PLAYING) {
+            rounds++;
+            break;
+        }
+        if (rounds + 1 < config->episodes) UpdateGame(&game, ACTION_FLAP, game.step.dt);
+    }
+    
+    SetInputRecordingOutcome(&game.input.recording, game.score, GetGameStateChecksum(&game));
+    bool saved = SaveInputRecording(&game.input.recording, config->recordFile);
+    if (saved) {
+        printf("recorded:  %ld rounds, %u ticks, %d runs, mean score %.2f -> %s\n",
+               rounds, game.input.recording.tickCount, game.input.recording.runCount,
+               rounds ? (double)scoreSum / (double)rounds : 0.0, config->recordFile);
+    } else {
+        fprintf(stderr, "Cannot write input recording: %s\n", config->recordFile);
+    }
+    
+    CloseInputStream(&game.input);
+    DestroyObjectPool(&game.pipeManager.pool);
+    DestroyArena(&game.levelArena);
+    DestroyArena(&game.frameArena);
+    return saved ? 0 : 1;
+}
+
+/**
+ * @brief The worker thread body: pulls episode indices until none remain.
+ * 
+ * In replay mode the indices select recordings instead of seeds.
+ * 
+ * @param arg A pointer to the worker's SimWorker.
+ * @return void* Always NULL.
+ */
+static void *SimWorkerMain(void *arg) {
+    SimWorker *worker = arg;
+    const SimConfig *config = worker->config;
+    Game game = {0};
+    game.levelArena = CreateArena(LEVEL_ARENA_SIZE);
+    game.frameArena = CreateArena(FRAME_ARENA_SIZE);
+    
+    for (;;) {
+        long episode = atomic_fetch_add(worker->nextEpisode, 1);
+        if (config->replayCount > 0) {
+            if (episode >= config->replayCount) break;
+            if (!ReplayRecording(&game, worker, config->replayFiles[episode])) worker->failures++;
+            continue;
+        }
+        if (episode >= config->episodes) break;
+        
+        long ticks = 0;
+        int score = RunEpisode(&game, config, episode, &ticks);
+        worker->episodes++;
+        worker->ticks += ticks;
+        worker->scoreSum += score;
+        if (score > worker->bestScore) worker->bestScore = score;
+        if (ticks >= config->maxTicks) worker->timeouts++;
+    }
+    
+    DestroyObjectPool(&game.pipeManager.pool);
+    DestroyArena(&game.levelArena);
+    DestroyArena(&game.frameArena);
+    return NULL;
+}
+
+/**
+ * @brief Prints the command line usage.
+ * 
+ * @param exe The program name.
+ */
+static void PrintUsage(const char *exe) {
+    printf("Usage: %s [options]\n", exe);
+    printf("  --episodes N      Episodes to run (default 10000)\n");
+    printf("  --threads N       Worker threads (default: all cores)\n");
+    printf("  --seed N          Base RNG seed (default 1)\n");
+    printf("  --max-ticks N     Tick limit per episode (default 60 s of play)\n");
+    printf("  --policy P        random | autopilot (default autopilot)\n");
+    printf("  --flap-chance F   Per-tick flap chance for random (default 0.05)\n");
+    printf("  --record FILE     Record one session of --episodes rounds to FILE\n");
+    printf("  --replay FILE...  Replay recordings and report per-tick timings\n");
+    printf("  --json FILE       Write the replay tick timings to FILE as benchmark JSON\n");
+    printf("  --train N         Evolve flapping policies for N generations\n");
+    printf("  --population N    Agents per training generation (default 1024)\n");
+}
+
+/**
+ * @brief The headless entry point: runs batches of episodes with no window.
+ * 
+ * @param argc The argument count.
+ * @param argv The arguments.
+ * @return int The exit code.
+ */
+int main(int argc, char **argv) {
+    SimConfig config = {
+        .episodes = 10000,
+        .threads = (int)sysconf(_SC_NPROCESSORS_ONLN),
+        .seed = 1,
+        .maxTicks = (long)(TICK_RATE * 60.0f),
+        .policy = POLICY_AUTOPILOT,
+        .flapChance = 0.05f,
+        .population = 1024,
+    };
+    
+    // Parse the command line.
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+        if (strcmp(arg, "--replay") == 0) {
+            // Every remaining argument up to the next option is a recording.
+            config.replayFiles = &argv[i + 1];
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                config.replayCount++;
+                i++;
+            }
+            continue;
+        }
+        if (value == NULL) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return 1;
+        }
+        if (strcmp(arg, "--episodes") == 0) config.episodes = strtol(value, NULL, 10);
+        else if (strcmp(arg, "--threads") == 0) config.threads = (int)strtol(value, NULL, 10);
+        else if (strcmp(arg, "--seed") == 0) config.seed = strtoull(value, NULL, 10);
+        else if (strcmp(arg, "--max-ticks") == 0) config.maxTicks = strtol(value, NULL, 10);
+        else if (strcmp(arg, "--flap-chance") == 0) config.flapChance = strtof(value, NULL);
+        else if (strcmp(arg, "--record") == 0) config.recordFile = value;
+        else if (strcmp(arg, "--json") == 0) config.jsonFile = value;
+        else if (strcmp(arg, "--train") == 0) config.trainGenerations = (int)strtol(value, NULL, 10);
+        else if (strcmp(arg, "--population") == 0) config.population = (int)strtol(value, NULL, 10);
+        else if (strcmp(arg, "--policy") == 0) {
+            if (strcmp(value, "random") == 0) config.policy = POLICY_RANDOM;
+            else if (strcmp(value, "autopilot") == 0) config.policy = POLICY_AUTOPILOT;
+            else {
+                fprintf(stderr, "Unknown policy: %s\n", value);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            PrintUsage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (config.threads < 1) config.threads = 1;
+    if (config.episodes < 0) config.episodes = 0;
+    if (config.recordFile != NULL) return RecordSession(&config);
+    if (config.trainGenerations > 0) {
+        return TrainPopulation(config.trainGenerations, config.population, config.threads, config.seed, config.maxTicks);
+    }
+    
+    SimWorker *workers = calloc((size_t)config.threads, sizeof(SimWorker));
+    pthread_t *handles = calloc((size_t)config.threads, sizeof(pthread_t));
+    if (workers == NULL || handles == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    
+    // Run the batch across the worker pool.
+    atomic_long nextEpisode = 0;
+    double start = GetClockSeconds();
+    for (int i = 0; i < config.threads; i++) {
+        workers[i].config = &config;
+        workers[i].nextEpisode = &nextEpisode;
+        pthread_create(&handles[i], NULL, SimWorkerMain, &workers[i]);
+    }
+    
+    SimWorker total = {0};
+    for (int i = 0; i < config.threads; i++) {
+        pthread_join(handles[i], NULL);
+        total.episodes += workers[i].episodes;
+        total.ticks += workers[i].ticks;
+        total.scoreSum += workers[i].scoreSum;
+        total.timeouts += workers[i].timeouts;
+        total.failures += workers[i].failures;
+        if (workers[i].bestScore > total.bestScore) total.bestScore = workers[i].bestScore;
+        for (int j = 0; j < workers[i].tickNanos.count; j++) AddSample(&total.tickNanos, workers[i].tickNanos.values[j]);
+        DestroySampleSet(&workers[i].tickNanos);
+    }
+    double elapsed = GetClockSeconds() - start;
+    if (elapsed <= 0.0) elapsed = 1e-9;
+    
+    // Report the batch results.
+    double simSeconds = (double)total.ticks / TICK_RATE;
+    printf("config:    GRAVITY=%.1f JUMP_FORCE=%.1f PIPE_GAP=%d PIPE_SPEED=%.1f TICK_RATE=%.0f\n",
+           (double)GRAVITY, (double)JUMP_FORCE, PIPE_GAP, (double)PIPE_SPEED, (double)TICK_RATE);
+    if (config.replayCount > 0) {
+        printf("replays:   %d on %d threads (%d failed)\n", config.replayCount - total.failures, config.threads, total.failures);
+    }
+    printf("episodes:  %ld on %d threads (%ld timed out)\n", total.episodes, config.threads, total.timeouts);
+    printf("score:     mean %.2f, best %d\n",
+           total.episodes ? (double)total.scoreSum / (double)total.episodes : 0.0, total.bestScore);
+    printf("ticks:     %lld (%.1f s simulated)\n", total.ticks, simSeconds);
+    printf("wall:      %.3f s, %.0f episodes/s, %.0f ticks/s, %.0fx real time\n",
+           elapsed, (double)total.episodes / elapsed, (double)total.ticks / elapsed, simSeconds / elapsed);
+    if (total.tickNanos.count > 0) {
+        BenchmarkResult result = CreateBenchmarkResult("foss_flapper/headless/tick", "ns", &total.tickNanos);
+        SampleSummary ns = result.summary;
+        printf("tick ns:   mean %.0f, p50 %.0f, p90 %.0f, p99 %.0f, max %.0f\n",
+               ns.mean, ns.p50, ns.p90, ns.p99, ns.max);
+        if (config.jsonFile != NULL && !SaveBenchmarkResults(config.jsonFile, &result, 1)) {
+            fprintf(stderr, "Cannot write benchmark results: %s\n", config.jsonFile);
+            total.failures++;
+        }
+    }
+    DestroySampleSet(&total.tickNanos);
+    
+    free(handles);
+    free(workers);
+    return total.failures ? 1 : 0;
+}
+#endif // HEADLESS
@@ -6,299 +6,458 @@
  * The player controls a bird and must navigate it through a series of pipes.
  * The game is over if the bird hits a pipe or the ground.
  * 
+ * This file holds the windowed entry point; headless.c holds the headless one.
+ * Built with -DGAME_PLUGIN it is a loadable module for a host process
+ * instead, which exports the game's GamePlugin rather than main.
+ * 
  */
 
-#include "raylib.h"
-#include "corelib.h"
-#include "config.h"
-#include <stdlib.h>
+#ifndef HEADLESS
+
+#include "game.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 /**
- * @brief The current state of the game.
+ * @brief Picks up the loader's current assets, real or placeholder.
  * 
- */
-typedef enum {
-    READY,      /**< The game is ready to be played. */
-    PLAYING,    /**< The game is currently being played. */
-    GAME_OVER   /**< The game is over. */
-} GameState;
-
-/**
- * @brief A struct that represents the bird.
+ * Called once at startup and again whenever an upload completes, so the
+ * game draws placeholders from the first frame and swaps in each asset as
+ * it arrives, or arrives again after a hot reload.
  * 
+ * @param game A pointer to the game.
  */
-typedef struct {
-    Vector2 position;       /**< The bird's position. */
-    Vector2 velocity;       /**< The bird's velocity. */
-    float radius;           /**< The bird's radius. */
-    Animation animation;    /**< The bird's animation. */
-} Bird;
+static void BindGameAssets(Game *game) {
+    game->atlas = *GetAssetAtlas(game->atlasAsset);
+    game->pipeRegion = FindAtlasRegion(&game->atlas, "pipe");
+    SetParticleTexture(&game->debris, game->atlas.texture, GetAtlasRegionRec(&game->atlas, game->pipeRegion));
+    
+    // Binding the shared frame table rebinds every animation made from it.
+    // The bird's animation is empty until the table arrives, and a reloaded
+    // table moves its frames, so then the bird starts on the new ones where
+    // it left off.
+    game->animations = *GetAssetAnimations(game->animationsAsset);
+    BindAnimationTable(&game->animations, &game->atlas);
+    game->birdClip = FindAnimationClip(&game->animations, "bird_flap");
+    Animation *bird = &game->bird.animation;
+    Animation bound = CreateAnimationFromTable(&game->animations, game->birdClip, game->atlas.texture);
+    if (bird->frames != bound.frames || bird->frameCount != bound.frameCount) {
+        if (bird->currentFrame < bound.frameCount) {
+            bound.currentFrame = bird->currentFrame;
+            bound.frameTimer = bird->frameTimer;
+        }
+        *bird = bound;
+    } else {
+        bird->spritesheet = game->atlas.texture;
+    }
+    
+    game->flapClip = GetAssetClip(game->flapAsset);
+    game->hitClip = GetAssetClip(game->hitAsset);
+}
 
+#ifdef GAME_TUNABLES_LIVE
 /**
- * @brief A struct that represents a pipe.
+ * @brief Starts the live tunables at their config.h values, then applies TUNABLES_FILE.
  * 
+ * @param game A pointer to the game.
  */
-typedef struct {
-    Rectangle top;      /**< The top pipe. */
-    Rectangle bottom;   /**< The bottom pipe. */
-    bool scored;        /**< Whether the player has scored a point for this pipe. */
-} Pipe;
+static void InitGameTunables(Game *game) {
+#define TUNABLE_NAME(name) #name,
+#define TUNABLE_DEFAULT(name) (float)(name),
+    static const char *const names[TUNABLE_COUNT] = { GAME_TUNABLES(TUNABLE_NAME) };
+    const float defaults[TUNABLE_COUNT] = { GAME_TUNABLES(TUNABLE_DEFAULT) };
+    memcpy(game->tunables, defaults, sizeof(defaults));
+    game->tuning = CreateTunableSet(TUNABLES_FILE, names, game->tunables, TUNABLE_COUNT);
+}
+#endif
+
+// The leave, retry and profiler keys travel through the input queue in the
+// high bits, above the game's actions.
+#define INPUT_LEAVE (1u << 28)
+#define INPUT_RETRY (1u << 29)
+#ifdef CORELIB_PROFILE
+#define INPUT_PROFILER_TOGGLE (1u << 30)
+#define INPUT_PROFILER_TRACE (1u << 31)
+#endif
 
 /**
- * @brief A struct that manages the pipes.
+ * @brief Maps the device state after a poll to the actions pressed.
  * 
+ * The input queue calls this after every poll, including the ones the
+ * frame pacer makes between frames, so presses are never read straight
+ * from raylib anywhere else.
+ * 
+ * @return InputBits The GameAction flags pressed since the poll before.
  */
-typedef struct {
-    Pipe pipes[4];      /**< The pipes. */
-    int pipeCount;      /**< The number of pipes. */
-    float pipeTimer;    /**< A timer that is used to spawn new pipes. */
-} PipeManager;
+static InputBits SampleGameInput(void) {
+    InputBits bits = (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_SPACE)) ? ACTION_FLAP : 0;
+    if (IsKeyPressed(KEY_R)) bits |= INPUT_RETRY;
+    if (IsKeyPressed(KEY_ESCAPE)) bits |= INPUT_LEAVE;
+#ifdef CORELIB_PROFILE
+    if (IsKeyPressed(KEY_F3)) bits |= INPUT_PROFILER_TOGGLE;
+    if (IsKeyPressed(KEY_F4)) bits |= INPUT_PROFILER_TRACE;
+#endif
+    return bits;
+}
 
 /**
- * @brief A struct that represents the game's state.
+ * @brief One frame's update, handed to the job system.
  * 
  */
 typedef struct {
-    Bird bird;                  /**< The bird. */
-    PipeManager pipeManager;    /**< The pipe manager. */
-    GameState gameState;        /**< The current game state. */
-    int score;                  /**< The player's score. */
-    int highScore;              /**< The player's high score. */
-    Texture2D birdTexture;      /**< The bird's texture. */
-    Sound flapSound;            /**< The sound played when the bird flaps. */
-    Sound hitSound;             /**< The sound played when the bird hits something. */
-    Texture2D pipeTexture;      /**< The pipe's texture. */
-} Game;
-
-void InitGame(Game *game);
-void UpdateGame(Game *game);
-void DrawGame(Game *game);
-
-bool CheckCollision(Bird bird, Pipe pipe);
+    Game *game;             /**< The game. */
+    InputEvent events[INPUT_QUEUE_CAPACITY];    /**< The presses since the last update. */
+    int eventCount;         /**< Valid entries in events. */
+    double now;             /**< When frameTime was measured, in GetClockSeconds time. */
+    float frameTime;        /**< The real time to advance by, in seconds. */
+    FrameView *view;        /**< The view to publish the result to. */
+} GameUpdate;
 
 /**
- * @brief The main entry point for the game.
+ * @brief Runs one update and publishes its view; the job body.
  * 
- * @return int The exit code.
+ * @param data A pointer to the GameUpdate.
  */
-int main(void) {
-    // Initialize the window and the game.
-    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "FOSS Flapper");
-    SetTargetFPS(60);
-    
-    // Create the game.
-    Game game = {0};
-    
-    // Load the bird's texture and sounds.
-    game.birdTexture = LoadTexture("assets/foss_flapper/textures/bird.png");
-    game.pipeTexture = LoadTexture("assets/foss_flapper/textures/pipe.png");
-
-    InitAudioDevice();
-    game.flapSound = LoadSound("assets/foss_flapper/audio/flap.wav");
-    game.hitSound = LoadSound("assets/foss_flapper/audio/hit.wav");
-    
-    // Initialize the game.
-    InitGame(&game);
-    
-    // Main game loop.
-    while (!WindowShouldClose()) {
-        // Update and draw the game.
-        UpdateGame(&game);
-        DrawGame(&game);
-    }
-    
-    // Unload the bird's texture and close the window.
-    UnloadTexture(game.birdTexture);
-    UnloadTexture(game.pipeTexture);
-    UnloadSound(game.flapSound);
-    UnloadSound(game.hitSound);
-    CloseAudioDevice();
-    CloseWindow();
-    
-    return 0;
+static void RunGameUpdate(void *data) {
+    GameUpdate *update = data;
+    PROFILE_ZONE_BEGIN("UpdateGame");
+    UpdateGameTimed(update->game, update->events, update->eventCount, update->now, update->frameTime);
+    PublishFrameView(update->game, update->view);
+    PROFILE_ZONE_END();
 }
 
 /**
- * @brief Initializes the game.
+ * @brief Plays the game until the player leaves, the window closes or a replay ends.
  * 
- * @param game A pointer to the game.
- */
-void InitGame(Game *game) {
-    // Initialize the bird.
-    game->bird.position = (Vector2){ SCREEN_WIDTH / 4.0f, SCREEN_HEIGHT / 2.0f };
-    game->bird.velocity = (Vector2){ 0, 0 };
-    game->bird.radius = BIRD_RADIUS;
-    
-    // Initialize the bird's animation.
-    Rectangle birdFrame = { 0, 0, 32, 32 };
-    game->bird.animation = CreateAnimation(game->birdTexture, &birdFrame, 1, 0.1f, true);
-    
-    // Initialize the pipe manager.
-    game->pipeManager.pipeCount = 4;
-    game->pipeManager.pipeTimer = 0.0f;
-    
-    // Initialize the pipes.
-    for (int i = 0; i < game->pipeManager.pipeCount; i++) {
-        float gapY = GetRandomValue(100, SCREEN_HEIGHT - PIPE_GAP - 100);
-        game->pipeManager.pipes[i].top = (Rectangle){ 
-            SCREEN_WIDTH + i * 200, 
-            0, 
-            PIPE_WIDTH, 
-            gapY 
-        };
-        game->pipeManager.pipes[i].bottom = (Rectangle){ 
-            SCREEN_WIDTH + i * 200, 
-            gapY + PIPE_GAP, 
-            PIPE_WIDTH, 
-            SCREEN_HEIGHT - (gapY + PIPE_GAP) 
-        };
-        game->pipeManager.pipes[i].scored = false;
-    }
-    
-    // Initialize the score and game state.
-    game->score = 0;
-    game->gameState = READY;
-}
-
-/**
- * @brief Updates the game.
+ * A host may have opened the window and the audio device already; the
+ * game then resizes and retitles the window and leaves both open on
+ * return, and Escape leaves the game instead of closing the window.
  * 
- * @param game A pointer to the game.
+ * With --record FILE the session's input and seed are saved on exit, with
+ * its final score and state checksum. With --replay FILE a saved session
+ * plays back and the game exits when it ends, with status 1 if it did not
+ * end as it was recorded.
+ * --bench uncaps the frame rate, runs one tick per frame and prints frame
+ * time statistics on exit, which makes replays comparable across builds;
+ * --json FILE also writes them to FILE as benchmark JSON.
+ * --vrr paces for a variable refresh display instead of vsync, and --stats
+ * prints the pacing and input latency on exit. --latency-test flashes a
+ * corner patch on every frame that responds to a press, for a photodiode,
+ * and logs each press's input-to-present time. --particles N keeps N debris
+ * particles in flight, to load the particle path in benchmarks.
+ * 
+ * Each round's start is kept as a checkpoint, and R on the game over
+ * screen retries the round from it: the same pipes, restored in place
+ * instead of rebuilt. A retry while recording rewinds the recording too.
+ * 
+ * Each update runs as a job while the main thread draws the view the last
+ * update published, so the simulation and the render overlap. The screen
+ * therefore shows the state one update behind the simulation.
+ * 
+ * Debug builds reload TUNABLES_FILE and every asset file when they change
+ * on disk. Gravity, the jump and the pipe speed apply at once; the pipe gap
+ * and spacing from the next round.
+ * 
+ * --metrics exports corelib's telemetry to a file or "udp:host:port" every
+ * METRICS_INTERVAL seconds, as StatsD or, with --metrics-format binary, as
+ * binary records. It starts first and stops last, so its gauges see every
+ * container and arena the game creates.
+ * 
+ * @param argc The argument count.
+ * @param argv The arguments.
+ * @return int The exit code.
  */
-void UpdateGame(Game *game) {
-    // Get the time since the last frame.
-    float deltaTime = GetFrameTime();
+static int RunGame(int argc, char **argv) {
+    const char *recordFile = NULL;
+    const char *replayFile = NULL;
+    const char *jsonFile = NULL;
+    const char *metricsTarget = NULL;
+    MetricsFormat metricsFormat = METRICS_FORMAT_STATSD;
+    bool bench = false;
+    bool stats = false;
+    bool latencyTest = false;
+    int particleLoad = 0;
+    PacingMode pacing = PACING_VSYNC;
     
-    // If the game is ready, wait for the player to start the game.
-    if (game->gameState == READY) {
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_SPACE)) {
-            game->gameState = PLAYING;
-            game->bird.velocity.y = JUMP_FORCE;
+    // Parse the command line.
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench") == 0) bench = true;
+        else if (strcmp(argv[i], "--stats") == 0) stats = true;
+        else if (strcmp(argv[i], "--vrr") == 0) pacing = PACING_VRR;
+        else if (strcmp(argv[i], "--latency-test") == 0) latencyTest = true;
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) recordFile = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replayFile = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonFile = argv[++i];
+        else if (strcmp(argv[i], "--particles") == 0 && i + 1 < argc) particleLoad = (int)strtol(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) metricsTarget = argv[++i];
+        else if (strcmp(argv[i], "--metrics-format") == 0 && i + 1 < argc) {
+            metricsFormat = strcmp(argv[++i], "binary") == 0 ? METRICS_FORMAT_BINARY : METRICS_FORMAT_STATSD;
+        } else {
+            fprintf(stderr, "Usage: %s [--record FILE | --replay FILE] [--bench [--json FILE]] [--vrr] [--stats] [--latency-test]"
+                    " [--particles N] [--metrics FILE|udp:HOST:PORT [--metrics-format statsd|binary]]\n", argv[0]);
+            return 1;
         }
-        return;
     }
     
-    // If the game is over, wait for the player to restart the game.
-    if (game->gameState == GAME_OVER) {
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_SPACE)) {
-            InitGame(game);
+    // Start the telemetry before anything it counts is created.
+    if (metricsTarget != NULL && !InitMetrics(metricsTarget, metricsFormat, METRICS_PREFIX, METRICS_INTERVAL)) {
+        fprintf(stderr, "Cannot export metrics to %s\n", metricsTarget);
+        return 1;
+    }
+    
+    // Set up the input stream first, since a replay supplies the seed.
+    Game game = {0};
+    uint64_t seed = (uint64_t)time(NULL);
+    if (replayFile != NULL) {
+        if (!StartInputReplay(&game.input, replayFile)) {
+            fprintf(stderr, "Cannot read input recording: %s\n", replayFile);
+            CloseMetrics();
+            return 1;
+        }
+        if (game.input.recording.tickRate != TICK_RATE) {
+            fprintf(stderr, "%s was recorded at %.0f Hz, this build ticks at %.0f Hz\n",
+                    replayFile, (double)game.input.recording.tickRate, (double)TICK_RATE);
+            CloseInputStream(&game.input);
+            CloseMetrics();
+            return 1;
         }
-        return;
+        seed = game.input.recording.seed;
+    } else if (recordFile != NULL) {
+        StartInputRecording(&game.input, seed, TICK_RATE);
     }
     
-    // If the player jumps, apply an upward force to the bird.
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) || IsKeyPressed(KEY_SPACE)) {
-        game->bird.velocity.y = JUMP_FORCE;
-        PlaySound(game->flapSound);
+    // Initialize the window, or take over the host's, and pace to its
+    // display. Benchmarks run uncapped, unless a host's window is vsynced.
+    bool ownsWindow = !IsWindowReady();
+    if (ownsWindow) {
+        if (!bench) SetFramePacerHints(pacing);
+        InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "FOSS Flapper");
+    } else {
+        SetWindowSize(SCREEN_WIDTH, SCREEN_HEIGHT);
+        SetWindowTitle("FOSS Flapper");
     }
+    SetTargetFPS(0);
+    FramePacer pacer = CreateFramePacer(pacing, bench ? 0.0 : TARGET_FPS);
+    InputQueue inputQueue = CreateInputQueue(SampleGameInput);
+    pacer.input = &inputQueue;
     
-    // Apply gravity to the bird.
-    game->bird.velocity.y += GRAVITY * deltaTime;
-    game->bird.position.y += game->bird.velocity.y * deltaTime;
+    // Create the game's memory arenas.
+    game.levelArena = CreateArena(LEVEL_ARENA_SIZE);
+    game.frameArena = CreateArena(FRAME_ARENA_SIZE);
+    game.checkpoint = CreateSnapshot(NULL, GAME_SNAPSHOT_SIZE);
+#ifdef GAME_TUNABLES_LIVE
+    InitGameTunables(&game);
+#endif
     
-    // Update the bird's animation.
-    UpdateAnimation(&game->bird.animation, deltaTime);
+    // Create the sprite batch, the frame views, the HUD text and the particles.
+    game.spriteBatch = CreateSpriteBatch(SPRITE_BATCH_CAPACITY);
+    game.views[0] = CreateFrameView();
+    game.views[1] = CreateFrameView();
+    InitHud(&game);
+    InitEffects(&game, particleLoad);
+    if (!InitJobSystem(JOB_WORKERS)) fprintf(stderr, "Cannot start the job system, updating on the main thread\n");
     
-    // If the bird hits the top or bottom of the screen, the game is over.
-    if (game->bird.position.y <= game->bird.radius || game->bird.position.y >= SCREEN_HEIGHT - game->bird.radius) {
-        game->gameState = GAME_OVER;
-        PlaySound(game->hitSound);
-        if (game->score > game->highScore) game->highScore = game->score;
-        return;
-    }
+    // Start the mixer, then queue the texture atlas and sounds; they load
+    // in the background.
+    bool ownsAudio = !IsAudioDeviceReady();
+    if (ownsAudio) InitAudioDevice();
+    InitAudioMixer(MIXER_VOICES);
+    InitAssetLoader(ASSET_CAPACITY);
+    MountAssetArchive("assets/foss_flapper.pak", "assets/foss_flapper");
+    game.atlasAsset = RequestTextureAtlas("assets/foss_flapper/textures.atlas");
+    game.animationsAsset = RequestAnimationTable("assets/foss_flapper/animations.anim");
+    game.flapAsset = RequestAudioClip("assets/foss_flapper/audio/flap.wav");
+    game.hitAsset = RequestAudioClip("assets/foss_flapper/audio/hit.wav");
+#ifdef GAME_TUNABLES_LIVE
+    EnableAssetHotReload();
+#endif
+    BindGameAssets(&game);
     
-    // Update the pipes.
-    for (int i = 0; i < game->pipeManager.pipeCount; i++) {
-        // Move the pipes to the left.
-        game->pipeManager.pipes[i].top.x -= PIPE_SPEED * deltaTime;
-        game->pipeManager.pipes[i].bottom.x -= PIPE_SPEED * deltaTime;
+    // Initialize the game. Benchmarks draw every frame so they stay comparable.
+    StartSession(&game, seed);
+    game.allowIdleFrames = !bench;
+    game.latencyFlash = latencyTest;
+    int front = 0;
+    PublishFrameView(&game, &game.views[front]);
+    
+    // Main game loop.
+    SampleSet frameTimes = {0};
+    double lastFrame = GetClockSeconds();
+    double lastUpdate = lastFrame;
+    bool leaving = false;
+    while (!leaving && !WindowShouldClose() && !IsInputReplayFinished(&game.input)) {
+        PROFILE_FRAME();
+        
+        // Time the frame with the clock: GetFrameTime only advances on frames
+        // that are drawn, and idle frames are not.
+        double updateTime = GetClockSeconds();
+        float frameTime = (float)(updateTime - lastUpdate);
+        lastUpdate = updateTime;
         
-        // If a pipe is off the screen, reset it.
-        if (game->pipeManager.pipes[i].top.x + PIPE_WIDTH < 0) {
-            float gapY = GetRandomValue(100, SCREEN_HEIGHT - PIPE_GAP - 100);
-            game->pipeManager.pipes[i].top.x = SCREEN_WIDTH;
-            game->pipeManager.pipes[i].bottom.x = SCREEN_WIDTH;
-            game->pipeManager.pipes[i].top.y = 0;
-            game->pipeManager.pipes[i].top.height = gapY;
-            game->pipeManager.pipes[i].bottom.y = gapY + PIPE_GAP;
-            game->pipeManager.pipes[i].bottom.height = SCREEN_HEIGHT - (gapY + PIPE_GAP);
-            game->pipeManager.pipes[i].scored = false;
+        // Pick up edited files, then upload what the loader has decoded, within
+        // the frame's budget. No update is in flight here, so changing the
+        // tunables and rebinding the assets is safe.
+#ifdef GAME_TUNABLES_LIVE
+        if (UpdateTunables(&game.tuning) > 0) game.debris.gravity = TUNED(&game, GRAVITY);
+        ReloadChangedAssets();
+#endif
+        if (ProcessAssetUploads(ASSET_UPLOAD_BUDGET) > 0) BindGameAssets(&game);
+        
+        // Take the presses stamped since the last update. The profiler keys
+        // are handled here and the actions go to the update.
+        GameUpdate update = { .game = &game, .now = updateTime, .frameTime = bench ? game.step.dt : frameTime,
+                              .view = &game.views[front ^ 1] };
+        update.eventCount = DrainInputQueue(&inputQueue, update.events, INPUT_QUEUE_CAPACITY);
+        for (int i = 0; i < update.eventCount; i++) {
+            InputEvent *event = &update.events[i];
+#ifdef CORELIB_PROFILE
+            // F3 toggles the profiler overlay, F4 dumps a Chrome trace.
+            if (event->bits & INPUT_PROFILER_TOGGLE) game.showProfiler = !game.showProfiler;
+            if (event->bits & INPUT_PROFILER_TRACE) WriteProfilerChromeTrace("foss_flapper_trace.json");
+            event->bits &= ~(InputBits)(INPUT_PROFILER_TOGGLE | INPUT_PROFILER_TRACE);
+#endif
+            // R retries from the round's checkpoint once the round is over.
+            // A replay plays the retries that were recorded, not live ones.
+            if ((event->bits & INPUT_RETRY) && game.gameState == GAME_OVER && game.input.mode != INPUT_MODE_REPLAY) {
+                LoadGameState(&game, &game.checkpoint);
+            }
+            if (event->bits & INPUT_LEAVE) leaving = true;
+            event->bits &= ~(InputBits)(INPUT_RETRY | INPUT_LEAVE);
+            if (event->bits != 0 && game.input.mode != INPUT_MODE_REPLAY) MarkFrameInput(&pacer, event->time);
         }
         
-        // If the bird collides with a pipe, the game is over.
-        if (CheckCollision(game->bird, game->pipeManager.pipes[i])) {
-            game->gameState = GAME_OVER;
-            PlaySound(game->hitSound);
-            if (game->score > game->highScore) game->highScore = game->score;
-            return;
+        // Start the update into the back view, then draw the front view while
+        // it runs. Without the job system it runs here first.
+        Job *updateJob = CreateJob(RunGameUpdate, &update);
+        if (updateJob != NULL) SubmitJob(updateJob);
+        else RunGameUpdate(&update);
+        
+        // The particles are not part of the simulation, so they move on here
+        // alongside the update.
+        UpdateEffects(&game, update.frameTime);
+        
+        // Present, then sleep until the next frame is due while the update runs.
+        bool drawn = DrawGame(&game, &game.views[front]);
+        if (drawn && EndFramePacing(&pacer, game.views[front].respondsToInput) && latencyTest) {
+            printf("latency:   %.2f ms input to present\n", pacer.lastLatencyMs);
         }
         
-        // If the bird passes a pipe, increment the score.
-        if (!game->pipeManager.pipes[i].scored && 
-            game->bird.position.x > game->pipeManager.pipes[i].top.x + PIPE_WIDTH) {
-            game->score++;
-            game->pipeManager.pipes[i].scored = true;
+        // Finish the update, if this thread did not already run it, and
+        // show its view next frame.
+        PROFILE_ZONE_BEGIN("WaitForUpdate");
+        WaitForJob(updateJob);
+        PROFILE_ZONE_END();
+        front ^= 1;
+        if (game.events & GAME_EVENT_START) SaveGameState(&game, &game.checkpoint);
+        
+        // An unchanged screen is not drawn again, so EndDrawing's input
+        // polling has to happen here instead. If the next frame would be
+        // skipped too and nothing is loading or replaying, sleep until input.
+        if (!drawn) {
+            bool idle = IsFrameViewShown(&game, &game.views[front]) && GetPendingAssetCount() == 0
+                     && game.input.mode != INPUT_MODE_REPLAY;
+#ifdef GAME_TUNABLES_LIVE
+            // Keep polling, so edits to watched files show without a press.
+            idle = false;
+#endif
+            WaitForFrameEvents(&pacer, idle, IDLE_POLL_RATE);
+        }
+        
+        PROFILE_ZONE_BEGIN("Audio");
+        PlayGameSounds(&game);
+        PROFILE_ZONE_END();
+        EmitGameEffects(&game);
+        
+        if (bench) {
+            double now = GetClockSeconds();
+            AddSample(&frameTimes, (now - lastFrame) * 1000.0);
+            lastFrame = now;
         }
     }
-}
-
-/**
- * @brief Draws the game.
- * 
- * @param game A pointer to the game.
- */
-void DrawGame(Game *game) {
-    // Begin drawing.
-    BeginDrawing();
-    
-    // Clear the background.
-    ClearBackground(SKYBLUE);
     
-    // Draw the pipes.
-    for (int i = 0; i < game->pipeManager.pipeCount; i++) {
-        DrawTextureRec(game->pipeTexture, game->pipeManager.pipes[i].top, (Vector2){game->pipeManager.pipes[i].top.x, game->pipeManager.pipes[i].top.y}, WHITE);
-        DrawTextureRec(game->pipeTexture, game->pipeManager.pipes[i].bottom, (Vector2){game->pipeManager.pipes[i].bottom.x, game->pipeManager.pipes[i].bottom.y}, WHITE);
+    // Save the recording with how the session ended, or check that a replay
+    // played to the end ended the same way. Then report the frame times.
+    int exitCode = 0;
+    if (recordFile != NULL && replayFile == NULL) {
+        SetInputRecordingOutcome(&game.input.recording, game.score, GetGameStateChecksum(&game));
+        if (!SaveInputRecording(&game.input.recording, recordFile)) {
+            fprintf(stderr, "Cannot write input recording: %s\n", recordFile);
+        }
     }
-    
-    // Draw the bird.
-    DrawTextureRec(game->birdTexture, (Rectangle){0, 0, game->birdTexture.width, game->birdTexture.height}, game->bird.position, WHITE);
-    
-    // Draw the score.
-    DrawText(TextFormat("Score: %d", game->score), 10, 10, 30, BLACK);
-    DrawText(TextFormat("High: %d", game->highScore), 10, 50, 20, DARKGRAY);
-    
-    // If the game is ready, draw the title screen.
-    if (game->gameState == READY) {
-        DrawText("FOSS FLAPPER", SCREEN_WIDTH/2 - 120, SCREEN_HEIGHT/2 - 100, 30, BLACK);
-        DrawText("Click or Press SPACE to start", SCREEN_WIDTH/2 - 140, SCREEN_HEIGHT/2 - 50, 20, DARKGRAY);
-    } else if (game->gameState == GAME_OVER) {
-        // If the game is over, draw the game over screen.
-        DrawText("GAME OVER", SCREEN_WIDTH/2 - 80, SCREEN_HEIGHT/2 - 50, 30, RED);
-        DrawText(TextFormat("Final Score: %d", game->score), SCREEN_WIDTH/2 - 70, SCREEN_HEIGHT/2, 20, BLACK);
-        DrawText("Click or Press SPACE to restart", SCREEN_WIDTH/2 - 130, SCREEN_HEIGHT/2 + 30, 20, DARKGRAY);
+    if (IsInputReplayFinished(&game.input) &&
+        !CheckInputReplayOutcome(&game.input, game.score, GetGameStateChecksum(&game))) {
+        fprintf(stderr, "%s did not replay to its recorded end\n", replayFile);
+        exitCode = 1;
+    }
+    if (bench) {
+        BenchmarkResult result = CreateBenchmarkResult("foss_flapper/render/frame", "ms", &frameTimes);
+        SampleSummary ms = result.summary;
+        printf("frames:    %d (%u ticks)\n", ms.count, game.input.tick);
+        printf("frame ms:  mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+               ms.mean, ms.p50, ms.p90, ms.p99, ms.max);
+        if (jsonFile != NULL && !SaveBenchmarkResults(jsonFile, &result, 1)) {
+            fprintf(stderr, "Cannot write benchmark results: %s\n", jsonFile);
+        }
+    }
+    if (stats) {
+        SampleSummary ms = SummarizeSamples(&pacer.latencyMs);
+        printf("pacing:    %s, %.0f of %.0f Hz, %d presents, %d missed, %d idle waits\n",
+               pacing == PACING_VRR ? "vrr" : "vsync", pacer.period > 0.0 ? 1.0 / pacer.period : 0.0,
+               pacer.refreshRate, pacer.presents, pacer.missed, pacer.idleWaits);
+        printf("latency:   %d inputs, mean %.2f, p50 %.2f, p99 %.2f, max %.2f ms\n",
+               ms.count, ms.mean, ms.p50, ms.p99, ms.max);
     }
+    DestroySampleSet(&frameTimes);
+    DestroyFramePacer(&pacer);
+    CloseInputStream(&game.input);
+    
+    // Stop the workers and the mixer before the loader frees its clips,
+    // then unload the assets and close what this game opened.
+    CloseJobSystem();
+    CloseAudioMixer();
+    CloseAssetLoader();
+#ifdef GAME_TUNABLES_LIVE
+    DestroyTunableSet(&game.tuning);
+#endif
+    UnloadHud(&game);
+    UnloadEffects(&game);
+    DestroyFrameView(&game.views[0]);
+    DestroyFrameView(&game.views[1]);
+    DestroySpriteBatch(&game.spriteBatch);
+    DestroySnapshot(&game.checkpoint);
+    DestroyObjectPool(&game.pipeManager.pool);
+    DestroyArena(&game.levelArena);
+    DestroyArena(&game.frameArena);
+    if (ownsAudio) CloseAudioDevice();
+    if (ownsWindow) CloseWindow();
+    CloseMetrics();
     
-    // End drawing.
-    EndDrawing();
+    return exitCode;
 }
 
+#ifdef GAME_PLUGIN
 /**
- * @brief Checks for a collision between the bird and a pipe.
+ * @brief The entry point a host looks up after loading the game's module.
  * 
- * @param bird The bird.
- * @param pipe The pipe.
- * @return true if there is a collision, false otherwise.
+ * @return const GamePlugin* The game's plugin.
  */
-bool CheckCollision(Bird bird, Pipe pipe) {
-    // Create a rectangle for the bird.
-    Rectangle birdRect = {
-        bird.position.x - bird.radius,
-        bird.position.y - bird.radius,
-        bird.radius * 2,
-        bird.radius * 2
-    };
-
-    // Check for a collision between the bird and the top and bottom pipes.
-    return CheckCollisionRecs(birdRect, pipe.top) || CheckCollisionRecs(birdRect, pipe.bottom);
+GAME_PLUGIN_EXPORT const GamePlugin *GetGamePlugin(void) {
+    static const GamePlugin plugin = { GAME_PLUGIN_ABI_VERSION, "FOSS Flapper", RunGame };
+    return &plugin;
 }
+#else
+/**
+ * @brief The main entry point for the game.
+ * 
+ * @param argc The argument count.
+ * @param argv The arguments.
+ * @return int The exit code.
+ */
+int main(int argc, char **argv) {
+    return RunGame(argc, argv);
+}
+#endif
+
+#endif // HEADLESS
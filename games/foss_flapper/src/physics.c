@@ -0,0 +1,385 @@
+/**
+ * @file physics.c
+ * @brief The fixed-tick simulation: rounds, input, movement and collisions.
+ * 
+ * Nothing here touches the window, audio device or live input, so the same
+ * code runs windowed, headless and under replay.
+ * 
+ */
+
+#include "game.h"
+
+/**
+ * @brief Starts a session: seeds the game and resets the clock and high score.
+ * 
+ * A session is a run of rounds driven by one input stream. Starting from the
+ * same seed with the same per-tick input always plays out the same way.
+ * 
+ * @param game A pointer to the game.
+ * @param seed The RNG seed for the session.
+ */
+void StartSession(Game *game, uint64_t seed) {
+    game->rng = CreateRng(seed);
+    game->step = CreateFixedStep(TICK_RATE, MAX_CATCHUP_STEPS);
+    game->highScore = 0;
+    InitGame(game);
+}
+
+/**
+ * @brief Initializes the game.
+ * 
+ * @param game A pointer to the game.
+ */
+void InitGame(Game *game) {
+    // Take the previous round's pipes off the pool gauge, then release its
+    // state in one step.
+    if (game->pipeManager.pool.capacity > 0) ClearObjectPool(&game->pipeManager.pool);
+    ResetArena(&game->levelArena);
+    
+    // Initialize the bird.
+    game->bird.position = (Vector2){ SCREEN_WIDTH / 4.0f, SCREEN_HEIGHT / 2.0f };
+    game->bird.prevPosition = game->bird.position;
+    game->bird.velocity = (Vector2){ 0, 0 };
+    game->bird.radius = BIRD_RADIUS;
+    
+    // Initialize the bird's animation. Its frames are the frame table's, so
+    // nothing is allocated; without a table it is empty.
+    game->bird.animation = CreateAnimationFromTable(&game->animations, game->birdClip, game->atlas.texture);
+    
+    // Initialize the pipe manager. The first pipe spawns at the right edge
+    // of the screen, and the rest follow as the pipes scroll in.
+    PipeManager *manager = &game->pipeManager;
+    manager->pipes = CreateObstacleField(&game->levelArena, PIPE_CAPACITY, TUNED(game, PIPE_GAP), SCREEN_HEIGHT);
+    manager->pool = CreateObjectPool(&game->levelArena, PIPE_CAPACITY, 0);
+    manager->spacing = TUNED(game, PIPE_SPACING);
+    manager->nextSpawnX = SCREEN_WIDTH;
+    
+    // Initialize the score and game state.
+    game->score = 0;
+    game->gameState = READY;
+}
+
+/**
+ * @brief Runs an update's fixed ticks, each with its input from the stream.
+ * 
+ * A replay stops on its last recorded tick, so the game ends in the state
+ * the recording was saved in, however many ticks the final update covers.
+ * 
+ * @param game A pointer to the game.
+ * @param steps The number of ticks.
+ */
+static void RunGameTicks(Game *game, int steps) {
+    for (int i = 0; i < steps && !IsInputReplayFinished(&game->input); i++) {
+        InputBits input = NextTickInput(&game->input);
+        if (input != 0) game->events |= GAME_EVENT_INPUT;
+        StepGame(game, input, game->step.dt);
+    }
+}
+
+/**
+ * @brief Updates the game.
+ * 
+ * Latches the frame's input and then advances the simulation in fixed ticks,
+ * so physics results do not depend on the frame rate. Each tick takes its
+ * input from the game's input stream, which records or replays it. The
+ * update touches no window, audio or input state, so it also runs headless.
+ * 
+ * @param game A pointer to the game.
+ * @param pressed The GameAction flags pressed this frame.
+ * @param frameTime The real time elapsed since the last update, in seconds.
+ */
+void UpdateGame(Game *game, InputBits pressed, float frameTime) {
+    game->events = 0;
+    ResetArena(&game->frameArena);
+    PushInput(&game->input, pressed);
+    
+    // Run as many fixed ticks as the elapsed frame time covers.
+    int steps = AdvanceFixedStep(&game->step, frameTime);
+    RunGameTicks(game, steps);
+}
+
+/**
+ * @brief Updates the game from timestamped presses.
+ * 
+ * Like UpdateGame, but each press goes to the tick that covers the moment
+ * it was polled instead of the first tick of the update. A press polled
+ * after the last tick's end waits for the next update's first tick.
+ * 
+ * @param game A pointer to the game.
+ * @param events The presses since the last update, oldest first.
+ * @param eventCount The number of presses.
+ * @param now The clock time frameTime was measured at, in GetClockSeconds time.
+ * @param frameTime The real time elapsed since the last update, in seconds.
+ */
+void UpdateGameTimed(Game *game, const InputEvent *events, int eventCount, double now, float frameTime) {
+    game->events = 0;
+    ResetArena(&game->frameArena);
+    
+    int steps = AdvanceFixedStep(&game->step, frameTime);
+    for (int i = 0; i < eventCount; i++) {
+        PushTimedInput(&game->input, events[i].bits, GetFixedStepTickOffset(&game->step, events[i].time, now));
+    }
+    RunGameTicks(game, steps);
+}
+
+/**
+ * @brief Advances the simulation by one fixed tick.
+ * 
+ * @param game A pointer to the game.
+ * @param input The GameAction flags for this tick.
+ * @param dt The tick length in seconds.
+ */
+void StepGame(Game *game, InputBits input, float dt) {
+    PROFILE_SCOPE("StepGame");
+    bool flap = (input & ACTION_FLAP) != 0;
+    
+    // If the game is ready, wait for the player to start the game.
+    if (game->gameState == READY) {
+        if (flap) {
+            game->gameState = PLAYING;
+            game->bird.velocity.y = TUNED(game, JUMP_FORCE);
+            game->events |= GAME_EVENT_START;
+        }
+        return;
+    }
+    
+    // If the game is over, wait for the player to restart the game.
+    if (game->gameState == GAME_OVER) {
+        if (flap) {
+            InitGame(game);
+        }
+        return;
+    }
+    
+    ObstacleField *pipes = &game->pipeManager.pipes;
+    
+    // Remember the previous state for render interpolation.
+    game->bird.prevPosition = game->bird.position;
+    
+    // If the player jumps, apply an upward force to the bird.
+    if (flap) {
+        game->bird.velocity.y = TUNED(game, JUMP_FORCE);
+        game->events |= GAME_EVENT_FLAP;
+    }
+    
+    // Apply gravity to the bird.
+    game->bird.velocity.y += TUNED(game, GRAVITY) * dt;
+    game->bird.position.y += game->bird.velocity.y * dt;
+    
+    // Update the bird's animation.
+    UpdateAnimation(&game->bird.animation, dt);
+    
+    // If the bird hits the top or bottom of the screen, the game is over.
+    if (game->bird.position.y <= game->bird.radius || game->bird.position.y >= SCREEN_HEIGHT - game->bird.radius) {
+        game->gameState = GAME_OVER;
+        game->events |= GAME_EVENT_HIT;
+        if (game->score > game->highScore) game->highScore = game->score;
+        return;
+    }
+    
+    // Move, retire and spawn the pipes.
+    StepPipes(game, dt);
+    
+    // If the bird collides with a pipe, the game is over.
+    if (CheckCollision(&game->bird, pipes)) {
+        game->gameState = GAME_OVER;
+        game->events |= GAME_EVENT_HIT;
+        if (game->score > game->highScore) game->highScore = game->score;
+        return;
+    }
+    
+    // If the bird passes a pipe, increment the score.
+    int passed = ScoreObstacles(pipes, game->bird.position.x);
+    if (passed > 0) {
+        game->score += passed;
+        game->events |= GAME_EVENT_SCORE;
+    }
+}
+
+/**
+ * @brief Advances the pipes by one tick.
+ * 
+ * Scrolls the pipes, releases the ones that left the screen and spawns new
+ * ones. The pipes never depend on the bird, so the trainer also runs this on
+ * its own to share one stream of pipes between many birds.
+ * 
+ * @param game A pointer to the game.
+ * @param dt The tick length in seconds.
+ */
+void StepPipes(Game *game, float dt) {
+    PipeManager *manager = &game->pipeManager;
+    ObstacleField *pipes = &manager->pipes;
+    
+    // Move the pipes to the left.
+    ScrollObstacles(pipes, TUNED(game, PIPE_SPEED) * dt);
+    manager->nextSpawnX -= TUNED(game, PIPE_SPEED) * dt;
+    
+    // Release the pipes that are off the screen. Going from the highest index
+    // down keeps the lower ones in place while each release swaps in the last.
+    int *offscreen = ArenaAlloc(&game->frameArena, sizeof(int) * (size_t)pipes->count);
+    int offscreenCount = offscreen ? CollectOffscreenObstacles(pipes, 0.0f, offscreen, pipes->count) : 0;
+    for (int i = offscreenCount - 1; i >= 0; i--) {
+        ReleasePipe(manager, GetPoolHandle(&manager->pool, offscreen[i]));
+    }
+    
+    // Spawn a pipe each time the spawn point reaches the right edge.
+    while (manager->nextSpawnX <= SCREEN_WIDTH) {
+        if (SpawnPipe(game, manager->nextSpawnX) == POOL_INVALID) break;
+        manager->nextSpawnX += manager->spacing;
+    }
+}
+
+/**
+ * @brief Checks for a collision between the bird and any pipe.
+ * 
+ * @param bird A pointer to the bird.
+ * @param pipes The pipes.
+ * @return true if there is a collision, false otherwise.
+ */
+bool CheckCollision(const Bird *bird, const ObstacleField *pipes) {
+    // Test the bird's circle against every top and bottom pipe, so grazing
+    // a pipe corner with the bird's bounding-box corner no longer counts.
+    return CollideObstaclesCircle(pipes, bird->position, bird->radius) >= 0;
+}
+
+/**
+ * @brief Spawns a pipe with a random gap.
+ * 
+ * @param game A pointer to the game.
+ * @param x The left edge of the new pipe.
+ * @return PoolHandle The new pipe, or POOL_INVALID if the pool is full.
+ */
+PoolHandle SpawnPipe(Game *game, float x) {
+    PipeManager *manager = &game->pipeManager;
+    PoolHandle pipe = AcquirePoolObject(&manager->pool);
+    if (pipe == POOL_INVALID) return POOL_INVALID;
+    
+    // The field's gap was fixed at round start; a live edit waits for the
+    // next round, so the drawn and the colliding gaps always agree.
+    float gapY = RandomRange(&game->rng, 100, SCREEN_HEIGHT - (int)manager->pipes.gap - 100);
+    AddObstacle(&manager->pipes, x, gapY, PIPE_WIDTH);
+    return pipe;
+}
+
+/**
+ * @brief Releases a pipe back to the pool.
+ * 
+ * The pool and the obstacle field both fill the hole with their last entry,
+ * so they stay in the same order.
+ * 
+ * @param manager A pointer to the pipe manager.
+ * @param pipe The pipe to release; stale handles are ignored.
+ */
+void ReleasePipe(PipeManager *manager, PoolHandle pipe) {
+    int index = ReleasePoolObject(&manager->pool, pipe);
+    if (index >= 0) RemoveObstacle(&manager->pipes, index);
+}
+
+/**
+ * @brief Saves or loads the simulation, whichever the snapshot is doing.
+ * 
+ * Everything a tick reads or writes is covered: the bird, the pipes and the
+ * level arena they live in, the round, the clock, the RNG and the input
+ * stream's cursor. The assets, views and effects are not. The bird's
+ * animation keeps the current frame table and only its place in it is
+ * saved, so a snapshot survives an asset reload.
+ * 
+ * @param snap The snapshot.
+ * @param game A pointer to the game.
+ */
+static void SnapshotGame(Snapshot *snap, Game *game) {
+    Bird *bird = &game->bird;
+    SNAPSHOT_VALUE(snap, bird->position);
+    SNAPSHOT_VALUE(snap, bird->prevPosition);
+    SNAPSHOT_VALUE(snap, bird->velocity);
+    SNAPSHOT_VALUE(snap, bird->radius);
+    SNAPSHOT_VALUE(snap, bird->animation.currentFrame);
+    SNAPSHOT_VALUE(snap, bird->animation.frameTimer);
+    
+    // The pipe field and pool point into the level arena, which comes back
+    // at the same address, so they are copied as they are.
+    SNAPSHOT_VALUE(snap, game->pipeManager);
+    SnapshotArena(snap, &game->levelArena);
+    
+    SNAPSHOT_VALUE(snap, game->gameState);
+    SNAPSHOT_VALUE(snap, game->step);
+    SNAPSHOT_VALUE(snap, game->rng);
+    SNAPSHOT_VALUE(snap, game->score);
+    SNAPSHOT_VALUE(snap, game->highScore);
+    SnapshotInputStream(snap, &game->input);
+}
+
+/**
+ * @brief Saves the simulation into a snapshot, replacing what it held.
+ * 
+ * @param game A pointer to the game.
+ * @param snap The snapshot, at least GAME_SNAPSHOT_SIZE bytes.
+ * @return true if the state fit, false otherwise.
+ */
+bool SaveGameState(Game *game, Snapshot *snap) {
+    BeginSnapshotSave(snap, GAME_SNAPSHOT_VERSION);
+    SnapshotGame(snap, game);
+    return EndSnapshot(snap);
+}
+
+/**
+ * @brief Checksums the simulation state a replay has to reproduce.
+ * 
+ * Covers what SnapshotGame saves except addresses and frame timing: the
+ * bird, the live pipes, the round and the RNG. Two runs of one recording
+ * therefore agree exactly when their simulations did, whatever the process
+ * or the frame rate. The scratch snapshot lives in the frame arena, so call
+ * this between updates.
+ * 
+ * @param game A pointer to the game.
+ * @return uint32_t The checksum, or 0 if the frame arena is full.
+ */
+uint32_t GetGameStateChecksum(Game *game) {
+    Snapshot snap = CreateSnapshot(&game->frameArena, GAME_CHECKSUM_SIZE);
+    if (snap.data == NULL) return 0;
+    BeginSnapshotSave(&snap, GAME_SNAPSHOT_VERSION);
+    SNAPSHOT_VALUE(&snap, game->bird.position);
+    SNAPSHOT_VALUE(&snap, game->bird.velocity);
+    
+    ObstacleField *pipes = &game->pipeManager.pipes;
+    size_t columns = sizeof(float) * (size_t)pipes->count;
+    SNAPSHOT_VALUE(&snap, pipes->count);
+    SNAPSHOT_VALUE(&snap, pipes->gap);
+    SnapshotBytes(&snap, pipes->x, columns);
+    SnapshotBytes(&snap, pipes->gapY, columns);
+    SnapshotBytes(&snap, pipes->width, columns);
+    SNAPSHOT_VALUE(&snap, game->pipeManager.nextSpawnX);
+    
+    SNAPSHOT_VALUE(&snap, game->gameState);
+    SNAPSHOT_VALUE(&snap, game->rng);
+    SNAPSHOT_VALUE(&snap, game->score);
+    SNAPSHOT_VALUE(&snap, game->highScore);
+    return EndSnapshot(&snap) ? GetSnapshotChecksum(&snap) : 0;
+}
+
+/**
+ * @brief Puts the simulation back to a snapshot SaveGameState took.
+ * 
+ * Nothing is rebuilt, so this costs a few copies the size of the round's
+ * state. Loading while recording rolls the recording back with it.
+ * 
+ * @param game A pointer to the game.
+ * @param snap The snapshot.
+ * @return true if the snapshot was loaded, false if it is empty or stale and the game is untouched.
+ */
+bool LoadGameState(Game *game, Snapshot *snap) {
+    if (!BeginSnapshotLoad(snap, GAME_SNAPSHOT_VERSION)) return false;
+    int pipeCount = game->pipeManager.pool.count;
+    SnapshotGame(snap, game);
+    
+    // The pool comes back by copy, so move the pool gauge by what it gained or lost.
+    AddMetricGauge(METRIC_POOL_OBJECTS, game->pipeManager.pool.count - pipeCount);
+    
+    // A reloaded frame table may have fewer frames than the one saved with.
+    Animation *anim = &game->bird.animation;
+    if (anim->currentFrame >= anim->frameCount) {
+        anim->currentFrame = 0;
+        anim->frameTimer = 0.0f;
+    }
+    return EndSnapshot(snap);
+}
@@ -0,0 +1,295 @@
+/**
+ * @file render.c
+ * @brief Draws the game from views interpolated between simulation ticks.
+ * 
+ */
+
+#include "game.h"
+#include "raymath.h"
+
+/**
+ * @brief Creates a HUD string in raylib's default font, sized like DrawText.
+ * 
+ * @param fontSize The font size, as DrawText takes it.
+ * @param string The fixed text, or NULL for text set later.
+ * @return CachedText The laid out text.
+ */
+static CachedText CreateHudText(int fontSize, const char *string) {
+    // DrawText spaces glyphs by a tenth of the font size, its default size.
+    CachedText text = CreateCachedText(NULL, GetFontDefault(), (float)fontSize, fontSize / 10.0f, HUD_TEXT_GLYPHS);
+    if (string != NULL) SetCachedText(&text, string);
+    return text;
+}
+
+/**
+ * @brief Lays out the HUD's fixed strings and creates its cached layers.
+ * 
+ * Call after the window is open.
+ * 
+ * @param game A pointer to the game.
+ */
+void InitHud(Game *game) {
+    Hud *hud = &game->hud;
+    hud->score = CreateHudText(30, NULL);
+    hud->highScore = CreateHudText(20, NULL);
+    hud->title = CreateHudText(30, "FOSS FLAPPER");
+    hud->startHint = CreateHudText(20, "Click or Press SPACE to start");
+    hud->gameOver = CreateHudText(30, "GAME OVER");
+    hud->finalScore = CreateHudText(20, NULL);
+    hud->restartHint = CreateHudText(20, "Click or Press SPACE to restart");
+    hud->scoreLayer = LoadCachedLayer((Rectangle){ 0, 0, SCREEN_WIDTH / 2, 80 });
+    hud->messageLayer = LoadCachedLayer((Rectangle){ 0, SCREEN_HEIGHT / 2 - 110, SCREEN_WIDTH, 170 });
+}
+
+/**
+ * @brief Frees the HUD strings and layers.
+ * 
+ * @param game A pointer to the game.
+ */
+void UnloadHud(Game *game) {
+    Hud *hud = &game->hud;
+    DestroyCachedText(&hud->score);
+    DestroyCachedText(&hud->highScore);
+    DestroyCachedText(&hud->title);
+    DestroyCachedText(&hud->startHint);
+    DestroyCachedText(&hud->gameOver);
+    DestroyCachedText(&hud->finalScore);
+    DestroyCachedText(&hud->restartHint);
+    UnloadCachedLayer(&hud->scoreLayer);
+    UnloadCachedLayer(&hud->messageLayer);
+}
+
+/**
+ * @brief Creates an empty frame view with room for every pipe.
+ * 
+ * @return FrameView The view.
+ */
+FrameView CreateFrameView(void) {
+    FrameView view = {0};
+    view.pipes = CreateObstacleField(NULL, PIPE_CAPACITY, PIPE_GAP, SCREEN_HEIGHT);
+    return view;
+}
+
+/**
+ * @brief Frees a frame view.
+ * 
+ * @param view A pointer to the view.
+ */
+void DestroyFrameView(FrameView *view) {
+    DestroyObstacleField(&view->pipes);
+    *view = (FrameView){0};
+}
+
+/**
+ * @brief Copies what the next frame draws out of the game.
+ * 
+ * Called at the end of an update, on whichever thread ran it. Positions
+ * are interpolated between the last two ticks here, so drawing the view
+ * needs nothing else from the simulation.
+ * 
+ * @param game A pointer to the game.
+ * @param view A pointer to the view to fill.
+ */
+void PublishFrameView(const Game *game, FrameView *view) {
+    float alpha = (game->gameState == PLAYING) ? GetFixedStepAlpha(&game->step) : 1.0f;
+    view->respondsToInput = (game->events & GAME_EVENT_INPUT) != 0;
+    view->gameState = game->gameState;
+    view->score = game->score;
+    view->highScore = game->highScore;
+    view->birdPosition = Vector2Lerp(game->bird.prevPosition, game->bird.position, alpha);
+    
+    // Keep only the animation's current frame; its frames live in the shared frame table.
+    const Animation *anim = &game->bird.animation;
+    bool hasFrame = anim->frameCount > 0 && anim->currentFrame < anim->frameCount;
+    if (hasFrame) view->birdFrame = anim->frames[anim->currentFrame];
+    view->bird = (Animation){ .spritesheet = anim->spritesheet, .frames = &view->birdFrame, .frameCount = hasFrame ? 1 : 0 };
+    
+    const ObstacleField *pipes = &game->pipeManager.pipes;
+    ObstacleField *dst = &view->pipes;
+    int count = pipes->count < dst->capacity ? pipes->count : dst->capacity;
+    for (int i = 0; i < count; i++) {
+        dst->x[i] = dst->prevX[i] = Lerp(pipes->prevX[i], pipes->x[i], alpha);
+        dst->gapY[i] = pipes->gapY[i];
+        dst->width[i] = pipes->width[i];
+    }
+    dst->gap = pipes->gap;
+    dst->count = count;
+}
+
+/**
+ * @brief Mixes a value into a frame key.
+ * 
+ * @param key The key so far.
+ * @param value The value to mix in.
+ * @return uint64_t The new key.
+ */
+static uint64_t MixFrameKey(uint64_t key, uint64_t value) {
+    key ^= value + 0x9E3779B97F4A7C15ull + (key << 6) + (key >> 2);
+    return key;
+}
+
+/**
+ * @brief Names what the next frame would show, if it can be skipped.
+ * 
+ * Only the READY and GAME_OVER screens stand still. While playing, with the
+ * profiler overlay up, with particles in flight, or on a frame that responds
+ * to a press, every frame differs and the key is 0.
+ * 
+ * @param game A pointer to the game.
+ * @param view The view the frame would draw.
+ * @return uint64_t The frame's content key, or 0 if it must be drawn.
+ */
+static uint64_t GetFrameKey(const Game *game, const FrameView *view) {
+    if (view->gameState == PLAYING || view->respondsToInput || game->showProfiler || HasLiveEffects(game)) return 0;
+    uint64_t key = MixFrameKey(0, (uint64_t)view->gameState + 1);
+    key = MixFrameKey(key, (uint64_t)(uint32_t)view->score);
+    key = MixFrameKey(key, (uint64_t)(uint32_t)view->highScore);
+    key = MixFrameKey(key, game->atlas.texture.id);
+    key = MixFrameKey(key, (uint64_t)view->pipes.count);
+    return key != 0 ? key : 1;
+}
+
+/**
+ * @brief Checks whether a view is already on screen, so drawing it would be skipped.
+ * 
+ * @param game A pointer to the game.
+ * @param view The view.
+ * @return true if DrawGame would skip the view, false otherwise.
+ */
+bool IsFrameViewShown(const Game *game, const FrameView *view) {
+    uint64_t frameKey = GetFrameKey(game, view);
+    return game->allowIdleFrames && frameKey != 0 && frameKey == game->presentedKey;
+}
+
+/**
+ * @brief Redraws the score layer if the scores changed.
+ * 
+ * @param game A pointer to the game.
+ * @param view The view being drawn.
+ */
+static void UpdateScoreLayer(Game *game, const FrameView *view) {
+    Hud *hud = &game->hud;
+    uint64_t key = ((uint64_t)(uint32_t)view->score << 32) | (uint32_t)view->highScore;
+    if (!BeginCachedLayer(&hud->scoreLayer, key)) return;
+    
+    SetCachedTextInt(&hud->score, "Score: %d", view->score);
+    SetCachedTextInt(&hud->highScore, "High: %d", view->highScore);
+    BeginSpriteBatch(&game->spriteBatch);
+    SubmitCachedText(&game->spriteBatch, &hud->score, (Vector2){ 10, 10 }, BLACK, LAYER_HUD);
+    SubmitCachedText(&game->spriteBatch, &hud->highScore, (Vector2){ 10, 50 }, DARKGRAY, LAYER_HUD);
+    FlushSpriteBatch(&game->spriteBatch);
+    EndCachedLayer(&hud->scoreLayer);
+}
+
+/**
+ * @brief Redraws the message layer if the screen or final score changed.
+ * 
+ * @param game A pointer to the game.
+ * @param view A view in the READY or GAME_OVER state.
+ */
+static void UpdateMessageLayer(Game *game, const FrameView *view) {
+    Hud *hud = &game->hud;
+    uint64_t key = ((uint64_t)view->gameState << 32) | (uint32_t)view->score;
+    if (!BeginCachedLayer(&hud->messageLayer, key)) return;
+    
+    SpriteBatch *batch = &game->spriteBatch;
+    BeginSpriteBatch(batch);
+    if (view->gameState == READY) {
+        // The title screen.
+        SubmitCachedText(batch, &hud->title, (Vector2){ SCREEN_WIDTH/2 - 120, SCREEN_HEIGHT/2 - 100 }, BLACK, LAYER_HUD);
+        SubmitCachedText(batch, &hud->startHint, (Vector2){ SCREEN_WIDTH/2 - 140, SCREEN_HEIGHT/2 - 50 }, DARKGRAY, LAYER_HUD);
+    } else {
+        // The game over screen.
+        SetCachedTextInt(&hud->finalScore, "Final Score: %d", view->score);
+        SubmitCachedText(batch, &hud->gameOver, (Vector2){ SCREEN_WIDTH/2 - 80, SCREEN_HEIGHT/2 - 50 }, RED, LAYER_HUD);
+        SubmitCachedText(batch, &hud->finalScore, (Vector2){ SCREEN_WIDTH/2 - 70, SCREEN_HEIGHT/2 }, BLACK, LAYER_HUD);
+        SubmitCachedText(batch, &hud->restartHint, (Vector2){ SCREEN_WIDTH/2 - 130, SCREEN_HEIGHT/2 + 30 }, DARKGRAY, LAYER_HUD);
+    }
+    FlushSpriteBatch(batch);
+    EndCachedLayer(&hud->messageLayer);
+}
+
+/**
+ * @brief Draws a frame view, or skips the frame if the screen would not change.
+ * 
+ * The HUD text lives in cached layers that are only redrawn when the scores
+ * or the screen change, and are otherwise composited as one quad each. When
+ * idle frames are allowed and a READY or GAME_OVER screen is already on
+ * display, nothing is drawn or swapped at all; the caller then only polls
+ * input and waits.
+ * 
+ * Only the view and the game's render state are read, never the
+ * simulation, so this may run while an update is in flight.
+ * 
+ * @param game A pointer to the game.
+ * @param view The view to draw.
+ * @return true if a frame was drawn, false if it was skipped.
+ */
+bool DrawGame(Game *game, const FrameView *view) {
+    if (IsFrameViewShown(game, view)) return false;
+    game->presentedKey = GetFrameKey(game, view);
+    
+    PROFILE_ZONE_BEGIN("DrawGame");
+    
+    // Begin drawing.
+    BeginDrawing();
+    
+    // Bring the cached text layers up to date before the frame's batch opens.
+    UpdateScoreLayer(game, view);
+    if (view->gameState != PLAYING) UpdateMessageLayer(game, view);
+    
+    // Clear the background.
+    ClearBackground(SKYBLUE);
+    
+    // Collect the sprites so each texture is drawn in a single batch.
+    SpriteBatch *batch = &game->spriteBatch;
+    BeginSpriteBatch(batch);
+    
+    // Draw the pipes, stretching the pipe sprite over each column.
+    const ObstacleField *pipes = &view->pipes;
+    Rectangle pipeSource = GetAtlasRegionRec(&game->atlas, game->pipeRegion);
+    for (int i = 0; i < pipes->count; i++) {
+        SubmitSprite(batch, game->atlas.texture, pipeSource, GetObstacleTopRec(pipes, i), WHITE, LAYER_PIPES);
+        SubmitSprite(batch, game->atlas.texture, pipeSource, GetObstacleBottomRec(pipes, i), WHITE, LAYER_PIPES);
+    }
+    
+    // Draw the bird's current animation frame, centered on its position.
+    SubmitAnimation(batch, &view->bird, view->birdPosition, 0.0f, WHITE, LAYER_BIRD);
+    FlushSpriteBatch(batch);
+    
+    // Draw the particles over the world and under the HUD; the batch
+    // carries on empty after the flush.
+    DrawEffects(game);
+    
+    // Composite the score and, outside of play, the screen's messages.
+    SubmitCachedLayer(batch, &game->hud.scoreLayer, WHITE, LAYER_HUD);
+    if (view->gameState != PLAYING) SubmitCachedLayer(batch, &game->hud.messageLayer, WHITE, LAYER_HUD);
+    
+    FlushSpriteBatch(batch);
+    
+    // In a latency test a corner patch turns from black to white on the first
+    // frame that responds to a press, for a photodiode on the glass.
+    if (game->latencyFlash) {
+        DrawRectangle(SCREEN_WIDTH - LATENCY_FLASH_SIZE, SCREEN_HEIGHT - LATENCY_FLASH_SIZE,
+                      LATENCY_FLASH_SIZE, LATENCY_FLASH_SIZE, view->respondsToInput ? WHITE : BLACK);
+    }
+    
+#ifdef DEBUG
+    // Show the sprite batch statistics.
+    SpriteBatchStats stats = GetSpriteBatchStats(batch);
+    DrawText(TextFormat("Sprites: %d  Draw calls: %d  Flushes: %d", stats.sprites, stats.drawCalls, stats.flushes),
+             10, SCREEN_HEIGHT - 25, 16, DARKGRAY);
+#endif
+    
+    PROFILE_ZONE_END();
+    
+#ifdef CORELIB_PROFILE
+    if (game->showProfiler) DrawProfilerOverlay(SCREEN_WIDTH - 310, 10);
+#endif
+    
+    // End drawing (buffer swap and frame pacing).
+    PROFILE_ZONE_BEGIN("EndDrawing");
+    EndDrawing();
+    PROFILE_ZONE_END();
+    return true;
+}
@@ -0,0 +1,473 @@
+/**
+ * @file trainer.c
+ * @brief Neuro-evolution of flapping policies, many birds to one world.
+ * 
+ * Every bird in a generation flies through the same stream of pipes, so the
+ * pipes are simulated once per thread instead of once per bird. The birds
+ * are stored as structure-of-arrays: their brains, physics and collisions
+ * each run as one loop over the flock, with the collisions done by the SIMD
+ * many-circles kernel. Dead birds are swapped out of the live range so the
+ * loops only cover birds still flying.
+ * 
+ * The population is split into one slice per thread, and each generation
+ * flies the slices with ParallelFor on the job system's workers. Each slice
+ * steps its own copy of the world from the generation's seed, so slices only
+ * meet between generations and the results do not depend on the thread
+ * count. If workers fail to start, their slices run on the calling thread.
+ * 
+ * Each brain is a small fixed-topology network evolved by elitism,
+ * tournament selection, uniform crossover and Gaussian mutation.
+ * 
+ * Built only with -DHEADLESS, as part of the headless runner.
+ * 
+ */
+
+#ifdef HEADLESS
+
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BRAIN_INPUTS 4      // Offset from the gap center, velocity, distance to the pipe, height.
+#define BRAIN_HIDDEN 6
+#define BRAIN_WEIGHTS (BRAIN_HIDDEN * (BRAIN_INPUTS + 1) + BRAIN_HIDDEN + 1)
+
+#define ELITE_FRACTION 0.05f    // The share of each generation copied unchanged.
+#define TOURNAMENT_SIZE 3       // The candidates drawn per parent selection.
+#define MUTATION_RATE 0.1f      // The chance of mutating each weight.
+#define MUTATION_SCALE 0.4f     // The standard deviation of a mutation.
+#define SCORE_FITNESS 1000.0f   // The fitness of a passed pipe, in ticks survived.
+
+/**
+ * @brief One thread's slice of the population, as structure-of-arrays.
+ * 
+ * Live birds are packed at the front; index i is a bird slot, not an agent.
+ * 
+ */
+typedef struct {
+    int count;          /**< The birds in the slice. */
+    int alive;          /**< The live birds, packed at the front. */
+    int *agent;         /**< The population index of each bird. */
+    float *x;           /**< The horizontal positions (all equal, for the collision kernel). */
+    float *y;           /**< The vertical positions. */
+    float *vy;          /**< The vertical velocities. */
+    float *weights;     /**< Weight w of bird i at weights[w * count + i]. */
+    float *hidden;      /**< Scratch for one hidden unit's activations. */
+    float *output;      /**< Scratch for the network outputs. */
+    uint32_t *dead;     /**< Bitset of birds that died this tick. */
+} Flock;
+
+/**
+ * @brief The state shared by the slices.
+ * 
+ */
+typedef struct {
+    int population;     /**< The number of agents. */
+    long maxTicks;      /**< The tick limit for one generation. */
+    uint64_t seed;      /**< The seed of the current generation's world. */
+    float *genomes;     /**< Agent a's weights at genomes[a * BRAIN_WEIGHTS]. */
+    float *fitness;     /**< The fitness of each agent in the last generation. */
+    int *scores;        /**< The score of each agent in the last generation. */
+} Trainer;
+
+/**
+ * @brief One slice of the population and its world.
+ * 
+ */
+typedef struct {
+    Trainer *trainer;   /**< The shared state. */
+    int begin;          /**< The first agent of the slice. */
+    Flock flock;        /**< The slice's birds. */
+    Game world;         /**< The slice's copy of the world. */
+    long long birdTicks;    /**< The bird-ticks simulated, summed over live birds. */
+    int survivors;      /**< The birds alive at the tick limit. */
+} TrainerWorker;
+
+/**
+ * @brief Allocates a flock for up to count birds.
+ * 
+ * @param count The slice size.
+ * @return Flock The flock; its count is 0 if allocation failed.
+ */
+static Flock CreateFlock(int count) {
+    Flock flock = {0};
+    flock.agent = malloc(sizeof(int) * (size_t)count);
+    flock.x = malloc(sizeof(float) * (size_t)count);
+    flock.y = malloc(sizeof(float) * (size_t)count);
+    flock.vy = malloc(sizeof(float) * (size_t)count);
+    flock.weights = malloc(sizeof(float) * BRAIN_WEIGHTS * (size_t)count);
+    flock.hidden = malloc(sizeof(float) * (size_t)count);
+    flock.output = malloc(sizeof(float) * (size_t)count);
+    flock.dead = malloc(sizeof(uint32_t) * (size_t)((count + 31) / 32));
+    if (flock.agent && flock.x && flock.y && flock.vy && flock.weights && flock.hidden && flock.output && flock.dead) {
+        flock.count = count;
+    }
+    return flock;
+}
+
+/**
+ * @brief Frees a flock.
+ * 
+ * @param flock A pointer to the flock.
+ */
+static void DestroyFlock(Flock *flock) {
+    free(flock->agent);
+    free(flock->x);
+    free(flock->y);
+    free(flock->vy);
+    free(flock->weights);
+    free(flock->hidden);
+    free(flock->output);
+    free(flock->dead);
+    *flock = (Flock){0};
+}
+
+/**
+ * @brief Moves bird src into slot dst, overwriting it.
+ * 
+ * @param flock A pointer to the flock.
+ * @param dst The slot to fill.
+ * @param src The slot to move.
+ */
+static void MoveFlockBird(Flock *flock, int dst, int src) {
+    flock->agent[dst] = flock->agent[src];
+    flock->y[dst] = flock->y[src];
+    flock->vy[dst] = flock->vy[src];
+    for (int w = 0; w < BRAIN_WEIGHTS; w++) {
+        flock->weights[w * flock->count + dst] = flock->weights[w * flock->count + src];
+    }
+}
+
+/**
+ * @brief A cheap sigmoid-shaped activation that vectorizes.
+ * 
+ * @param x The input.
+ * @return float x / (1 + |x|), in (-1, 1).
+ */
+static inline float Softsign(float x) {
+    return x / (1.0f + (x < 0.0f ? -x : x));
+}
+
+/**
+ * @brief Runs every live bird's brain, leaving its decision in flock->output.
+ * 
+ * Each layer is a loop over the birds for one weight at a time, so the
+ * compiler can vectorize it across birds.
+ * 
+ * @param flock A pointer to the flock.
+ * @param gapCenter The center of the next gap.
+ * @param pipeDistance The distance from the birds to the next pipe.
+ */
+static void ThinkFlock(Flock *flock, float gapCenter, float pipeDistance) {
+    int n = flock->alive;
+    int stride = flock->count;
+    const float *y = flock->y;
+    const float *vy = flock->vy;
+    float *hidden = flock->hidden;
+    float *output = flock->output;
+    float distance = pipeDistance / SCREEN_WIDTH;
+
+    const float *bias = flock->weights + (size_t)(BRAIN_HIDDEN * (BRAIN_INPUTS + 1) + BRAIN_HIDDEN) * stride;
+    for (int i = 0; i < n; i++) output[i] = bias[i];
+
+    for (int k = 0; k < BRAIN_HIDDEN; k++) {
+        const float *w = flock->weights + (size_t)(k * (BRAIN_INPUTS + 1)) * stride;
+        for (int i = 0; i < n; i++) {
+            float offset = (y[i] - gapCenter) * (1.0f / SCREEN_HEIGHT);
+            float sum = w[i] * offset
+                      + w[stride + i] * (vy[i] * (1.0f / 1000.0f))
+                      + w[2 * stride + i] * distance
+                      + w[3 * stride + i] * (y[i] * (1.0f / SCREEN_HEIGHT))
+                      + w[4 * stride + i];
+            hidden[i] = Softsign(sum);
+        }
+        const float *v = flock->weights + (size_t)(BRAIN_HIDDEN * (BRAIN_INPUTS + 1) + k) * stride;
+        for (int i = 0; i < n; i++) output[i] += v[i] * hidden[i];
+    }
+}
+
+/**
+ * @brief Records a bird's fitness and score when it dies or the time runs out.
+ * 
+ * @param trainer A pointer to the shared state.
+ * @param agent The bird's agent.
+ * @param ticks The ticks it survived.
+ * @param score The pipes it passed.
+ * @param offset How far it was from the gap center, in pixels.
+ */
+static void ScoreAgent(Trainer *trainer, int agent, long ticks, int score, float offset) {
+    if (offset < 0.0f) offset = -offset;
+    trainer->fitness[agent] = (float)ticks + SCORE_FITNESS * (float)score - 100.0f * offset / SCREEN_HEIGHT;
+    trainer->scores[agent] = score;
+}
+
+/**
+ * @brief Flies one slice through one generation.
+ * 
+ * Each tick mirrors StepGame for every live bird at once: flap, integrate,
+ * check the screen edges, step the shared pipes, collide and score.
+ * 
+ * @param worker A pointer to the slice.
+ */
+static void FlySlice(TrainerWorker *worker) {
+    Trainer *trainer = worker->trainer;
+    Flock *flock = &worker->flock;
+    Game *world = &worker->world;
+    float dt = 1.0f / TICK_RATE;
+
+    // Start the world and give every bird the opening flap.
+    StartSession(world, trainer->seed);
+    world->gameState = PLAYING;
+    float birdX = world->bird.position.x;
+    float radius = world->bird.radius;
+    for (int i = 0; i < flock->count; i++) {
+        int agent = worker->begin + i;
+        flock->agent[i] = agent;
+        flock->x[i] = birdX;
+        flock->y[i] = world->bird.position.y;
+        flock->vy[i] = JUMP_FORCE;
+        const float *genome = trainer->genomes + (size_t)agent * BRAIN_WEIGHTS;
+        for (int w = 0; w < BRAIN_WEIGHTS; w++) flock->weights[w * flock->count + i] = genome[w];
+    }
+    flock->alive = flock->count;
+    worker->birdTicks = 0;
+
+    int score = 0;
+    long t = 0;
+    float gapCenter = SCREEN_HEIGHT / 2.0f;
+    for (; t < trainer->maxTicks && flock->alive > 0; t++) {
+        ResetArena(&world->frameArena);
+        int n = flock->alive;
+        worker->birdTicks += n;
+
+        // Aim at the nearest gap still ahead of the birds, as the autopilot does.
+        const ObstacleField *pipes = &world->pipeManager.pipes;
+        float nearestX = SCREEN_WIDTH;
+        for (int j = 0; j < pipes->count; j++) {
+            if (pipes->x[j] + pipes->width[j] < birdX - radius || pipes->x[j] >= nearestX) continue;
+            nearestX = pipes->x[j];
+            gapCenter = pipes->gapY[j] + PIPE_GAP * 0.5f;
+        }
+
+        // Flap where the brain says so, then apply gravity.
+        ThinkFlock(flock, gapCenter, nearestX - birdX);
+        for (int i = 0; i < n; i++) {
+            float vy = flock->output[i] > 0.0f ? JUMP_FORCE : flock->vy[i];
+            vy += GRAVITY * dt;
+            flock->vy[i] = vy;
+            flock->y[i] += vy * dt;
+        }
+
+        // Birds die on the screen edges, then on the pipes once they move.
+        StepPipes(world, dt);
+        CollideObstaclesCircles(&world->pipeManager.pipes, flock->x, flock->y, n, radius, flock->dead);
+        for (int i = 0; i < n; i++) {
+            if (flock->y[i] <= radius || flock->y[i] >= SCREEN_HEIGHT - radius) flock->dead[i >> 5] |= 1u << (i & 31);
+        }
+
+        // Retire the dead from the back, so each swap brings in a live bird.
+        for (int i = n - 1; i >= 0; i--) {
+            if (!(flock->dead[i >> 5] & (1u << (i & 31)))) continue;
+            ScoreAgent(trainer, flock->agent[i], t + 1, score, flock->y[i] - gapCenter);
+            MoveFlockBird(flock, i, --flock->alive);
+        }
+
+        // The survivors all pass a pipe on the same tick.
+        score += ScoreObstacles(&world->pipeManager.pipes, birdX);
+    }
+
+    // Score the birds that reached the tick limit.
+    worker->survivors = flock->alive;
+    for (int i = 0; i < flock->alive; i++) {
+        ScoreAgent(trainer, flock->agent[i], t, score, flock->y[i] - gapCenter);
+    }
+}
+
+/**
+ * @brief The ParallelFor body: flies slices begin to end through one generation.
+ * 
+ * @param begin The first slice.
+ * @param end One past the last slice.
+ * @param data The TrainerWorker array.
+ */
+static void FlySlices(int begin, int end, void *data) {
+    TrainerWorker *workers = data;
+    for (int i = begin; i < end; i++) FlySlice(&workers[i]);
+}
+
+/**
+ * @brief Picks a parent by tournament: the fittest of a few random agents.
+ * 
+ * @param trainer A pointer to the shared state.
+ * @param rng The random source.
+ * @return int The chosen agent.
+ */
+static int SelectParent(const Trainer *trainer, Rng *rng) {
+    int best = RandomRange(rng, 0, trainer->population - 1);
+    for (int i = 1; i < TOURNAMENT_SIZE; i++) {
+        int candidate = RandomRange(rng, 0, trainer->population - 1);
+        if (trainer->fitness[candidate] > trainer->fitness[best]) best = candidate;
+    }
+    return best;
+}
+
+/**
+ * @brief Orders agents by fitness, fittest first, for qsort.
+ * 
+ */
+typedef struct {
+    float fitness;  /**< The agent's fitness. */
+    int agent;      /**< The agent. */
+} RankedAgent;
+
+static int CompareRankedAgents(const void *a, const void *b) {
+    float fa = ((const RankedAgent *)a)->fitness;
+    float fb = ((const RankedAgent *)b)->fitness;
+    if (fa != fb) return fa > fb ? -1 : 1;
+    return ((const RankedAgent *)a)->agent - ((const RankedAgent *)b)->agent;
+}
+
+/**
+ * @brief Breeds the next generation's genomes from the last one's fitness.
+ * 
+ * @param trainer A pointer to the shared state.
+ * @param next The buffer for the new genomes, the size of trainer->genomes.
+ * @param ranked Scratch space for one RankedAgent per agent.
+ * @param rng The random source.
+ */
+static void BreedGeneration(Trainer *trainer, float *next, RankedAgent *ranked, Rng *rng) {
+    int population = trainer->population;
+    for (int a = 0; a < population; a++) ranked[a] = (RankedAgent){ trainer->fitness[a], a };
+    qsort(ranked, (size_t)population, sizeof(RankedAgent), CompareRankedAgents);
+
+    // Copy the elite unchanged; breed the rest from tournament winners.
+    int elite = (int)(population * ELITE_FRACTION);
+    if (elite < 1) elite = 1;
+    for (int a = 0; a < population; a++) {
+        float *child = next + (size_t)a * BRAIN_WEIGHTS;
+        if (a < elite) {
+            memcpy(child, trainer->genomes + (size_t)ranked[a].agent * BRAIN_WEIGHTS, sizeof(float) * BRAIN_WEIGHTS);
+            continue;
+        }
+        const float *mother = trainer->genomes + (size_t)SelectParent(trainer, rng) * BRAIN_WEIGHTS;
+        const float *father = trainer->genomes + (size_t)SelectParent(trainer, rng) * BRAIN_WEIGHTS;
+        for (int w = 0; w < BRAIN_WEIGHTS; w++) {
+            child[w] = (NextRandom(rng) & 1) ? mother[w] : father[w];
+            if (RandomFloat(rng) < MUTATION_RATE) child[w] += MUTATION_SCALE * RandomNormal(rng);
+        }
+    }
+    memcpy(trainer->genomes, next, sizeof(float) * BRAIN_WEIGHTS * (size_t)population);
+}
+
+/**
+ * @brief Evolves a population of flapping policies and reports the progress.
+ * 
+ * @param generations The number of generations to run.
+ * @param population The number of agents.
+ * @param threads The number of slices, and of threads to fly them on.
+ * @param seed The base seed; generation g flies through the world of seed + g.
+ * @param maxTicks The tick limit for one generation.
+ * @return int The exit code.
+ */
+int TrainPopulation(int generations, int population, int threads, uint64_t seed, long maxTicks) {
+    if (population < 2) population = 2;
+    if (threads > population) threads = population;
+    if (threads < 1) threads = 1;
+
+    Trainer trainer = { .population = population, .maxTicks = maxTicks };
+    trainer.genomes = malloc(sizeof(float) * BRAIN_WEIGHTS * (size_t)population);
+    trainer.fitness = calloc((size_t)population, sizeof(float));
+    trainer.scores = calloc((size_t)population, sizeof(int));
+    float *next = malloc(sizeof(float) * BRAIN_WEIGHTS * (size_t)population);
+    RankedAgent *ranked = malloc(sizeof(RankedAgent) * (size_t)population);
+    TrainerWorker *workers = calloc((size_t)threads, sizeof(TrainerWorker));
+    bool ok = trainer.genomes && trainer.fitness && trainer.scores && next && ranked && workers;
+
+    // Split the population into one slice per thread.
+    for (int i = 0; ok && i < threads; i++) {
+        int begin = (int)((long long)population * i / threads);
+        int end = (int)((long long)population * (i + 1) / threads);
+        workers[i].trainer = &trainer;
+        workers[i].begin = begin;
+        workers[i].flock = CreateFlock(end - begin);
+        workers[i].world.levelArena = CreateArena(LEVEL_ARENA_SIZE);
+        workers[i].world.frameArena = CreateArena(FRAME_ARENA_SIZE);
+        ok = workers[i].flock.count == end - begin
+          && workers[i].world.levelArena.base && workers[i].world.frameArena.base;
+    }
+    if (!ok) {
+        fprintf(stderr, "Out of memory\n");
+        generations = 0;
+    }
+
+    // Start the workers once for the whole run; a headless runner has not
+    // started the job system itself, so it is the trainer's to close.
+    bool ownsJobs = ok && GetJobThreadCount() == 0;
+    if (ownsJobs) InitJobSystem(threads - 1);
+
+    // Start from small random weights.
+    Rng rng = CreateRng(seed ^ 0x7EA1ull);
+    for (int i = 0; ok && i < BRAIN_WEIGHTS * population; i++) trainer.genomes[i] = 0.5f * RandomNormal(&rng);
+
+    int reportEvery = generations > 20 ? generations / 20 : 1;
+    int bestScore = 0;
+    int bestGeneration = 0;
+    long long birdTicks = 0;
+    double start = GetClockSeconds();
+    for (int g = 0; g < generations; g++) {
+        trainer.seed = seed + (uint64_t)g;
+        ParallelFor(threads, 1, FlySlices, workers);
+
+        int survivors = 0;
+        for (int i = 0; i < threads; i++) {
+            birdTicks += workers[i].birdTicks;
+            survivors += workers[i].survivors;
+        }
+
+        // Report on the generation before it is replaced.
+        long long scoreSum = 0;
+        int generationBest = 0;
+        for (int a = 0; a < population; a++) {
+            scoreSum += trainer.scores[a];
+            if (trainer.scores[a] > generationBest) generationBest = trainer.scores[a];
+        }
+        if (generationBest > bestScore) {
+            bestScore = generationBest;
+            bestGeneration = g;
+        }
+        if (g % reportEvery == 0 || g == generations - 1) {
+            printf("gen %5d: best %4d, mean %7.2f, %d at the tick limit\n",
+                   g, generationBest, (double)scoreSum / population, survivors);
+        }
+
+        BreedGeneration(&trainer, next, ranked, &rng);
+    }
+    double elapsed = GetClockSeconds() - start;
+    if (elapsed <= 0.0) elapsed = 1e-9;
+
+    if (ok) {
+        int running = GetJobThreadCount();
+        printf("trained:   %d generations of %d birds on %d threads\n", generations, population, running > 1 ? running : 1);
+        printf("best:      score %d in generation %d\n", bestScore, bestGeneration);
+        printf("wall:      %.3f s, %.2f generations/s, %.0f bird-ticks/s\n",
+               elapsed, generations / elapsed, (double)birdTicks / elapsed);
+    }
+
+    for (int i = 0; workers && i < threads; i++) {
+        DestroyFlock(&workers[i].flock);
+        DestroyObjectPool(&workers[i].world.pipeManager.pool);
+        DestroyArena(&workers[i].world.levelArena);
+        DestroyArena(&workers[i].world.frameArena);
+    }
+    if (ownsJobs) CloseJobSystem();
+    free(workers);
+    free(ranked);
+    free(next);
+    free(trainer.scores);
+    free(trainer.fitness);
+    free(trainer.genomes);
+    return ok ? 0 : 1;
+}
+
+#endif // HEADLESS
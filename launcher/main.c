@@ -0,0 +1,141 @@
+/**
+ * @file main.c
+ * @brief A host that plays the games built as modules in one process.
+ * 
+ * Opens the window and the audio device once, loads every game module in
+ * a plugins directory, and lists the games. Enter plays the selected one;
+ * Escape in a game comes back to the list, and Escape in the list quits.
+ * Because the window, GL context and audio device stay open and the
+ * modules stay loaded, switching games costs only the game's own setup.
+ * 
+ * Usage: launcher [--plugins DIR] [--run GAME] [-- game arguments...]
+ * 
+ * Plugins default to plugins/ next to the executable. --run plays GAME,
+ * the module's file name without its extension, before showing the list.
+ * Arguments after -- are passed to every game that is played.
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LAUNCHER_WIDTH 640          /**< The window width while the list is shown. */
+#define LAUNCHER_HEIGHT 480         /**< The window height while the list is shown. */
+#define LAUNCHER_MAX_GAMES 32       /**< The most modules loaded from the plugins directory. */
+#define LAUNCHER_MAX_ARGS 32        /**< The most arguments passed on to a game. */
+
+/**
+ * @brief A loaded game.
+ * 
+ */
+typedef struct {
+    GameModule module;      /**< The module and its plugin. */
+    char id[64];            /**< The module's file name without its extension. */
+} LauncherGame;
+
+/**
+ * @brief Plays one game and restores the host's window afterwards.
+ * 
+ * @param game The game.
+ * @param argc The game's argument count.
+ * @param argv The game's arguments, argv[0] first.
+ */
+static void PlayLauncherGame(const LauncherGame *game, int argc, char **argv) {
+    TraceLog(LOG_INFO, "LAUNCHER: Playing %s", game->module.plugin->name);
+    int code = game->module.plugin->run(argc, argv);
+    if (code != 0) TraceLog(LOG_WARNING, "LAUNCHER: %s exited with code %d", game->module.plugin->name, code);
+    
+    SetWindowSize(LAUNCHER_WIDTH, LAUNCHER_HEIGHT);
+    SetWindowTitle("Launcher");
+    SetTargetFPS(60);
+}
+
+int main(int argc, char **argv) {
+    const char *pluginDir = NULL;
+    const char *runId = NULL;
+    char *gameArgs[LAUNCHER_MAX_ARGS + 1] = { argv[0] };
+    int gameArgCount = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--plugins") == 0 && i + 1 < argc) pluginDir = argv[++i];
+        else if (strcmp(argv[i], "--run") == 0 && i + 1 < argc) runId = argv[++i];
+        else if (strcmp(argv[i], "--") == 0) {
+            while (++i < argc && gameArgCount < LAUNCHER_MAX_ARGS) gameArgs[gameArgCount++] = argv[i];
+        } else {
+            fprintf(stderr, "Usage: %s [--plugins DIR] [--run GAME] [-- game arguments...]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    // Open what every game shares. Escape leaves a game rather than closing the window.
+    SetConfigFlags(FLAG_VSYNC_HINT);
+    InitWindow(LAUNCHER_WIDTH, LAUNCHER_HEIGHT, "Launcher");
+    SetExitKey(KEY_NULL);
+    SetTargetFPS(60);
+    InitAudioDevice();
+    
+    // Load every module up front, so playing one later does not wait on the loader.
+    char defaultDir[1024];
+    if (pluginDir == NULL) {
+        snprintf(defaultDir, sizeof(defaultDir), "%splugins", GetApplicationDirectory());
+        pluginDir = defaultDir;
+    }
+    LauncherGame games[LAUNCHER_MAX_GAMES];
+    int gameCount = 0;
+    double start = GetClockSeconds();
+    FilePathList files = DirectoryExists(pluginDir) ? LoadDirectoryFiles(pluginDir) : (FilePathList){0};
+    for (unsigned int i = 0; i < files.count && gameCount < LAUNCHER_MAX_GAMES; i++) {
+        if (!IsFileExtension(files.paths[i], GAME_MODULE_EXTENSION)) continue;
+        LauncherGame *game = &games[gameCount];
+        game->module = LoadGameModule(files.paths[i]);
+        if (game->module.plugin == NULL) continue;
+        snprintf(game->id, sizeof(game->id), "%s", GetFileNameWithoutExt(files.paths[i]));
+        gameCount++;
+    }
+    UnloadDirectoryFiles(files);
+    TraceLog(LOG_INFO, "LAUNCHER: Loaded %d games from %s in %.1f ms",
+             gameCount, pluginDir, (GetClockSeconds() - start) * 1000.0);
+    
+    int selected = 0;
+    bool returned = false;
+    for (int i = 0; runId != NULL && i < gameCount; i++) {
+        if (strcmp(games[i].id, runId) != 0) continue;
+        selected = i;
+        PlayLauncherGame(&games[i], gameArgCount, gameArgs);
+        returned = true;
+    }
+    
+    // List the games until the window closes or Escape quits. The keys a
+    // game saw on its last frame still read as pressed, so the first frame
+    // back ignores them.
+    while (!WindowShouldClose()) {
+        if (!returned) {
+            if (IsKeyPressed(KEY_ESCAPE)) break;
+            if (gameCount > 0 && IsKeyPressed(KEY_DOWN)) selected = (selected + 1) % gameCount;
+            if (gameCount > 0 && IsKeyPressed(KEY_UP)) selected = (selected + gameCount - 1) % gameCount;
+            if (gameCount > 0 && (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE))) {
+                PlayLauncherGame(&games[selected], gameArgCount, gameArgs);
+                returned = true;
+                continue;
+            }
+        }
+        returned = false;
+        
+        BeginDrawing();
+        ClearBackground(DARKGRAY);
+        DrawText("Launcher", 40, 30, 40, RAYWHITE);
+        if (gameCount == 0) DrawText(TextFormat("No games in %s", pluginDir), 40, 110, 20, LIGHTGRAY);
+        for (int i = 0; i < gameCount; i++) {
+            Color color = i == selected ? GOLD : LIGHTGRAY;
+            DrawText(TextFormat("%s %s", i == selected ? ">" : " ", games[i].module.plugin->name), 40, 110 + 36 * i, 28, color);
+        }
+        DrawText("Up/Down to choose, Enter to play, Escape to quit", 40, LAUNCHER_HEIGHT - 40, 20, GRAY);
+        EndDrawing();
+    }
+    
+    for (int i = 0; i < gameCount; i++) UnloadGameModule(&games[i].module);
+    CloseAudioDevice();
+    CloseWindow();
+    return 0;
+}
@@ -4,22 +4,31 @@
 #include "raylib.h"
 #include <stdbool.h>
 
-typedef struct {
-    Rectangle source;
-    float duration;
-} AnimationFrame;
-
-typedef struct {
-    Texture2D spritesheet;
-    AnimationFrame* frames;
-    int frameCount;
-    int currentFrame;
-    float frameTimer;
-    bool loop;
-} Animation;
-
-Animation CreateAnimation(Texture2D spritesheet, Rectangle* frames, int frameCount, float frameDuration, bool loop);
-void UpdateAnimation(Animation* anim, float deltaTime);
-void DrawAnimation(Animation anim, Vector2 position, float rotation);
+#include "corelib/animation.h"
+#include "corelib/archive.h"
+#include "corelib/arena.h"
+#include "corelib/assets.h"
+#include "corelib/atlas.h"
+#include "corelib/clock.h"
+#include "corelib/input.h"
+#include "corelib/jobs.h"
+#include "corelib/layers.h"
+#include "corelib/metrics.h"
+#include "corelib/mixer.h"
+#include "corelib/obstacles.h"
+#include "corelib/pacing.h"
+#include "corelib/particles.h"
+#include "corelib/plugin.h"
+#include "corelib/pool.h"
+#include "corelib/profiler.h"
+#include "corelib/random.h"
+#include "corelib/snapshot.h"
+#include "corelib/spatial.h"
+#include "corelib/spritebatch.h"
+#include "corelib/stats.h"
+#include "corelib/text.h"
+#include "corelib/timestep.h"
+#include "corelib/tunables.h"
+#include "corelib/watch.h"
 
 #endif
\ No newline at end of file
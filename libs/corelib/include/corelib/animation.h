@@ -0,0 +1,90 @@
+/**
+ * @file animation.h
+ * @brief Sprite animations and shared frame tables from the anim_compiler build step.
+ *
+ * An Animation is a cursor into a run of AnimationFrames: each instance
+ * keeps only its current frame and timer. Frames either belong to the
+ * instance (CreateAnimation, CreateAnimationFromAtlas) or live in an
+ * AnimationTable that any number of instances share
+ * (CreateAnimationFromTable), which costs no allocation per instance.
+ *
+ * An .anim file holds every clip of a game with per-frame durations. It is
+ * compiled from a text definition at build time and loads with one read
+ * into one block: the clip table, then the contiguous frames. Frames name
+ * atlas regions by hash. BindAnimationTable resolves them against an atlas,
+ * and every instance of the table sees the result.
+ *
+ * Layout (little-endian):
+ *   u32 magic, u16 version, u16 clipCount, u32 frameCount, u32 reserved
+ *   clipCount x { u32 nameHash, u16 firstFrame, u16 frameCount, u32 flags }, sorted by nameHash
+ *   frameCount x { u32 regionHash, f32 duration in seconds }
+ *
+ */
+
+#ifndef CORELIB_ANIMATION_H
+#define CORELIB_ANIMATION_H
+
+#include "raylib.h"
+#include "corelib/arena.h"
+#include "corelib/atlas.h"
+#include "corelib/spritebatch.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ANIMATION_MAGIC 0x4D494E41u     /**< "ANIM" read as a little-endian u32. */
+#define ANIMATION_VERSION 1
+#define ANIMATION_HEADER_SIZE 16
+#define ANIMATION_CLIP_SIZE 12
+#define ANIMATION_FRAME_SIZE 8
+#define ANIMATION_CLIP_LOOP 1u          /**< Clip flag: wrap to the first frame after the last. */
+
+typedef struct {
+    Rectangle source;       /**< The frame in spritesheet pixels. */
+    float duration;         /**< The seconds the frame is shown. */
+    int region;             /**< The atlas region the frame was bound to, or -1. */
+} AnimationFrame;
+
+typedef struct {
+    Texture2D spritesheet;  /**< The texture the frames are cut from. */
+    AnimationFrame* frames; /**< The frames, owned or shared with a table. */
+    int frameCount;         /**< The number of frames. */
+    int currentFrame;       /**< The frame shown now. */
+    float frameTimer;       /**< The seconds the current frame has been shown. */
+    bool loop;              /**< Whether the animation wraps after its last frame. */
+    bool ownsFrames;        /**< Whether frames came from the heap rather than an arena or a table. */
+} Animation;
+
+typedef struct {
+    uint32_t nameHash;      /**< HashAtlasName of the clip's name. */
+    int firstFrame;         /**< The clip's first frame in the table. */
+    int frameCount;         /**< The number of frames in the clip. */
+    bool loop;              /**< Whether the clip loops. */
+} AnimationClip;
+
+typedef struct {
+    AnimationClip* clips;       /**< The clips, sorted by nameHash. */
+    int clipCount;              /**< The number of clips. */
+    AnimationFrame* frames;     /**< Every clip's frames, back to back. */
+    uint32_t* regionHashes;     /**< The atlas region name hash of each frame. */
+    int frameCount;             /**< The number of frames. */
+} AnimationTable;
+
+Animation CreateAnimation(Arena* arena, Texture2D spritesheet, Rectangle* frames, int frameCount, float frameDuration, bool loop);
+Animation CreateAnimationFromAtlas(Arena* arena, const TextureAtlas* atlas, const int* regionIds, int frameCount, float frameDuration, bool loop);
+Animation CreateAnimationFromTable(const AnimationTable* table, int clip, Texture2D spritesheet);
+void RebindAnimation(Animation* anim, const TextureAtlas* atlas, const int* regionIds);
+void DestroyAnimation(Animation* anim);
+void UpdateAnimation(Animation* anim, float deltaTime);
+void UpdateAnimations(Animation* anims, int count, float deltaTime);
+void DrawAnimation(const Animation* anim, Vector2 position, float rotation);
+void DrawAnimations(const Animation* anims, const Vector2* positions, int count);
+void SubmitAnimation(SpriteBatch* batch, const Animation* anim, Vector2 position, float rotation, Color tint, int layer);
+
+bool LoadAnimationTableFromMemory(const unsigned char* data, size_t size, AnimationTable* table);
+AnimationTable LoadAnimationTable(const char* fileName);
+void UnloadAnimationTable(AnimationTable* table);
+void BindAnimationTable(AnimationTable* table, const TextureAtlas* atlas);
+int FindAnimationClip(const AnimationTable* table, const char* name);
+
+#endif
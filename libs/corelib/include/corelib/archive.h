@@ -0,0 +1,79 @@
+/**
+ * @file archive.h
+ * @brief Memory-mapped asset archives produced by the asset_packer build step.
+ *
+ * An archive packs a game's assets into one file, already decoded: images
+ * as raw pixels in their raylib PixelFormat, sounds as PCM, atlases as a
+ * region table plus pixels. Opening one maps it read-only, and the
+ * getters hand raylib pointers straight into the mapping. There is
+ * one open per archive, no per-asset syscalls and no runtime decoding, and
+ * processes mapping the same archive share its pages.
+ *
+ * Opening checks that every entry lies inside the file and holds all the
+ * bytes its parameters describe, so a truncated or corrupt archive fails to
+ * open instead of letting raylib read past the mapping.
+ *
+ * Layout (little-endian):
+ *   u32 magic, u16 version, u16 entryCount, u32 dataOffset, u32 reserved
+ *   entryCount x ArchiveEntry, sorted by nameHash
+ *   entry data, each blob aligned to ARCHIVE_ALIGN
+ *
+ * Entries are named by their path under the game's asset directory, e.g.
+ * "audio/flap.wav", hashed with HashAtlasName.
+ *
+ */
+
+#ifndef CORELIB_ARCHIVE_H
+#define CORELIB_ARCHIVE_H
+
+#include "raylib.h"
+#include "corelib/atlas.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ARCHIVE_MAGIC 0x4B504C43u   /**< "CLPK" read as a little-endian u32. */
+#define ARCHIVE_VERSION 1
+#define ARCHIVE_HEADER_SIZE 16
+#define ARCHIVE_ALIGN 64
+
+typedef enum {
+    ARCHIVE_RAW,        /**< Bytes stored as-is. */
+    ARCHIVE_IMAGE,      /**< params: width, height, mipmaps; format: PixelFormat. */
+    ARCHIVE_WAVE,       /**< params: frameCount, sampleRate, sampleSize, channels. */
+    ARCHIVE_ATLAS       /**< params: width, height, mipmaps, regionCount; AtlasRegion table, then pixels. */
+} ArchiveEntryType;
+
+typedef struct {
+    uint32_t nameHash;      /**< HashAtlasName of the entry's path. */
+    uint16_t type;          /**< The ArchiveEntryType. */
+    uint16_t format;        /**< The PixelFormat of image and atlas entries. */
+    uint64_t offset;        /**< The data offset from the start of the file. */
+    uint64_t size;          /**< The data size in bytes. */
+    uint32_t params[4];     /**< Type-specific fields, see ArchiveEntryType. */
+} ArchiveEntry;
+
+typedef struct {
+    const unsigned char* base;      /**< The mapped file. */
+    size_t size;                    /**< The mapped size. */
+    const ArchiveEntry* entries;    /**< The table of contents, inside the mapping. */
+    int entryCount;                 /**< The number of entries. */
+} AssetArchive;
+
+bool OpenAssetArchive(AssetArchive* archive, const char* fileName);
+void CloseAssetArchive(AssetArchive* archive);
+int FindArchiveEntry(const AssetArchive* archive, const char* name);
+
+// These point into the mapping: do not unload the results, and keep the
+// archive open for as long as they are used.
+const unsigned char* GetArchiveData(const AssetArchive* archive, int entry, size_t* size);
+Image GetArchiveImage(const AssetArchive* archive, int entry);
+Wave GetArchiveWave(const AssetArchive* archive, int entry);
+// Copies the region table to the heap and points image at the mapped pixels;
+// upload with LoadTextureFromImage and release with UnloadTextureAtlas.
+bool GetArchiveAtlas(const AssetArchive* archive, int entry, TextureAtlas* atlas, Image* image);
+
+// Offset of an atlas entry's pixels after its region table.
+size_t GetArchiveAtlasPixelOffset(int regionCount);
+
+#endif
@@ -0,0 +1,40 @@
+/**
+ * @file arena.h
+ * @brief Linear arena allocator for level- and frame-lifetime memory.
+ *
+ * An arena hands out memory by bumping an offset through one fixed block
+ * and releases everything at once with ResetArena, which is O(1) no matter
+ * how much was allocated. Use one arena per level (reset on restart) and a
+ * scratch arena reset every frame for temporaries.
+ *
+ * corelib constructors that take an Arena* allocate from it when it is not
+ * NULL; the matching Destroy function is then a no-op and the memory goes
+ * away with the arena. Passing NULL falls back to the heap.
+ *
+ */
+
+#ifndef CORELIB_ARENA_H
+#define CORELIB_ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_DEFAULT_ALIGN 16
+
+typedef struct {
+    unsigned char* base;    /**< The backing block. */
+    size_t size;            /**< The block size in bytes. */
+    size_t offset;          /**< The first free byte. */
+    size_t peak;            /**< The high-water mark of offset since creation. */
+} Arena;
+
+typedef size_t ArenaMark;
+
+Arena CreateArena(size_t size);
+void DestroyArena(Arena* arena);
+void* ArenaAlloc(Arena* arena, size_t size);
+void* ArenaAllocAligned(Arena* arena, size_t size, size_t align);
+void ResetArena(Arena* arena);
+ArenaMark GetArenaMark(const Arena* arena);
+void RewindArena(Arena* arena, ArenaMark mark);
+
+#endif
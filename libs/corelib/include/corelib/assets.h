@@ -0,0 +1,80 @@
+/**
+ * @file assets.h
+ * @brief Asynchronous asset loading with placeholder fallbacks.
+ *
+ * Request* returns a handle immediately and queues the file for a
+ * background I/O thread, which reads and decodes it (PNG, WAV, .atlas,
+ * .anim).
+ * Only the GPU and audio-device uploads run on the main thread: call
+ * ProcessAssetUploads once per frame with a time budget. Until an asset is
+ * ready, and for good if it fails to load, the getters return a
+ * placeholder: a magenta checker texture, a silent sound or audio clip, an
+ * atlas with no regions that draws from the checker, or an empty frame
+ * table.
+ *
+ * Requests under a mounted archive's root are served from the mapped
+ * archive instead: no file I/O or decoding, just the upload.
+ *
+ * After EnableAssetHotReload, ReloadChangedAssets queues every file that
+ * changed on disk. The new version is read from the loose file, even for
+ * an archived asset, and replaces the old one in its upload; the old
+ * version stays in use until then. Audio clips are not reloaded.
+ *
+ * All functions other than the worker's own are main-thread only. Call
+ * InitAssetLoader after InitWindow (and InitAudioDevice for sounds) and
+ * CloseAssetLoader before closing them.
+ *
+ */
+
+#ifndef CORELIB_ASSETS_H
+#define CORELIB_ASSETS_H
+
+#include "raylib.h"
+#include "corelib/animation.h"
+#include "corelib/archive.h"
+#include "corelib/atlas.h"
+#include "corelib/mixer.h"
+#include <stdbool.h>
+
+#define ASSET_INVALID (-1)
+#define ASSET_MAX_ARCHIVES 8
+
+typedef int AssetHandle;
+
+typedef enum {
+    ASSET_TEXTURE,      /**< An image file uploaded as a Texture2D. */
+    ASSET_SOUND,        /**< A sound file uploaded as a Sound. */
+    ASSET_ATLAS,        /**< An .atlas file uploaded as a TextureAtlas. */
+    ASSET_CLIP,         /**< A sound file converted to an AudioClip for the mixer. */
+    ASSET_ANIMATIONS    /**< An .anim file parsed into an AnimationTable; nothing to upload. */
+} AssetType;
+
+typedef enum {
+    ASSET_QUEUED,       /**< Waiting for the I/O thread. */
+    ASSET_DECODED,      /**< Decoded, waiting for the main-thread upload. */
+    ASSET_READY,        /**< Uploaded and usable. */
+    ASSET_FAILED        /**< Could not be loaded; the placeholder stays. */
+} AssetState;
+
+bool InitAssetLoader(int capacity);
+void CloseAssetLoader(void);
+bool MountAssetArchive(const char* fileName, const char* root);
+
+AssetHandle RequestTexture(const char* fileName);
+AssetHandle RequestSound(const char* fileName);
+AssetHandle RequestTextureAtlas(const char* fileName);
+AssetHandle RequestAudioClip(const char* fileName);
+AssetHandle RequestAnimationTable(const char* fileName);
+int ProcessAssetUploads(double budgetSeconds);
+bool EnableAssetHotReload(void);
+int ReloadChangedAssets(void);
+
+AssetState GetAssetState(AssetHandle handle);
+int GetPendingAssetCount(void);
+Texture2D GetAssetTexture(AssetHandle handle);
+Sound GetAssetSound(AssetHandle handle);
+const TextureAtlas* GetAssetAtlas(AssetHandle handle);
+const AudioClip* GetAssetClip(AssetHandle handle);
+const AnimationTable* GetAssetAnimations(AssetHandle handle);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file atlas.h
+ * @brief Packed texture atlases produced by the atlas_packer build step.
+ *
+ * An .atlas file is a small little-endian header, a region table sorted by
+ * name hash, and the packed PNG, so a whole game's sprites load with one
+ * file read and draw from one texture. Regions are addressed by ID (their
+ * index in the table); look an ID up by name once at load time.
+ *
+ * Layout:
+ *   u32 magic, u16 version, u16 regionCount, u16 width, u16 height, u32 imageSize
+ *   regionCount x { u32 nameHash, u16 x, u16 y, u16 width, u16 height }
+ *   imageSize bytes of PNG data
+ *
+ */
+
+#ifndef CORELIB_ATLAS_H
+#define CORELIB_ATLAS_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ATLAS_MAGIC 0x54414C43u     /**< "CLAT" read as a little-endian u32. */
+#define ATLAS_VERSION 1
+#define ATLAS_HEADER_SIZE 16
+#define ATLAS_REGION_SIZE 12
+
+typedef struct {
+    uint32_t nameHash;      /**< HashAtlasName of the source file's base name. */
+    Rectangle source;       /**< The region in atlas pixels. */
+} AtlasRegion;
+
+typedef struct {
+    Texture2D texture;      /**< The packed texture. */
+    AtlasRegion* regions;   /**< The regions, sorted by nameHash. */
+    int regionCount;        /**< The number of regions. */
+} TextureAtlas;
+
+uint32_t HashAtlasName(const char* name);
+TextureAtlas LoadTextureAtlas(const char* fileName);
+// The CPU half of LoadTextureAtlas: reads the regions and decodes the image
+// without touching the GPU, so it can run on a worker thread.
+bool LoadTextureAtlasImage(const char* fileName, TextureAtlas* atlas, Image* image);
+void UnloadTextureAtlas(TextureAtlas* atlas);
+int FindAtlasRegion(const TextureAtlas* atlas, const char* name);
+int FindAtlasRegionHash(const TextureAtlas* atlas, uint32_t nameHash);
+Rectangle GetAtlasRegionRec(const TextureAtlas* atlas, int regionId);
+
+#endif
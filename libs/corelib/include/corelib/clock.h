@@ -0,0 +1,15 @@
+/**
+ * @file clock.h
+ * @brief High-resolution monotonic clock, usable without a window.
+ *
+ */
+
+#ifndef CORELIB_CLOCK_H
+#define CORELIB_CLOCK_H
+
+#include <stdint.h>
+
+uint64_t GetClockNanos(void);
+double GetClockSeconds(void);
+
+#endif
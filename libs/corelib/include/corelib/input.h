@@ -0,0 +1,124 @@
+/**
+ * @file input.h
+ * @brief Tick-based input streams with deterministic record and replay.
+ *
+ * The game maps device input to action bits once per frame with PushInput,
+ * and the fixed-step simulation pulls one InputBits value per tick with
+ * NextTickInput. Presses are latched until the next tick consumes them, so
+ * none are lost when a frame runs no ticks. In record mode every tick's
+ * bits are appended to a recording; in replay mode live input is ignored
+ * and the recorded bits are returned instead. Together with the RNG seed a
+ * recording reproduces a session exactly, headless or rendered.
+ *
+ * For presses finer than a frame, an InputQueue stamps each press with the
+ * time of the poll that saw it. The queue can be polled between frames (the
+ * frame pacer does so while it sleeps), and PushTimedInput hands a press to
+ * a later tick of the frame, so it lands on the tick that covers the moment
+ * it happened rather than on the frame boundary. The recording still holds
+ * one InputBits value per tick, so replays are unaffected.
+ *
+ * SnapshotInputStream saves and loads a stream's cursor with the rest of a
+ * game's state. Loading it while recording rolls the recording back too,
+ * so it still replays into the state that was loaded.
+ *
+ * A recording can also store how its session ended: the game's score and a
+ * checksum of its state, set with SetInputRecordingOutcome before saving.
+ * CheckInputReplayOutcome compares them, and the tick count, with the game
+ * at the end of a replay, so a build whose simulation diverged (other
+ * floating-point flags, another compiler, a changed rule) is caught instead
+ * of silently replaying a different session.
+ *
+ * File layout (little-endian):
+ *   u32 magic, u16 version, u16 flags (bit 0: the outcome is set),
+ *   f32 tickRate, u64 seed, u32 tickCount, u32 runCount,
+ *   i32 finalScore, u32 stateChecksum, u32 reserved,
+ *   then runCount x { varint bits, varint length }
+ *
+ */
+
+#ifndef CORELIB_INPUT_H
+#define CORELIB_INPUT_H
+
+#include "corelib/snapshot.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define INPUT_RECORDING_MAGIC 0x52494C43u   /**< "CLIR" read as a little-endian u32. */
+#define INPUT_RECORDING_VERSION 2
+#define INPUT_SCHEDULE_TICKS 16         /**< The furthest ahead PushTimedInput can place a press. */
+#define INPUT_QUEUE_CAPACITY 64         /**< The presses an InputQueue holds between drains. */
+#define INPUT_POLL_INTERVAL 0.001       /**< The seconds between polls while the pacer sleeps. */
+
+typedef uint32_t InputBits;
+
+typedef enum {
+    INPUT_MODE_LIVE,        /**< Pass live input through. */
+    INPUT_MODE_RECORD,      /**< Pass live input through and record it. */
+    INPUT_MODE_REPLAY       /**< Ignore live input and play back a recording. */
+} InputMode;
+
+typedef struct {
+    InputBits bits;         /**< The action bits held for the run. */
+    uint32_t length;        /**< The number of consecutive ticks. */
+} InputRun;
+
+typedef struct {
+    uint64_t seed;          /**< The RNG seed the session started from. */
+    float tickRate;         /**< The simulation rate the session ran at. */
+    uint32_t tickCount;     /**< The total number of recorded ticks. */
+    bool hasOutcome;        /**< Whether finalScore and stateChecksum are set. */
+    int32_t finalScore;     /**< The game's score when the session ended. */
+    uint32_t stateChecksum; /**< The game's checksum of its state when the session ended. */
+    InputRun* runs;         /**< Run-length encoded per-tick input. */
+    int runCount;           /**< Valid entries in runs. */
+    int runCapacity;        /**< Allocated entries in runs. */
+} InputRecording;
+
+typedef struct {
+    InputMode mode;             /**< What the stream does with input. */
+    InputBits pending;          /**< Presses latched for the next tick. */
+    InputBits scheduled[INPUT_SCHEDULE_TICKS];  /**< Presses for the ticks after it, a ring from scheduleHead. */
+    int scheduleHead;           /**< The scheduled slot of the tick after the next. */
+    InputRecording recording;   /**< The recording being written or replayed. */
+    int replayRun;              /**< The replay cursor's run. */
+    uint32_t replayOffset;      /**< The replay cursor's tick inside that run. */
+    uint32_t tick;              /**< Ticks pulled from the stream so far. */
+} InputStream;
+
+typedef InputBits (*InputSampler)(void);
+
+typedef struct {
+    InputBits bits;             /**< The actions pressed. */
+    double time;                /**< When the poll that saw them returned, in GetClockSeconds time. */
+} InputEvent;
+
+typedef struct {
+    InputSampler sample;        /**< Maps the device state after a poll to pressed actions. */
+    InputEvent events[INPUT_QUEUE_CAPACITY];    /**< The presses since the last drain, oldest first. */
+    int count;                  /**< Valid entries in events. */
+    int dropped;                /**< Presses lost to a full queue. */
+} InputQueue;
+
+void StartInputRecording(InputStream* stream, uint64_t seed, float tickRate);
+bool StartInputReplay(InputStream* stream, const char* fileName);
+void CloseInputStream(InputStream* stream);
+void PushInput(InputStream* stream, InputBits pressed);
+void PushTimedInput(InputStream* stream, InputBits pressed, int tickOffset);
+InputBits NextTickInput(InputStream* stream);
+bool IsInputReplayFinished(const InputStream* stream);
+bool CheckInputReplayOutcome(const InputStream* stream, int32_t score, uint32_t stateChecksum);
+void SnapshotInputStream(Snapshot* snap, InputStream* stream);
+
+InputQueue CreateInputQueue(InputSampler sample);
+void SampleInputQueue(InputQueue* queue);
+void PollInputQueue(InputQueue* queue);
+int DrainInputQueue(InputQueue* queue, InputEvent* events, int maxEvents);
+
+void AppendInputTick(InputRecording* recording, InputBits bits);
+void TruncateInputRecording(InputRecording* recording, uint32_t tickCount);
+void SetInputRecordingOutcome(InputRecording* recording, int32_t score, uint32_t stateChecksum);
+bool SaveInputRecording(const InputRecording* recording, const char* fileName);
+bool LoadInputRecording(InputRecording* recording, const char* fileName);
+void UnloadInputRecording(InputRecording* recording);
+
+#endif
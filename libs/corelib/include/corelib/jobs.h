@@ -0,0 +1,57 @@
+/**
+ * @file jobs.h
+ * @brief Work-stealing job scheduler with dependency counters.
+ *
+ * InitJobSystem starts one worker thread per extra core. Every thread that
+ * runs jobs, the calling thread included, owns a deque: it pushes and pops
+ * its own jobs at one end while idle threads steal from the other, so a
+ * thread mostly runs the jobs it spawned and only touches another thread's
+ * deque when its own is empty.
+ *
+ * A job counts itself and its unfinished children, and finishes when the
+ * count reaches zero. A job can wait on other jobs with AddJobDependency: it
+ * is held back until they finish, then queued by whichever thread finished
+ * the last one. WaitForJob runs other jobs until its job finishes, so
+ * waiting inside a job never blocks a thread.
+ *
+ *   Job* physics = CreateJob(StepPhysics, world);
+ *   Job* draw = CreateJob(BuildDrawList, world);
+ *   AddJobDependency(draw, physics);
+ *   SubmitJob(draw);
+ *   SubmitJob(physics);
+ *   WaitForJob(draw);
+ *
+ * Jobs come from a per-thread ring of JOB_CAPACITY, so a handle stays valid
+ * until its thread has created JOB_CAPACITY more jobs. Jobs may only be
+ * created by the thread that called InitJobSystem or from inside a job.
+ *
+ */
+
+#ifndef CORELIB_JOBS_H
+#define CORELIB_JOBS_H
+
+#include <stdbool.h>
+
+#define JOB_MAX_THREADS 16          // the calling thread plus the workers
+#define JOB_CAPACITY 1024           // jobs in flight per thread, a power of two
+#define JOB_MAX_CONTINUATIONS 8     // dependent jobs queued by one job's finish
+
+typedef void (*JobFunc)(void* data);
+typedef void (*JobRangeFunc)(int begin, int end, void* data);
+
+typedef struct Job Job;
+
+bool InitJobSystem(int workerCount);
+void CloseJobSystem(void);
+int GetJobThreadCount(void);
+
+Job* CreateJob(JobFunc func, void* data);
+Job* CreateChildJob(Job* parent, JobFunc func, void* data);
+void AddJobDependency(Job* job, Job* dependency);
+void SubmitJob(Job* job);
+bool IsJobFinished(const Job* job);
+void WaitForJob(const Job* job);
+
+void ParallelFor(int count, int grain, JobRangeFunc func, void* data);
+
+#endif
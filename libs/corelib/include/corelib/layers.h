@@ -0,0 +1,41 @@
+/**
+ * @file layers.h
+ * @brief Render layers cached in render textures.
+ *
+ * A cached layer covers a fixed screen rectangle and keeps its last drawing
+ * in a RenderTexture2D. The caller names what the layer shows with a content
+ * key; while the key stays the same the layer is only composited, as a
+ * single quad, instead of being drawn again. Drawing inside a layer uses
+ * screen coordinates.
+ *
+ * Layers are composited with ordinary alpha blending, which is exact for
+ * opaque and one-bit-alpha content like raylib's default font.
+ *
+ */
+
+#ifndef CORELIB_LAYERS_H
+#define CORELIB_LAYERS_H
+
+#include "raylib.h"
+#include "corelib/spritebatch.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    RenderTexture2D target;     /**< The cached drawing. */
+    Rectangle bounds;           /**< The screen area the layer covers. */
+    uint64_t key;               /**< The content key the target holds. */
+    bool valid;                 /**< Whether the target holds a finished drawing. */
+    int redraws;                /**< The times the layer has been drawn, for profiling. */
+} CachedLayer;
+
+CachedLayer LoadCachedLayer(Rectangle bounds);
+void UnloadCachedLayer(CachedLayer* layer);
+void InvalidateCachedLayer(CachedLayer* layer);
+
+bool BeginCachedLayer(CachedLayer* layer, uint64_t key);
+void EndCachedLayer(CachedLayer* layer);
+
+void SubmitCachedLayer(SpriteBatch* batch, const CachedLayer* layer, Color tint, int zLayer);
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file metrics.h
+ * @brief Telemetry counters, gauges and histograms with a background exporter.
+ *
+ * Each thread records into its own block of counters, so the hot path takes
+ * no lock and does no atomic read-modify-write: only the owning thread
+ * writes a value, and the exporter thread reads it. Nothing is recorded
+ * until InitMetrics, so runs without a target pay one relaxed load and a
+ * branch per call. Gauges count changes since metrics started; start them
+ * before creating what they count.
+ *
+ * corelib records the built-in metrics below itself: frame times and missed
+ * frames in the frame pacer, draw calls in the sprite batch and particle
+ * renderer, heap-owning containers and arena bytes in their Create and
+ * Destroy functions, live objects in object pools, and asset load times
+ * from request to upload. Games add their own with RegisterMetric.
+ *
+ * Every interval the exporter totals the threads and writes what changed,
+ * in packets of at most METRICS_PACKET_SIZE bytes, to a file (appended to)
+ * or to "udp:host:port" (POSIX only). Counters are sent as the increase
+ * since the last flush. Histograms are sent as the count, percentiles and
+ * maximum of the samples since the last flush.
+ *
+ * StatsD, one line per value, names prefixed with the InitMetrics prefix:
+ *
+ *   prefix.corelib.draw_calls:812|c
+ *   prefix.corelib.pool.objects:37|g
+ *   prefix.corelib.frame.time_us.count:120|c
+ *   prefix.corelib.frame.time_us.p50:8320|g      (also .p99 and .max)
+ *
+ * Binary, little-endian, one record per packet:
+ *
+ *   offset size  field
+ *   0      4     magic "CLMT"
+ *   4      2     format version (METRICS_BINARY_VERSION)
+ *   6      2     number of metrics that follow
+ *   8      4     flush sequence number, from 0
+ *   12     8     wall-clock time of the flush in milliseconds since 1970
+ *   20     ...   metrics: kind (1), name length (1), name (no NUL), then
+ *                  counter   increase (8, signed)
+ *                  gauge     value (8, signed)
+ *                  histogram count (8), sum (8), max (8), bucket count (2),
+ *                            then per non-empty bucket its index (1) and
+ *                            its count (4); see GetMetricBucketLow
+ *
+ */
+
+#ifndef CORELIB_METRICS_H
+#define CORELIB_METRICS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define METRICS_MAX 64                  /**< The most metrics, built-in ones included. */
+#define METRICS_MAX_HISTOGRAMS 16       /**< The most histogram metrics. */
+#define METRICS_MAX_THREADS 64          /**< The most threads recording at once. */
+#define METRIC_NAME_LENGTH 48           /**< The longest metric name, with its NUL. */
+#define METRIC_HISTOGRAM_BUCKETS 96     /**< Four buckets per power of two, from 0 to about 2^25. */
+#define METRICS_PACKET_SIZE 1432        /**< The largest packet written, which fits one UDP datagram. */
+#define METRICS_BINARY_VERSION 1
+
+typedef enum {
+    METRIC_COUNTER,     /**< A running total, exported as its increase. */
+    METRIC_GAUGE,       /**< A level that rises and falls, exported as its value. */
+    METRIC_HISTOGRAM    /**< A distribution of samples, exported as a summary. */
+} MetricKind;
+
+typedef enum {
+    METRICS_FORMAT_STATSD,  /**< StatsD text lines. */
+    METRICS_FORMAT_BINARY   /**< The binary records described above. */
+} MetricsFormat;
+
+// The built-in metrics' ids. RegisterMetric hands out ids after these.
+enum {
+    METRIC_FRAME_TIME,          /**< Histogram: microseconds between presents, idle waits excluded. */
+    METRIC_FRAMES_MISSED,       /**< Counter: presents a whole period late. */
+    METRIC_DRAW_CALLS,          /**< Counter: draw runs issued by sprite batches and particle systems. */
+    METRIC_HEAP_OBJECTS,        /**< Gauge: live containers that own heap memory. */
+    METRIC_ARENA_BYTES,         /**< Gauge: bytes held by live arenas. */
+    METRIC_POOL_OBJECTS,        /**< Gauge: live objects in all object pools. */
+    METRIC_ASSET_LOAD_TIME,     /**< Histogram: microseconds from an asset's request to its upload. */
+    METRIC_ASSET_FAILURES,      /**< Counter: assets that failed to load. */
+    METRIC_BUILTIN_COUNT
+};
+
+bool InitMetrics(const char* target, MetricsFormat format, const char* prefix, double interval);
+void CloseMetrics(void);
+bool IsMetricsEnabled(void);
+int RegisterMetric(const char* name, MetricKind kind);
+
+int GetMetricBucket(uint64_t value);
+uint64_t GetMetricBucketLow(int bucket);
+
+// The recording calls test the switch inline, so that with metrics off an
+// instrumented loop pays a load and a branch rather than a call.
+extern atomic_bool metricsRecording_;
+void AddMetricValue_(int id, int64_t delta);
+void RecordMetricValue_(int id, uint64_t value);
+
+static inline void AddMetricCount(int id, int64_t count) {
+    if (atomic_load_explicit(&metricsRecording_, memory_order_relaxed)) AddMetricValue_(id, count);
+}
+
+static inline void AddMetricGauge(int id, int64_t delta) {
+    if (atomic_load_explicit(&metricsRecording_, memory_order_relaxed)) AddMetricValue_(id, delta);
+}
+
+static inline void RecordMetricSample(int id, uint64_t value) {
+    if (atomic_load_explicit(&metricsRecording_, memory_order_relaxed)) RecordMetricValue_(id, value);
+}
+
+#endif
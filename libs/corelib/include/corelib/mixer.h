@@ -0,0 +1,65 @@
+/**
+ * @file mixer.h
+ * @brief Software mixer with a fixed voice pool and a lock-free command queue.
+ *
+ * The mixer renders every sound effect into a single raylib audio stream
+ * from its callback on the audio thread. The game thread never touches the
+ * voices: PlayAudioClip and friends push a command into a single-producer,
+ * single-consumer ring that the callback drains before mixing, so they take
+ * no lock and allocate nothing.
+ *
+ * The voice pool is allocated once by InitAudioMixer. A play request that
+ * would exceed its clip's instance limit restarts the clip's oldest voice;
+ * when every voice is busy it steals the oldest voice of the lowest
+ * priority, if that is no higher than its own, and is dropped otherwise.
+ *
+ * Clips hold interleaved stereo float samples at MIXER_SAMPLE_RATE and must
+ * stay loaded while the mixer runs. All functions are main-thread only.
+ *
+ */
+
+#ifndef CORELIB_MIXER_H
+#define CORELIB_MIXER_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define MIXER_SAMPLE_RATE 48000
+#define MIXER_CHANNELS 2
+#define MIXER_BUFFER_FRAMES 512     // about 10 ms of latency per stream buffer
+#define MIXER_QUEUE_CAPACITY 256    // a power of two
+
+typedef struct {
+    float* samples;             /**< Interleaved stereo frames at MIXER_SAMPLE_RATE. */
+    unsigned int frameCount;    /**< The number of frames. */
+} AudioClip;
+
+typedef struct {
+    int priority;               /**< Higher priorities may steal voices from lower ones. */
+    int maxInstances;           /**< The most voices the clip may use at once, or 0 for no limit. */
+    float volume;               /**< The gain, from 0 to 1. */
+    float pan;                  /**< The balance, from -1 (left) to 1 (right). */
+} ClipPlayback;
+
+typedef struct {
+    int voices;                 /**< The size of the voice pool. */
+    int activeVoices;           /**< Voices playing after the last mix. */
+    int stolen;                 /**< Voices taken from other clips. */
+    int restarted;              /**< Voices restarted by their clip's instance limit. */
+    int rejected;               /**< Requests dropped because no voice could be taken. */
+    int queueFull;              /**< Commands dropped because the queue was full. */
+} MixerStats;
+
+bool InitAudioMixer(int voiceCount);
+void CloseAudioMixer(void);
+
+AudioClip LoadAudioClipFromWave(Wave wave);
+void UnloadAudioClip(AudioClip* clip);
+
+bool PlayAudioClip(const AudioClip* clip, ClipPlayback playback);
+bool StopAudioClip(const AudioClip* clip);
+bool StopAllAudioVoices(void);
+bool SetAudioMixerVolume(float volume);
+MixerStats GetAudioMixerStats(void);
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @file obstacles.h
+ * @brief Structure-of-arrays store for scrolling gap obstacles.
+ *
+ * Each obstacle is a solid column with an open gap, like a pair of pipes.
+ * Positions live in parallel float arrays so scrolling, recycling, scoring
+ * and collision run as SIMD kernels (SSE2 or NEON, with a scalar fallback)
+ * over the whole batch instead of one obstacle at a time. The arrays are
+ * padded to whole SIMD lanes, so a count that is not a multiple of four
+ * still runs fully vectorized.
+ *
+ */
+
+#ifndef CORELIB_OBSTACLES_H
+#define CORELIB_OBSTACLES_H
+
+#include "raylib.h"
+#include "corelib/arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    float* x;           /**< Left edges. */
+    float* prevX;       /**< Left edges before the last scroll, for interpolation. */
+    float* gapY;        /**< Tops of the gaps. */
+    float* width;       /**< Column widths. */
+    uint32_t* scored;   /**< Bitset of obstacles the player has already passed. */
+    int count;          /**< Live obstacles, packed at the front of the arrays. */
+    int capacity;       /**< The most obstacles the store can hold. */
+    float gap;          /**< The gap height shared by every obstacle. */
+    float height;       /**< The column height; the bottom part spans gapY + gap to here. */
+    bool ownsMemory;    /**< Whether the arrays came from the heap rather than an arena. */
+} ObstacleField;
+
+ObstacleField CreateObstacleField(Arena* arena, int capacity, float gap, float height);
+void DestroyObstacleField(ObstacleField* field);
+void ClearObstacles(ObstacleField* field);
+int AddObstacle(ObstacleField* field, float x, float gapY, float width);
+void ResetObstacle(ObstacleField* field, int index, float x, float gapY);
+void RemoveObstacle(ObstacleField* field, int index);
+bool IsObstacleScored(const ObstacleField* field, int index);
+Rectangle GetObstacleTopRec(const ObstacleField* field, int index);
+Rectangle GetObstacleBottomRec(const ObstacleField* field, int index);
+
+// Batch kernels
+void ScrollObstacles(ObstacleField* field, float dx);
+int CollectOffscreenObstacles(const ObstacleField* field, float minX, int* indices, int maxIndices);
+int ScoreObstacles(ObstacleField* field, float passX);
+int CollideObstaclesRec(const ObstacleField* field, Rectangle rec);
+int CollideObstaclesCircle(const ObstacleField* field, Vector2 center, float radius);
+int CollideObstaclesCircles(const ObstacleField* field, const float* cx, const float* cy, int count, float radius,
+                            uint32_t* hits);
+
+#endif
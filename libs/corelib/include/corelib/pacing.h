@@ -0,0 +1,67 @@
+/**
+ * @file pacing.h
+ * @brief Frame pacing to the display, evented idle waits and input latency.
+ *
+ * The pacer replaces SetTargetFPS. It reads the monitor's refresh rate and
+ * spaces presents evenly:
+ *
+ *   PACING_VSYNC  presents on vblank (FLAG_VSYNC_HINT) at the refresh rate
+ *                 or a whole divisor of it, so no frame is shown twice as
+ *                 long as its neighbours.
+ *   PACING_VRR    presents as soon as a frame is due, at any rate up to
+ *                 the refresh rate, for variable refresh displays.
+ *
+ * Call EndFramePacing right after every present. On a frame that is not
+ * drawn, call WaitForFrameEvents instead: with blocking allowed it sleeps
+ * in the window system until an input event arrives, so an idle screen
+ * costs no CPU or GPU time at all.
+ *
+ * With an InputQueue attached, the pacer samples it after every present
+ * and sleeps in INPUT_POLL_INTERVAL slices, polling between them, so a
+ * press is stamped within a millisecond of the poll that could first see
+ * it instead of at the next frame boundary.
+ *
+ * Latency is measured from a press to the present that first shows its
+ * response: MarkFrameInput takes the press's timestamp, and EndFramePacing
+ * records the latency when told the frame it presented responds to input.
+ *
+ * SetFramePacerHints goes before InitWindow, CreateFramePacer after it.
+ *
+ */
+
+#ifndef CORELIB_PACING_H
+#define CORELIB_PACING_H
+
+#include "corelib/input.h"
+#include "corelib/stats.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    PACING_VSYNC,       /**< Present on vblank at the refresh rate or a divisor of it. */
+    PACING_VRR          /**< Present whenever a frame is due, for variable refresh displays. */
+} PacingMode;
+
+typedef struct {
+    PacingMode mode;        /**< How presents are spaced. */
+    double refreshRate;     /**< The display's refresh rate in Hz. */
+    double period;          /**< The seconds between presents, or 0 for uncapped. */
+    double deadline;        /**< When the next present is due. */
+    InputQueue* input;      /**< The queue sampled after presents and polled during waits, or NULL. */
+    double inputTime;       /**< When the press being measured happened, or 0 for none. */
+    double lastLatencyMs;   /**< The latest latency recorded. */
+    SampleSet latencyMs;    /**< Input-to-present latencies in milliseconds. */
+    double lastPresent;     /**< When the last frame was presented, or 0 after an idle wait. */
+    int presents;           /**< Frames presented. */
+    int missed;             /**< Presents later than a whole period past their deadline. */
+    int idleWaits;          /**< Skipped frames that blocked for input. */
+} FramePacer;
+
+void SetFramePacerHints(PacingMode mode);
+FramePacer CreateFramePacer(PacingMode mode, double maxRate);
+void DestroyFramePacer(FramePacer* pacer);
+void MarkFrameInput(FramePacer* pacer, double time);
+bool EndFramePacing(FramePacer* pacer, bool respondsToInput);
+void WaitForFrameEvents(FramePacer* pacer, bool block, double pollRate);
+
+#endif
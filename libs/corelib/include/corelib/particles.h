@@ -0,0 +1,70 @@
+/**
+ * @file particles.h
+ * @brief Structure-of-arrays particle systems with SIMD integration.
+ *
+ * Each particle's state lives in parallel float arrays, padded to whole
+ * SIMD lanes, so UpdateParticles integrates four particles per instruction
+ * (SSE2 or NEON, with a scalar fallback) and retires the dead by swapping
+ * the last live particle into their slot. Ages are kept normalized, 0 at
+ * birth and 1 at death, so size and color need no per-particle lifetime.
+ *
+ * A system draws from one texture, so DrawParticles hands the whole system
+ * to rlgl as a single run of quads: rlgl only splits it where its vertex
+ * buffer fills up. Give every kind of particle its own system, with its
+ * own gravity, drag and texture.
+ *
+ */
+
+#ifndef CORELIB_PARTICLES_H
+#define CORELIB_PARTICLES_H
+
+#include "raylib.h"
+#include "corelib/arena.h"
+#include "corelib/random.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    float speedMin;         /**< The slowest launch speed in pixels per second. */
+    float speedMax;         /**< The fastest launch speed in pixels per second. */
+    float direction;        /**< The launch direction in radians; 0 is +x, PI/2 is +y (down). */
+    float spread;           /**< The half-angle of the launch cone in radians; PI for all around. */
+    float lifeMin;          /**< The shortest lifetime in seconds. */
+    float lifeMax;          /**< The longest lifetime in seconds. */
+    float sizeStart;        /**< The size at birth in pixels. */
+    float sizeEnd;          /**< The size at death in pixels. */
+    Color colorStart;       /**< The color at birth. */
+    Color colorEnd;         /**< The color at death. */
+} ParticleBurst;
+
+typedef struct {
+    float* x;               /**< Horizontal positions. */
+    float* y;               /**< Vertical positions. */
+    float* vx;              /**< Horizontal velocities. */
+    float* vy;              /**< Vertical velocities. */
+    float* age;             /**< Normalized ages, from 0 at birth to 1 at death. */
+    float* ageRate;         /**< Age gained per second: one over the lifetime. */
+    float* size;            /**< Sizes at birth. */
+    float* sizeDelta;       /**< The size change over a whole life. */
+    uint32_t* colorStart;   /**< Colors at birth, packed RGBA. */
+    uint32_t* colorEnd;     /**< Colors at death, packed RGBA. */
+    int count;              /**< Live particles, packed at the front of the arrays. */
+    int capacity;           /**< The most particles the system can hold. */
+    float gravity;          /**< The downward acceleration in pixels per second squared. */
+    float drag;             /**< The fraction of velocity lost per second, roughly. */
+    Texture2D texture;      /**< The texture to draw from, or id 0 for plain quads. */
+    Rectangle source;       /**< The source rectangle in texture. */
+    int dropped;            /**< Particles not emitted because the system was full. */
+    bool ownsMemory;        /**< Whether the arrays came from the heap rather than an arena. */
+} ParticleSystem;
+
+ParticleSystem CreateParticleSystem(Arena* arena, int capacity, float gravity, float drag);
+void DestroyParticleSystem(ParticleSystem* system);
+void ClearParticles(ParticleSystem* system);
+void SetParticleTexture(ParticleSystem* system, Texture2D texture, Rectangle source);
+int EmitParticles(ParticleSystem* system, const ParticleBurst* burst, Vector2 position, Vector2 velocity,
+                  int count, Rng* rng);
+void UpdateParticles(ParticleSystem* system, float dt);
+void DrawParticles(const ParticleSystem* system);
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file plugin.h
+ * @brief The entry-point ABI between a host process and games built as loadable modules.
+ *
+ * With SHARED=1 raylib and corelib are shared libraries and each game is
+ * also built as a module that exports one function, GetGamePlugin. A host
+ * loads modules with LoadGameModule and calls run on the plugin it gets
+ * back, which plays the game and returns when the player leaves. Every
+ * module links the same raylib and corelib, so the window, GL context and
+ * audio device the host opened stay open from one game to the next; a game
+ * only opens them if they are not open yet, and only closes what it opened.
+ *
+ * A hosted game leaves on Escape. Hosts call SetExitKey(KEY_NULL), so that
+ * Escape does not also close the window and the host with it.
+ *
+ * GAME_PLUGIN_ABI_VERSION changes whenever GamePlugin or the contract above
+ * does, and LoadGameModule rejects modules built against another version.
+ *
+ */
+
+#ifndef CORELIB_PLUGIN_H
+#define CORELIB_PLUGIN_H
+
+#include <stdint.h>
+
+#define GAME_PLUGIN_ABI_VERSION 1
+#define GAME_PLUGIN_ENTRY "GetGamePlugin"  /**< The symbol every game module exports. */
+
+#if defined(_WIN32)
+#define GAME_PLUGIN_EXPORT __declspec(dllexport)
+#define GAME_MODULE_EXTENSION ".dll"
+#elif defined(__APPLE__)
+#define GAME_PLUGIN_EXPORT __attribute__((visibility("default")))
+#define GAME_MODULE_EXTENSION ".dylib"
+#else
+#define GAME_PLUGIN_EXPORT __attribute__((visibility("default")))
+#define GAME_MODULE_EXTENSION ".so"
+#endif
+
+typedef struct {
+    uint32_t abiVersion;                /**< GAME_PLUGIN_ABI_VERSION when the game was built. */
+    const char* name;                   /**< The game's display name. */
+    int (*run)(int argc, char** argv);  /**< Plays the game until the player leaves; returns its exit code. */
+} GamePlugin;
+
+typedef const GamePlugin* (*GamePluginEntry)(void);
+
+typedef struct {
+    void* handle;                       /**< The loaded module. */
+    const GamePlugin* plugin;           /**< The module's plugin, or NULL if it did not load. */
+} GameModule;
+
+GameModule LoadGameModule(const char* fileName);
+void UnloadGameModule(GameModule* module);
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file pool.h
+ * @brief Fixed-capacity object pool with generation-checked handles.
+ *
+ * Live objects stay packed at the front of the pool, so iterating them is a
+ * plain loop over dense indices. Releasing an object moves the last live one
+ * into its place, which keeps the pool dense and lets callers mirror the
+ * same move on parallel structure-of-arrays data. Handles stay valid across
+ * those moves and go stale once their object is released, so a kept handle
+ * can never reach the object that later reuses its slot.
+ *
+ * The item size may be zero, in which case the pool only hands out handles
+ * and dense indices for data the caller stores elsewhere.
+ *
+ */
+
+#ifndef CORELIB_POOL_H
+#define CORELIB_POOL_H
+
+#include "corelib/arena.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t PoolHandle;
+
+#define POOL_INVALID 0u
+#define POOL_INDEX_BITS 16
+#define POOL_MAX_CAPACITY (1 << POOL_INDEX_BITS)
+
+typedef struct {
+    unsigned char* items;   /**< The live objects, packed at the front. */
+    size_t itemSize;        /**< The size of one object in bytes, or 0 for handles only. */
+    PoolHandle* handles;    /**< The handle of each dense index. */
+    int* slots;             /**< The dense index of each live slot, or the next free slot. */
+    uint16_t* generations;  /**< The generation each slot hands out next. */
+    int freeSlot;           /**< The first free slot, or -1 when the pool is full. */
+    int count;              /**< The number of live objects. */
+    int capacity;           /**< The most objects the pool can hold. */
+    bool ownsMemory;        /**< Whether the arrays came from the heap rather than an arena. */
+} ObjectPool;
+
+ObjectPool CreateObjectPool(Arena* arena, int capacity, size_t itemSize);
+void DestroyObjectPool(ObjectPool* pool);
+void ClearObjectPool(ObjectPool* pool);
+
+PoolHandle AcquirePoolObject(ObjectPool* pool);
+int ReleasePoolObject(ObjectPool* pool, PoolHandle handle);
+
+bool IsPoolHandleValid(const ObjectPool* pool, PoolHandle handle);
+int GetPoolIndex(const ObjectPool* pool, PoolHandle handle);
+PoolHandle GetPoolHandle(const ObjectPool* pool, int index);
+void* GetPoolObject(ObjectPool* pool, PoolHandle handle);
+void* GetPoolObjectAt(ObjectPool* pool, int index);
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ * @file profiler.h
+ * @brief Scoped-zone frame profiler with an on-screen overlay.
+ *
+ * Zones are recorded into a per-thread ring buffer with the monotonic clock.
+ * The overlay totals the zones every thread closed during the frame, so a
+ * zone run by several job workers adds up their time.
+ * The instrumentation macros compile to nothing unless CORELIB_PROFILE is
+ * defined (make MODE=profile), so instrumented code costs nothing in normal
+ * builds. Zone names must be string literals or otherwise outlive the
+ * profiler.
+ *
+ *   PROFILE_FRAME();                     // once per frame, on the main thread
+ *   PROFILE_ZONE_BEGIN("Update"); ...; PROFILE_ZONE_END();
+ *   { PROFILE_SCOPE("Physics"); ... }    // ends at the closing brace
+ *
+ */
+
+#ifndef CORELIB_PROFILER_H
+#define CORELIB_PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PROFILER_RING_SIZE 16384    /**< Zone events kept per thread. */
+#define PROFILER_MAX_DEPTH 32       /**< The deepest zone nesting per thread. */
+#define PROFILER_MAX_ZONES 32       /**< Distinct zone names shown in the overlay. */
+#define PROFILER_HISTORY 240        /**< Frame times kept for the histogram. */
+
+typedef struct {
+    const char* name;       /**< The zone name. */
+    uint64_t start;         /**< The start time in nanoseconds. */
+    uint64_t end;           /**< The end time in nanoseconds. */
+    int depth;              /**< The nesting depth. */
+} ProfilerEvent;
+
+typedef struct {
+    const char* name;       /**< The zone name. */
+    float ms;               /**< Time spent in the zone during the last frame. */
+    float avgMs;            /**< Exponential moving average of ms. */
+    int calls;              /**< Times the zone was entered during the last frame. */
+} ProfilerZoneStats;
+
+typedef struct {
+    ProfilerZoneStats zones[PROFILER_MAX_ZONES];    /**< Per-zone stats summed over all threads. */
+    int zoneCount;                                  /**< Valid entries in zones. */
+    float frameMs[PROFILER_HISTORY];                /**< Recent frame times, oldest overwritten first. */
+    int frameCount;                                 /**< Frames recorded in total. */
+    float p50Ms;                                    /**< The median of the recent frame times. */
+    float p99Ms;                                    /**< The 99th percentile of the recent frame times. */
+    float maxMs;                                    /**< The worst recent frame time. */
+} ProfilerStats;
+
+void ProfilerBeginZone(const char* name);
+void ProfilerEndZone(void);
+void ProfilerFrameMark(void);
+const ProfilerStats* GetProfilerStats(void);
+void DrawProfilerOverlay(int x, int y);
+bool WriteProfilerChromeTrace(const char* fileName);
+
+#if defined(CORELIB_PROFILE)
+static inline void ProfilerScopeEnd_(const char** unused) { (void)unused; ProfilerEndZone(); }
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE_BEGIN(name) ProfilerBeginZone(name)
+#define PROFILE_ZONE_END() ProfilerEndZone()
+#define PROFILE_SCOPE(name) \
+    const char* PROFILE_CONCAT(profileScope_, __LINE__) __attribute__((cleanup(ProfilerScopeEnd_), unused)) = \
+        (ProfilerBeginZone(name), (name))
+#define PROFILE_FRAME() ProfilerFrameMark()
+#else
+#define PROFILE_ZONE_BEGIN(name) ((void)0)
+#define PROFILE_ZONE_END() ((void)0)
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,25 @@
+/**
+ * @file random.h
+ * @brief Small, seedable per-instance random number generator.
+ *
+ * Unlike raylib's GetRandomValue, each Rng owns its state, so independent
+ * simulations can run on separate threads and reproduce exactly from a seed.
+ *
+ */
+
+#ifndef CORELIB_RANDOM_H
+#define CORELIB_RANDOM_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t state;     /**< The generator state (never zero once seeded). */
+} Rng;
+
+Rng CreateRng(uint64_t seed);
+uint32_t NextRandom(Rng* rng);
+int RandomRange(Rng* rng, int min, int max);
+float RandomFloat(Rng* rng);
+float RandomNormal(Rng* rng);
+
+#endif
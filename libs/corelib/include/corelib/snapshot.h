@@ -0,0 +1,56 @@
+/**
+ * @file snapshot.h
+ * @brief Flat, versioned snapshots of simulation state for checkpoints and rollback.
+ *
+ * A snapshot is one buffer: a small header, then the state's bytes in the
+ * order they were written. The same function walks the state both ways:
+ * between BeginSnapshotSave and EndSnapshot, SnapshotBytes copies each
+ * field into the buffer, and between BeginSnapshotLoad and EndSnapshot it
+ * copies them back. Save and load therefore cannot drift apart field by
+ * field. Only the version has to change when the layout does.
+ *
+ * SnapshotArena copies an arena's used bytes, so state that lives in an
+ * arena comes back with one memcpy, pointers into it included. Pointers
+ * are only valid in the process that took the snapshot, so snapshots are
+ * made for in-process checkpoints, rollback and replay seeking, not files.
+ * Loading checks the header, size and checksum before any state is
+ * touched, so a stale or damaged snapshot is rejected whole.
+ *
+ * Layout: u32 magic, u32 version, u32 size including the header, u32 checksum of the rest
+ *
+ */
+
+#ifndef CORELIB_SNAPSHOT_H
+#define CORELIB_SNAPSHOT_H
+
+#include "corelib/arena.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SNAPSHOT_MAGIC 0x50414E53u      /**< "SNAP" read as a little-endian u32. */
+#define SNAPSHOT_HEADER_SIZE 16
+
+/** Saves or loads one lvalue, whichever the snapshot is doing. */
+#define SNAPSHOT_VALUE(snap, value) SnapshotBytes((snap), &(value), sizeof(value))
+
+typedef struct {
+    unsigned char* data;    /**< The buffer. */
+    size_t capacity;        /**< The buffer size in bytes. */
+    size_t size;            /**< The bytes of the last snapshot saved, 0 for none. */
+    size_t cursor;          /**< The save or load position. */
+    bool loading;           /**< Whether SnapshotBytes copies out of the buffer rather than into it. */
+    bool failed;            /**< Whether a save overflowed or a load ran past the end. */
+    bool ownsMemory;        /**< Whether data came from the heap rather than an arena. */
+} Snapshot;
+
+Snapshot CreateSnapshot(Arena* arena, size_t capacity);
+void DestroySnapshot(Snapshot* snap);
+void BeginSnapshotSave(Snapshot* snap, uint32_t version);
+bool BeginSnapshotLoad(Snapshot* snap, uint32_t version);
+bool EndSnapshot(Snapshot* snap);
+void SnapshotBytes(Snapshot* snap, void* data, size_t size);
+void SnapshotArena(Snapshot* snap, Arena* arena);
+uint32_t GetSnapshotChecksum(const Snapshot* snap);
+
+#endif
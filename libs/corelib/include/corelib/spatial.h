@@ -0,0 +1,66 @@
+/**
+ * @file spatial.h
+ * @brief Uniform-grid spatial hash broadphase.
+ *
+ * Entries are caller-numbered axis-aligned boxes. Each box is linked into
+ * every grid cell it touches, and cells hash into a fixed bucket table, so
+ * the world needs no bounds. Moving an entry only relinks it when it
+ * crosses a cell boundary, which makes per-frame updates of slowly
+ * scrolling obstacles cheap. Queries visit only the cells they cover and
+ * report each overlapping entry once; the circle query also runs the exact
+ * circle-vs-rectangle narrowphase.
+ *
+ */
+
+#ifndef CORELIB_SPATIAL_H
+#define CORELIB_SPATIAL_H
+
+#include "raylib.h"
+#include "corelib/arena.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    int entry;          /**< The entry this link belongs to. */
+    int bucket;         /**< The bucket the link is in. */
+    int prev;           /**< The previous link in the bucket, or -1. */
+    int next;           /**< The next link in the bucket (or free list), or -1. */
+    int nextOfEntry;    /**< The entry's next link, or -1. */
+} SpatialLink;
+
+typedef struct {
+    Rectangle bounds;   /**< The entry's box. */
+    int minX;           /**< The first grid column the box touches. */
+    int minY;           /**< The first grid row the box touches. */
+    int maxX;           /**< The last grid column the box touches. */
+    int maxY;           /**< The last grid row the box touches. */
+    int firstLink;      /**< The entry's first link, or -1. */
+    uint32_t stamp;     /**< The last query that reported the entry. */
+    bool active;        /**< Whether the entry is in the hash. */
+} SpatialEntry;
+
+typedef struct {
+    float cellSize;         /**< The grid cell edge in world units. */
+    float invCellSize;      /**< 1 / cellSize. */
+    int* buckets;           /**< The first link in each bucket, or -1. */
+    int bucketMask;         /**< The bucket count minus one (a power of two). */
+    SpatialEntry* entries;  /**< The entries, indexed by caller ID. */
+    int entryCapacity;      /**< The number of entry IDs. */
+    SpatialLink* links;     /**< The link pool. */
+    int linkCapacity;       /**< The number of links in the pool. */
+    int freeLink;           /**< The first free link, or -1. */
+    uint32_t queryStamp;    /**< Bumped on every query to report entries once. */
+    bool ownsMemory;        /**< Whether the arrays came from the heap rather than an arena. */
+} SpatialHash;
+
+SpatialHash CreateSpatialHash(Arena* arena, int maxEntries, int maxLinks, float cellSize);
+void DestroySpatialHash(SpatialHash* hash);
+void ClearSpatialHash(SpatialHash* hash);
+
+bool SetSpatialEntry(SpatialHash* hash, int id, Rectangle bounds);
+void RemoveSpatialEntry(SpatialHash* hash, int id);
+
+int QuerySpatialRec(SpatialHash* hash, Rectangle area, int* ids, int maxIds);
+int QuerySpatialCircle(SpatialHash* hash, Vector2 center, float radius, int* ids, int maxIds);
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * @file spritebatch.h
+ * @brief Sorted sprite batching on top of rlgl.
+ *
+ * Sprites submitted between BeginSpriteBatch and FlushSpriteBatch are sorted
+ * by layer and then texture, expanded into a single vertex buffer and handed
+ * to rlgl in one run per texture, so sprites that share a texture cost one
+ * draw call no matter how they were interleaved at submit time. Submission
+ * order is kept within a layer/texture run.
+ *
+ */
+
+#ifndef CORELIB_SPRITEBATCH_H
+#define CORELIB_SPRITEBATCH_H
+
+#include "raylib.h"
+#include <stdint.h>
+
+typedef struct {
+    unsigned int textureId;     /**< The GPU texture to sample. */
+    int textureWidth;           /**< The texture width, for UV normalization. */
+    int textureHeight;          /**< The texture height, for UV normalization. */
+    Rectangle source;           /**< The source rectangle; negative size flips. */
+    Rectangle dest;             /**< The destination rectangle in screen space. */
+    Vector2 origin;             /**< The rotation origin, relative to dest. */
+    float rotation;             /**< The rotation in degrees. */
+    Color tint;                 /**< The vertex color. */
+} SpriteQuad;
+
+typedef struct {
+    float x, y;                 /**< The position. */
+    float u, v;                 /**< The texture coordinates. */
+    Color color;                /**< The vertex color. */
+} SpriteVertex;
+
+typedef struct {
+    int sprites;                /**< Sprites submitted since BeginSpriteBatch. */
+    int drawCalls;              /**< Texture runs handed to rlgl, plus forced rlgl flushes. */
+    int textureSwitches;        /**< Changes of texture between consecutive runs. */
+    int flushes;                /**< Flushes, including early ones when the batch filled up. */
+} SpriteBatchStats;
+
+typedef struct {
+    SpriteQuad* quads;          /**< Submitted sprites, in submit order. */
+    uint64_t* keys;             /**< Sort keys: layer, texture, submit order. */
+    SpriteVertex* vertices;     /**< The expanded vertex buffer, four per sprite. */
+    int count;                  /**< Sprites waiting to be flushed. */
+    int capacity;               /**< The most sprites held before an early flush. */
+    SpriteBatchStats stats;     /**< Counters for the current frame. */
+} SpriteBatch;
+
+SpriteBatch CreateSpriteBatch(int capacity);
+void DestroySpriteBatch(SpriteBatch* batch);
+void BeginSpriteBatch(SpriteBatch* batch);
+void SubmitSprite(SpriteBatch* batch, Texture2D texture, Rectangle source, Rectangle dest, Color tint, int layer);
+void SubmitSpritePro(SpriteBatch* batch, Texture2D texture, Rectangle source, Rectangle dest,
+                     Vector2 origin, float rotation, Color tint, int layer);
+void FlushSpriteBatch(SpriteBatch* batch);
+SpriteBatchStats GetSpriteBatchStats(const SpriteBatch* batch);
+
+#endif
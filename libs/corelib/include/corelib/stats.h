@@ -0,0 +1,55 @@
+/**
+ * @file stats.h
+ * @brief Sample collection and percentile summaries for benchmarks.
+ *
+ * Benchmarks report a BenchmarkResult per measurement and save them as
+ * JSON, one object per result, so runs can be diffed by tools and by the
+ * bench_compare gate. Every unit is a cost: lower is better.
+ *
+ *   { "results": [
+ *     { "name": "corelib/UpdateAnimation", "unit": "ns", "count": 200, "mean": 1.9,
+ *       "min": 1.8, "p50": 1.9, "p90": 2.0, "p99": 2.4, "max": 3.1 }
+ *   ] }
+ *
+ */
+
+#ifndef CORELIB_STATS_H
+#define CORELIB_STATS_H
+
+#include <stdbool.h>
+
+#define BENCHMARK_NAME_LENGTH 64
+#define BENCHMARK_UNIT_LENGTH 8
+
+typedef struct {
+    double* values;     /**< The samples, in insertion order until summarized. */
+    int count;          /**< Valid entries in values. */
+    int capacity;       /**< Allocated entries in values. */
+} SampleSet;
+
+typedef struct {
+    int count;          /**< The number of samples. */
+    double mean;        /**< The arithmetic mean. */
+    double min;         /**< The smallest sample. */
+    double p50;         /**< The median. */
+    double p90;         /**< The 90th percentile. */
+    double p99;         /**< The 99th percentile. */
+    double max;         /**< The largest sample. */
+} SampleSummary;
+
+typedef struct {
+    char name[BENCHMARK_NAME_LENGTH];   /**< What was measured, as "area/benchmark". */
+    char unit[BENCHMARK_UNIT_LENGTH];   /**< The unit of the samples, e.g. "ns" per operation. */
+    SampleSummary summary;              /**< The distribution of the samples. */
+} BenchmarkResult;
+
+void AddSample(SampleSet* set, double value);
+SampleSummary SummarizeSamples(SampleSet* set);
+void ClearSamples(SampleSet* set);
+void DestroySampleSet(SampleSet* set);
+
+BenchmarkResult CreateBenchmarkResult(const char* name, const char* unit, SampleSet* set);
+bool SaveBenchmarkResults(const char* fileName, const BenchmarkResult* results, int count);
+int LoadBenchmarkResults(const char* fileName, BenchmarkResult* results, int maxResults);
+
+#endif
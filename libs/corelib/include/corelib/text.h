@@ -0,0 +1,49 @@
+/**
+ * @file text.h
+ * @brief Cached text layout for HUD strings.
+ *
+ * DrawText decodes, measures and places every glyph on every frame. A
+ * CachedText does that work only when its string changes and keeps the
+ * resulting glyph quads, so drawing it is a run of SubmitSprite calls that
+ * share the font texture and batch with the rest of the frame. Strings that
+ * never change, like titles, are laid out once. The layout matches
+ * DrawTextEx, including glyph padding and line breaks.
+ *
+ */
+
+#ifndef CORELIB_TEXT_H
+#define CORELIB_TEXT_H
+
+#include "raylib.h"
+#include "corelib/arena.h"
+#include "corelib/spritebatch.h"
+#include <stdbool.h>
+
+#define CACHED_TEXT_MAX_BYTES 128
+#define CACHED_TEXT_LINE_SPACING 2      // raylib's default text line spacing
+
+typedef struct {
+    Font font;                          /**< The font the text is laid out in (not owned). */
+    float fontSize;                     /**< The glyph height in pixels. */
+    float spacing;                      /**< The extra space between glyphs in pixels. */
+    char text[CACHED_TEXT_MAX_BYTES];   /**< The current string. */
+    const char* format;                 /**< The format of the last SetCachedTextInt call. */
+    int value;                          /**< The value of the last SetCachedTextInt call. */
+    Rectangle* sources;                 /**< The glyph rectangles in the font texture. */
+    Rectangle* dests;                   /**< The glyph rectangles relative to the text origin. */
+    int glyphCount;                     /**< The number of laid out glyphs. */
+    int glyphCapacity;                  /**< The most glyphs the text can hold. */
+    Vector2 size;                       /**< The laid out extent, as MeasureTextEx reports it. */
+    int layouts;                        /**< The times the text has been laid out. */
+    bool ownsMemory;                    /**< Whether the arrays came from the heap rather than an arena. */
+} CachedText;
+
+CachedText CreateCachedText(Arena* arena, Font font, float fontSize, float spacing, int maxGlyphs);
+void DestroyCachedText(CachedText* text);
+
+bool SetCachedText(CachedText* text, const char* string);
+bool SetCachedTextInt(CachedText* text, const char* format, int value);
+
+void SubmitCachedText(SpriteBatch* batch, const CachedText* text, Vector2 position, Color tint, int layer);
+
+#endif
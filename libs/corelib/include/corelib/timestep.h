@@ -0,0 +1,33 @@
+/**
+ * @file timestep.h
+ * @brief Fixed-timestep accumulator for frame-rate independent simulation.
+ *
+ * Feed the real frame time in once per frame, run the returned number of
+ * simulation ticks with a constant delta, then render with the leftover
+ * fraction as the interpolation factor between the last two ticks.
+ *
+ * GetFixedStepTickOffset maps a moment of real time to one of the ticks the
+ * last AdvanceFixedStep returned, so input can be applied at the tick that
+ * covers the moment it happened.
+ *
+ */
+
+#ifndef CORELIB_TIMESTEP_H
+#define CORELIB_TIMESTEP_H
+
+typedef struct {
+    float tickRate;         /**< Simulation ticks per second. */
+    float dt;               /**< Seconds per tick (1 / tickRate). */
+    float accumulator;      /**< Unsimulated time carried between frames. */
+    int maxSteps;           /**< Cap on ticks run per frame; excess time is dropped. */
+    int steps;              /**< Ticks returned by the last AdvanceFixedStep call. */
+    unsigned long tick;     /**< Total ticks advanced since creation or reset. */
+} FixedStep;
+
+FixedStep CreateFixedStep(float tickRate, int maxSteps);
+void ResetFixedStep(FixedStep* step);
+int AdvanceFixedStep(FixedStep* step, float frameTime);
+float GetFixedStepAlpha(const FixedStep* step);
+int GetFixedStepTickOffset(const FixedStep* step, double time, double now);
+
+#endif
@@ -0,0 +1,37 @@
+/**
+ * @file tunables.h
+ * @brief Named float values read from a text file and reloaded when it changes.
+ *
+ * A TunableSet overrides an array of values the caller owns. Each name maps
+ * to the value at the same index. The file is watched, so UpdateTunables
+ * picks up edits while the program runs. A value the file does not set,
+ * or a file that is missing, falls back to the default the array held when
+ * the set was created.
+ *
+ * The file is one assignment per line, '#' starting a comment:
+ *
+ *   GRAVITY = 1200
+ *   PIPE_SPEED = 180   # slower for testing
+ *
+ */
+
+#ifndef CORELIB_TUNABLES_H
+#define CORELIB_TUNABLES_H
+
+#include "corelib/watch.h"
+
+typedef struct {
+    char* fileName;             /**< The file the values are read from. */
+    const char* const* names;   /**< The name of each value. */
+    float* values;              /**< The caller's values, updated in place. */
+    float* defaults;            /**< The values the set was created with. */
+    int count;                  /**< The number of values. */
+    FileWatcher watcher;        /**< Watches fileName. */
+} TunableSet;
+
+TunableSet CreateTunableSet(const char* fileName, const char* const* names, float* values, int count);
+void DestroyTunableSet(TunableSet* set);
+int ReloadTunables(TunableSet* set);
+int UpdateTunables(TunableSet* set);
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @file watch.h
+ * @brief Non-blocking file change notifications for hot reloading.
+ *
+ * A watcher reports files that were written, created or replaced since it
+ * was last polled. It uses inotify on Linux and kqueue on macOS and the
+ * BSDs, so polling costs one non-blocking read when nothing changed. Other
+ * platforms, and systems where neither is available, fall back to checking
+ * modification times every FILE_WATCH_POLL_INTERVAL.
+ *
+ * Files are watched by path and may not exist yet: creating one counts as
+ * a change. Editors that save by writing a new file and renaming it over
+ * the old one are reported like any other write.
+ *
+ */
+
+#ifndef CORELIB_WATCH_H
+#define CORELIB_WATCH_H
+
+#include <stdbool.h>
+
+#define FILE_WATCH_POLL_INTERVAL 0.25   /**< Seconds between modification time checks when polling. */
+
+typedef struct {
+    char* path;             /**< The watched file. */
+    const char* name;       /**< The file name part of path. */
+    int handle;             /**< The inotify directory watch or kqueue file, or -1. */
+    long long mtime;        /**< The last modification time seen, when polling. */
+    long long size;         /**< The last size seen, when polling. */
+    bool changed;           /**< Whether a change is waiting to be reported. */
+} FileWatchEntry;
+
+typedef struct {
+    int fd;                     /**< The inotify or kqueue descriptor, or -1 when polling. */
+    FileWatchEntry* entries;    /**< The watched files; a file's watch ID is its index. */
+    int count;                  /**< The number of watched files. */
+    int capacity;               /**< The allocated number of entries. */
+    double nextCheck;           /**< When modification times are checked or files reopened next. */
+} FileWatcher;
+
+FileWatcher CreateFileWatcher(void);
+void DestroyFileWatcher(FileWatcher* watcher);
+int AddFileWatch(FileWatcher* watcher, const char* fileName);
+int PollFileWatcher(FileWatcher* watcher, int* changed, int maxChanged);
+
+#endif
@@ -0,0 +1,246 @@
+#include "corelib/animation.h"
+#include "corelib/metrics.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static AnimationFrame* AllocFrames(Arena* arena, int frameCount, bool* ownsFrames) {
+    size_t bytes = sizeof(AnimationFrame) * (size_t)(frameCount > 0 ? frameCount : 1);
+    *ownsFrames = (arena == NULL);
+    if (arena != NULL) return (AnimationFrame*)ArenaAlloc(arena, bytes);
+    
+    AnimationFrame* frames = malloc(bytes);
+    if (frames != NULL) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return frames;
+}
+
+Animation CreateAnimation(Arena* arena, Texture2D spritesheet, Rectangle* frames, int frameCount, float frameDuration, bool loop) {
+    Animation anim = {0};
+    anim.frames = AllocFrames(arena, frameCount, &anim.ownsFrames);
+    if (anim.frames == NULL) return anim;
+    
+    anim.spritesheet = spritesheet;
+    anim.frameCount = frameCount;
+    anim.currentFrame = 0;
+    anim.frameTimer = 0.0f;
+    anim.loop = loop;
+    
+    for (int i = 0; i < frameCount; i++) {
+        anim.frames[i].source = frames[i];
+        anim.frames[i].duration = frameDuration;
+        anim.frames[i].region = -1;
+    }
+    
+    return anim;
+}
+
+Animation CreateAnimationFromAtlas(Arena* arena, const TextureAtlas* atlas, const int* regionIds, int frameCount, float frameDuration, bool loop) {
+    Animation anim = {0};
+    anim.frames = AllocFrames(arena, frameCount, &anim.ownsFrames);
+    if (anim.frames == NULL) return anim;
+    
+    anim.spritesheet = atlas->texture;
+    anim.frameCount = frameCount;
+    anim.currentFrame = 0;
+    anim.frameTimer = 0.0f;
+    anim.loop = loop;
+    
+    for (int i = 0; i < frameCount; i++) {
+        anim.frames[i].source = GetAtlasRegionRec(atlas, regionIds[i]);
+        anim.frames[i].duration = frameDuration;
+        anim.frames[i].region = regionIds[i];
+    }
+    
+    return anim;
+}
+
+// Points an instance at a clip's frames in the table; nothing is copied,
+// so the instance must not outlive the table.
+Animation CreateAnimationFromTable(const AnimationTable* table, int clip, Texture2D spritesheet) {
+    Animation anim = {0};
+    if (clip < 0 || clip >= table->clipCount) return anim;
+    
+    const AnimationClip* c = &table->clips[clip];
+    anim.spritesheet = spritesheet;
+    anim.frames = table->frames + c->firstFrame;
+    anim.frameCount = c->frameCount;
+    anim.loop = c->loop;
+    return anim;
+}
+
+// Points an atlas animation at a (re)loaded atlas. regionIds may be NULL to
+// keep each frame's current region.
+void RebindAnimation(Animation* anim, const TextureAtlas* atlas, const int* regionIds) {
+    anim->spritesheet = atlas->texture;
+    for (int i = 0; i < anim->frameCount; i++) {
+        if (regionIds != NULL) anim->frames[i].region = regionIds[i];
+        anim->frames[i].source = GetAtlasRegionRec(atlas, anim->frames[i].region);
+    }
+}
+
+void DestroyAnimation(Animation* anim) {
+    if (anim->ownsFrames && anim->frames != NULL) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (anim->ownsFrames) free(anim->frames);
+    *anim = (Animation){0};
+}
+
+void UpdateAnimation(Animation* anim, float deltaTime) {
+    if (anim->frameCount <= 1) return;
+    
+    anim->frameTimer += deltaTime;
+    if (anim->frameTimer < anim->frames[anim->currentFrame].duration) return;
+    
+    // A long delta covers several frames. Whole loops are dropped first, so
+    // even a stall of many seconds walks at most one loop of frames.
+    if (anim->loop) {
+        float cycle = 0.0f;
+        for (int i = 0; i < anim->frameCount; i++) cycle += anim->frames[i].duration;
+        if (cycle <= 0.0f) return;
+        if (anim->frameTimer >= cycle) anim->frameTimer = fmodf(anim->frameTimer, cycle);
+    }
+    
+    // Carry the time left over from each frame into the next.
+    while (anim->frameTimer >= anim->frames[anim->currentFrame].duration) {
+        if (anim->currentFrame == anim->frameCount - 1 && !anim->loop) {
+            anim->frameTimer = anim->frames[anim->currentFrame].duration;
+            return;
+        }
+        anim->frameTimer -= anim->frames[anim->currentFrame].duration;
+        anim->currentFrame = (anim->currentFrame + 1 == anim->frameCount) ? 0 : anim->currentFrame + 1;
+    }
+}
+
+void UpdateAnimations(Animation* anims, int count, float deltaTime) {
+    for (int i = 0; i < count; i++) {
+        UpdateAnimation(&anims[i], deltaTime);
+    }
+}
+
+void DrawAnimation(const Animation* anim, Vector2 position, float rotation) {
+    if (anim->frameCount > 0 && anim->currentFrame < anim->frameCount) {
+        Rectangle source = anim->frames[anim->currentFrame].source;
+        Rectangle dest = { position.x, position.y, source.width, source.height };
+        Vector2 origin = { source.width / 2.0f, source.height / 2.0f };
+        
+        DrawTexturePro(anim->spritesheet, source, dest, origin, rotation, WHITE);
+    }
+}
+
+void DrawAnimations(const Animation* anims, const Vector2* positions, int count) {
+    for (int i = 0; i < count; i++) {
+        DrawAnimation(&anims[i], positions[i], 0.0f);
+    }
+}
+
+void SubmitAnimation(SpriteBatch* batch, const Animation* anim, Vector2 position, float rotation, Color tint, int layer) {
+    if (anim->frameCount > 0 && anim->currentFrame < anim->frameCount) {
+        Rectangle source = anim->frames[anim->currentFrame].source;
+        Rectangle dest = { position.x, position.y, source.width, source.height };
+        Vector2 origin = { source.width / 2.0f, source.height / 2.0f };
+        
+        SubmitSpritePro(batch, anim->spritesheet, source, dest, origin, rotation, tint, layer);
+    }
+}
+
+static uint16_t ReadU16(const unsigned char* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ReadU32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static float ReadF32(const unsigned char* p) {
+    uint32_t bits = ReadU32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool LoadAnimationTableFromMemory(const unsigned char* data, size_t size, AnimationTable* table) {
+    *table = (AnimationTable){0};
+    if (size < ANIMATION_HEADER_SIZE || ReadU32(data) != ANIMATION_MAGIC || ReadU16(data + 4) != ANIMATION_VERSION) {
+        TraceLog(LOG_WARNING, "ANIMATION: Not a version %d frame table", ANIMATION_VERSION);
+        return false;
+    }
+
+    int clipCount = ReadU16(data + 6);
+    int frameCount = (int)ReadU32(data + 8);
+    size_t clipsEnd = ANIMATION_HEADER_SIZE + (size_t)clipCount * ANIMATION_CLIP_SIZE;
+    if (frameCount < 0 || clipsEnd + (size_t)frameCount * ANIMATION_FRAME_SIZE > size) {
+        TraceLog(LOG_WARNING, "ANIMATION: Frame table is truncated");
+        return false;
+    }
+
+    // One block holds the frames, the clips and the region hashes, in that
+    // order, so the table frees in one call and its frames sit together.
+    size_t framesBytes = sizeof(AnimationFrame) * (size_t)frameCount;
+    size_t clipsBytes = sizeof(AnimationClip) * (size_t)clipCount;
+    unsigned char* block = malloc(framesBytes + clipsBytes + sizeof(uint32_t) * (size_t)frameCount + 1);
+    if (block == NULL) return false;
+    table->frames = (AnimationFrame*)block;
+    table->clips = (AnimationClip*)(block + framesBytes);
+    table->regionHashes = (uint32_t*)(block + framesBytes + clipsBytes);
+
+    for (int i = 0; i < clipCount; i++) {
+        const unsigned char* c = data + ANIMATION_HEADER_SIZE + (size_t)i * ANIMATION_CLIP_SIZE;
+        AnimationClip* clip = &table->clips[i];
+        clip->nameHash = ReadU32(c);
+        clip->firstFrame = ReadU16(c + 4);
+        clip->frameCount = ReadU16(c + 6);
+        clip->loop = (ReadU32(c + 8) & ANIMATION_CLIP_LOOP) != 0;
+        if (clip->firstFrame + clip->frameCount > frameCount) {
+            TraceLog(LOG_WARNING, "ANIMATION: Clip %d runs past the frame table", i);
+            free(block);
+            *table = (AnimationTable){0};
+            return false;
+        }
+    }
+    for (int i = 0; i < frameCount; i++) {
+        const unsigned char* f = data + clipsEnd + (size_t)i * ANIMATION_FRAME_SIZE;
+        table->regionHashes[i] = ReadU32(f);
+        table->frames[i] = (AnimationFrame){ .source = { 0 }, .duration = ReadF32(f + 4), .region = -1 };
+    }
+    table->clipCount = clipCount;
+    table->frameCount = frameCount;
+    return true;
+}
+
+AnimationTable LoadAnimationTable(const char* fileName) {
+    AnimationTable table = {0};
+    int size = 0;
+    unsigned char* data = LoadFileData(fileName, &size);
+    if (data == NULL) return table;
+
+    if (LoadAnimationTableFromMemory(data, (size_t)size, &table)) {
+        TraceLog(LOG_INFO, "ANIMATION: [%s] Loaded %d clips, %d frames", fileName, table.clipCount, table.frameCount);
+    }
+    UnloadFileData(data);
+    return table;
+}
+
+void UnloadAnimationTable(AnimationTable* table) {
+    free(table->frames);
+    *table = (AnimationTable){0};
+}
+
+void BindAnimationTable(AnimationTable* table, const TextureAtlas* atlas) {
+    for (int i = 0; i < table->frameCount; i++) {
+        table->frames[i].region = FindAtlasRegionHash(atlas, table->regionHashes[i]);
+        table->frames[i].source = GetAtlasRegionRec(atlas, table->frames[i].region);
+    }
+}
+
+int FindAnimationClip(const AnimationTable* table, const char* name) {
+    uint32_t hash = HashAtlasName(name);
+    int lo = 0;
+    int hi = table->clipCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        uint32_t h = table->clips[mid].nameHash;
+        if (h == hash) return mid;
+        if (h < hash) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
@@ -0,0 +1,229 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/archive.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+_Static_assert(sizeof(ArchiveEntry) == 40, "ArchiveEntry must match the file layout");
+_Static_assert(sizeof(AtlasRegion) == 20, "AtlasRegion must match the file layout");
+
+// GetPixelDataSize works in int, so cap the pixels at 16 bytes each.
+#define ARCHIVE_MAX_PIXELS ((uint64_t)INT_MAX / 16)
+
+// The bytes raylib reads for an image and its mipmaps, or 0 if the
+// parameters do not describe an image.
+static uint64_t GetStoredImageSize(uint32_t width, uint32_t height, uint32_t mipmaps, int format) {
+    if (width == 0 || height == 0 || width > ARCHIVE_MAX_PIXELS || height > ARCHIVE_MAX_PIXELS ||
+        (uint64_t)width * height > ARCHIVE_MAX_PIXELS || mipmaps == 0 || mipmaps > 32) {
+        return 0;
+    }
+    uint64_t size = 0;
+    int w = (int)width;
+    int h = (int)height;
+    for (uint32_t level = 0; level < mipmaps; level++) {
+        int levelSize = GetPixelDataSize(w, h, format);
+        if (levelSize <= 0) return 0;
+        size += (uint64_t)levelSize;
+        w = w > 1 ? w / 2 : 1;
+        h = h > 1 ? h / 2 : 1;
+    }
+    return size;
+}
+
+// The bytes an entry's parameters say it holds, or UINT64_MAX if they are
+// invalid.
+static uint64_t GetEntryDataSize(const ArchiveEntry* e) {
+    switch (e->type) {
+        case ARCHIVE_RAW:
+            return e->size;
+        case ARCHIVE_IMAGE: {
+            uint64_t pixels = GetStoredImageSize(e->params[0], e->params[1], e->params[2], e->format);
+            return pixels ? pixels : UINT64_MAX;
+        }
+        case ARCHIVE_WAVE: {
+            uint32_t sampleSize = e->params[2];
+            uint32_t channels = e->params[3];
+            if ((sampleSize != 8 && sampleSize != 16 && sampleSize != 32) || channels == 0 || channels > 255) {
+                return UINT64_MAX;
+            }
+            return (uint64_t)e->params[0] * channels * (sampleSize / 8);
+        }
+        case ARCHIVE_ATLAS: {
+            if (e->params[3] > INT_MAX / sizeof(AtlasRegion)) return UINT64_MAX;
+            uint64_t pixels = GetStoredImageSize(e->params[0], e->params[1], e->params[2], e->format);
+            return pixels ? GetArchiveAtlasPixelOffset((int)e->params[3]) + pixels : UINT64_MAX;
+        }
+        default:
+            return UINT64_MAX;
+    }
+}
+
+static bool CheckArchive(AssetArchive* archive, const char* fileName) {
+    const unsigned char* p = archive->base;
+    uint32_t magic, dataOffset;
+    uint16_t version, count;
+    if (archive->size < ARCHIVE_HEADER_SIZE) return false;
+    memcpy(&magic, p, 4);
+    memcpy(&version, p + 4, 2);
+    memcpy(&count, p + 6, 2);
+    memcpy(&dataOffset, p + 8, 4);
+
+    if (magic != ARCHIVE_MAGIC || version != ARCHIVE_VERSION ||
+        ARCHIVE_HEADER_SIZE + (size_t)count * sizeof(ArchiveEntry) > archive->size) {
+        TraceLog(LOG_WARNING, "ARCHIVE: [%s] Not a version %d asset archive", fileName, ARCHIVE_VERSION);
+        return false;
+    }
+
+    archive->entries = (const ArchiveEntry*)(p + ARCHIVE_HEADER_SIZE);
+    archive->entryCount = count;
+    for (int i = 0; i < count; i++) {
+        const ArchiveEntry* e = &archive->entries[i];
+        if (e->offset > archive->size || e->size > archive->size - e->offset) {
+            TraceLog(LOG_WARNING, "ARCHIVE: [%s] Entry %d is out of bounds", fileName, i);
+            return false;
+        }
+        // The getters hand raylib the parameters as they are, so an entry
+        // must hold every byte they describe.
+        uint64_t needed = GetEntryDataSize(e);
+        if (needed == UINT64_MAX) {
+            TraceLog(LOG_WARNING, "ARCHIVE: [%s] Entry %d has invalid parameters", fileName, i);
+            return false;
+        }
+        if (needed > e->size) {
+            TraceLog(LOG_WARNING, "ARCHIVE: [%s] Entry %d is truncated (%llu of %llu bytes)", fileName, i,
+                     (unsigned long long)e->size, (unsigned long long)needed);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool OpenAssetArchive(AssetArchive* archive, const char* fileName) {
+    *archive = (AssetArchive){0};
+
+#ifdef _WIN32
+    // No mmap here: fall back to a single read of the whole file.
+    int size = 0;
+    unsigned char* data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+    archive->base = data;
+    archive->size = (size_t)size;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+    posix_madvise(base, (size_t)st.st_size, POSIX_MADV_WILLNEED);
+    archive->base = base;
+    archive->size = (size_t)st.st_size;
+#endif
+
+    if (!CheckArchive(archive, fileName)) {
+        CloseAssetArchive(archive);
+        return false;
+    }
+    TraceLog(LOG_INFO, "ARCHIVE: [%s] Mapped %d entries (%zu bytes)", fileName, archive->entryCount, archive->size);
+    return true;
+}
+
+void CloseAssetArchive(AssetArchive* archive) {
+    if (archive->base != NULL) {
+#ifdef _WIN32
+        UnloadFileData((unsigned char*)archive->base);
+#else
+        munmap((void*)archive->base, archive->size);
+#endif
+    }
+    *archive = (AssetArchive){0};
+}
+
+int FindArchiveEntry(const AssetArchive* archive, const char* name) {
+    uint32_t hash = HashAtlasName(name);
+    int lo = 0;
+    int hi = archive->entryCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        uint32_t h = archive->entries[mid].nameHash;
+        if (h == hash) return mid;
+        if (h < hash) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+const unsigned char* GetArchiveData(const AssetArchive* archive, int entry, size_t* size) {
+    if (entry < 0 || entry >= archive->entryCount) {
+        *size = 0;
+        return NULL;
+    }
+    *size = (size_t)archive->entries[entry].size;
+    return archive->base + archive->entries[entry].offset;
+}
+
+Image GetArchiveImage(const AssetArchive* archive, int entry) {
+    if (entry < 0 || entry >= archive->entryCount || archive->entries[entry].type != ARCHIVE_IMAGE) return (Image){0};
+    const ArchiveEntry* e = &archive->entries[entry];
+    return (Image){
+        .data = (void*)(archive->base + e->offset),
+        .width = (int)e->params[0],
+        .height = (int)e->params[1],
+        .mipmaps = (int)e->params[2],
+        .format = e->format,
+    };
+}
+
+Wave GetArchiveWave(const AssetArchive* archive, int entry) {
+    if (entry < 0 || entry >= archive->entryCount || archive->entries[entry].type != ARCHIVE_WAVE) return (Wave){0};
+    const ArchiveEntry* e = &archive->entries[entry];
+    return (Wave){
+        .frameCount = e->params[0],
+        .sampleRate = e->params[1],
+        .sampleSize = e->params[2],
+        .channels = e->params[3],
+        .data = (void*)(archive->base + e->offset),
+    };
+}
+
+size_t GetArchiveAtlasPixelOffset(int regionCount) {
+    size_t table = sizeof(AtlasRegion) * (size_t)regionCount;
+    return (table + ARCHIVE_ALIGN - 1) & ~(size_t)(ARCHIVE_ALIGN - 1);
+}
+
+bool GetArchiveAtlas(const AssetArchive* archive, int entry, TextureAtlas* atlas, Image* image) {
+    *atlas = (TextureAtlas){0};
+    *image = (Image){0};
+    if (entry < 0 || entry >= archive->entryCount || archive->entries[entry].type != ARCHIVE_ATLAS) return false;
+
+    const ArchiveEntry* e = &archive->entries[entry];
+    int regionCount = (int)e->params[3];
+    size_t pixels = GetArchiveAtlasPixelOffset(regionCount);
+    if (pixels > e->size) return false;
+
+    atlas->regions = malloc(sizeof(AtlasRegion) * (size_t)(regionCount > 0 ? regionCount : 1));
+    if (atlas->regions == NULL) return false;
+    memcpy(atlas->regions, archive->base + e->offset, sizeof(AtlasRegion) * (size_t)regionCount);
+    atlas->regionCount = regionCount;
+
+    *image = (Image){
+        .data = (void*)(archive->base + e->offset + pixels),
+        .width = (int)e->params[0],
+        .height = (int)e->params[1],
+        .mipmaps = (int)e->params[2],
+        .format = e->format,
+    };
+    return true;
+}
@@ -0,0 +1,52 @@
+#include "corelib/arena.h"
+#include "corelib/metrics.h"
+#include "raylib.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+Arena CreateArena(size_t size) {
+    Arena arena = {0};
+    size = (size + ARENA_DEFAULT_ALIGN - 1) & ~(size_t)(ARENA_DEFAULT_ALIGN - 1);
+    arena.base = aligned_alloc(ARENA_DEFAULT_ALIGN, size);
+    if (arena.base != NULL) arena.size = size;
+    AddMetricGauge(METRIC_ARENA_BYTES, (int64_t)arena.size);
+    return arena;
+}
+
+void DestroyArena(Arena* arena) {
+    AddMetricGauge(METRIC_ARENA_BYTES, -(int64_t)arena->size);
+    free(arena->base);
+    *arena = (Arena){0};
+}
+
+void* ArenaAlloc(Arena* arena, size_t size) {
+    return ArenaAllocAligned(arena, size, ARENA_DEFAULT_ALIGN);
+}
+
+void* ArenaAllocAligned(Arena* arena, size_t size, size_t align) {
+    if (align == 0 || (align & (align - 1)) != 0) align = ARENA_DEFAULT_ALIGN;
+
+    uintptr_t start = ((uintptr_t)arena->base + arena->offset + (align - 1)) & ~(uintptr_t)(align - 1);
+    size_t offset = (size_t)(start - (uintptr_t)arena->base);
+    if (arena->base == NULL || offset > arena->size || size > arena->size - offset) {
+        TraceLog(LOG_WARNING, "ARENA: Out of memory (%zu of %zu bytes used, %zu requested)",
+                 arena->offset, arena->size, size);
+        return NULL;
+    }
+
+    arena->offset = offset + size;
+    if (arena->offset > arena->peak) arena->peak = arena->offset;
+    return arena->base + offset;
+}
+
+void ResetArena(Arena* arena) {
+    arena->offset = 0;
+}
+
+ArenaMark GetArenaMark(const Arena* arena) {
+    return arena->offset;
+}
+
+void RewindArena(Arena* arena, ArenaMark mark) {
+    if (mark <= arena->offset) arena->offset = mark;
+}
@@ -0,0 +1,488 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/assets.h"
+#include "corelib/clock.h"
+#include "corelib/metrics.h"
+#include "corelib/watch.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct AssetSlot {
+    AssetType type;
+    atomic_int state;       // AssetState
+    char* fileName;
+    Image image;            // Decoded pixels of a texture or atlas.
+    Wave wave;              // Decoded samples of a sound.
+    bool mapped;            // image and wave point into an archive mapping.
+    TextureAtlas atlas;
+    Texture2D texture;
+    Sound sound;
+    AudioClip clip;
+    AnimationTable animations;
+    int watch;              // The file watch when hot reloading, or -1.
+    uint64_t requestTime;   // When the asset was requested, for the load time metric.
+    struct AssetSlot* reload;   // A fresh copy of a changed file until it is swapped in.
+} AssetSlot;
+
+// A slot sits in each queue at most once, so neither ever holds more than
+// slotCapacity unread entries.
+static AssetSlot* slots = NULL;
+static int slotCount = 0;
+static int slotCapacity = 0;
+static int* requests = NULL;
+static int requestCount = 0;
+static int requestNext = 0;
+static int* decoded = NULL;
+static int decodedCount = 0;
+static int decodedNext = 0;
+
+static pthread_t worker;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static bool running = false;
+
+static FileWatcher watcher;
+static bool watching = false;
+
+typedef struct {
+    AssetArchive archive;
+    char* root;
+    size_t rootLength;
+} AssetMount;
+
+static AssetMount mounts[ASSET_MAX_ARCHIVES];
+static int mountCount = 0;
+
+static Texture2D placeholder = {0};
+static TextureAtlas placeholderAtlas = {0};
+static const AudioClip placeholderClip = {0};
+static const AnimationTable placeholderAnimations = {0};
+
+// Reads and decodes one asset; touches no GPU or audio-device state.
+static bool DecodeAsset(AssetSlot* slot) {
+    switch (slot->type) {
+        case ASSET_TEXTURE:
+            slot->image = LoadImage(slot->fileName);
+            return slot->image.data != NULL;
+        case ASSET_SOUND:
+            slot->wave = LoadWave(slot->fileName);
+            return slot->wave.data != NULL;
+        case ASSET_CLIP:
+            // Resampling is plain CPU work, so it happens here too.
+            slot->wave = LoadWave(slot->fileName);
+            slot->clip = LoadAudioClipFromWave(slot->wave);
+            UnloadWave(slot->wave);
+            slot->wave = (Wave){0};
+            return slot->clip.frameCount > 0;
+        case ASSET_ATLAS:
+            if (!LoadTextureAtlasImage(slot->fileName, &slot->atlas, &slot->image)) return false;
+            if (slot->image.data != NULL) return true;
+            free(slot->atlas.regions);
+            slot->atlas = (TextureAtlas){0};
+            return false;
+        case ASSET_ANIMATIONS:
+            slot->animations = LoadAnimationTable(slot->fileName);
+            return slot->animations.frames != NULL;
+    }
+    return false;
+}
+
+// Appends to an index queue, first sliding the unread entries down to the
+// front if the end has been reached.
+static void PushIndex(int* queue, int* count, int* next, int id) {
+    if (*count == slotCapacity) {
+        memmove(queue, queue + *next, sizeof(int) * (size_t)(*count - *next));
+        *count -= *next;
+        *next = 0;
+    }
+    queue[(*count)++] = id;
+}
+
+static void* AssetWorkerMain(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (running && requestNext == requestCount) pthread_cond_wait(&wake, &lock);
+        if (!running) break;
+
+        int id = requests[requestNext++];
+        AssetSlot* target = slots[id].reload != NULL ? slots[id].reload : &slots[id];
+        pthread_mutex_unlock(&lock);
+        bool ok = DecodeAsset(target);
+        pthread_mutex_lock(&lock);
+
+        // A failed reload goes to the main thread too, which drops it.
+        if (ok || target != &slots[id]) {
+            PushIndex(decoded, &decodedCount, &decodedNext, id);
+            atomic_store(&target->state, ok ? ASSET_DECODED : ASSET_FAILED);
+        } else {
+            TraceLog(LOG_WARNING, "ASSETS: [%s] Failed to load, keeping placeholder", slots[id].fileName);
+            atomic_store(&slots[id].state, ASSET_FAILED);
+            AddMetricCount(METRIC_ASSET_FAILURES, 1);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+bool InitAssetLoader(int capacity) {
+    if (running) return true;
+
+    slots = calloc((size_t)capacity, sizeof(AssetSlot));
+    requests = calloc((size_t)capacity, sizeof(int));
+    decoded = calloc((size_t)capacity, sizeof(int));
+    if (slots == NULL || requests == NULL || decoded == NULL) {
+        free(slots);
+        free(requests);
+        free(decoded);
+        return false;
+    }
+    slotCapacity = capacity;
+    slotCount = requestCount = requestNext = decodedCount = decodedNext = 0;
+
+    Image checker = GenImageChecked(16, 16, 4, 4, MAGENTA, BLACK);
+    placeholder = LoadTextureFromImage(checker);
+    UnloadImage(checker);
+    placeholderAtlas = (TextureAtlas){ .texture = placeholder };
+
+    running = true;
+    if (pthread_create(&worker, NULL, AssetWorkerMain, NULL) != 0) {
+        running = false;
+        CloseAssetLoader();
+        return false;
+    }
+    return true;
+}
+
+// Frees what a decoded but not yet uploaded slot holds.
+static void FreeDecoded(AssetSlot* slot) {
+    if (slot->image.data != NULL && !slot->mapped) UnloadImage(slot->image);
+    if (slot->wave.data != NULL && !slot->mapped) UnloadWave(slot->wave);
+    UnloadAudioClip(&slot->clip);
+    UnloadAnimationTable(&slot->animations);
+    free(slot->atlas.regions);
+}
+
+// Frees what an uploaded slot holds.
+static void UnloadUploaded(AssetSlot* slot) {
+    if (slot->type == ASSET_TEXTURE) UnloadTexture(slot->texture);
+    else if (slot->type == ASSET_SOUND) UnloadSound(slot->sound);
+    else if (slot->type == ASSET_CLIP) UnloadAudioClip(&slot->clip);
+    else if (slot->type == ASSET_ANIMATIONS) UnloadAnimationTable(&slot->animations);
+    else UnloadTextureAtlas(&slot->atlas);
+}
+
+void CloseAssetLoader(void) {
+    pthread_mutex_lock(&lock);
+    bool wasRunning = running;
+    running = false;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+    if (wasRunning) pthread_join(worker, NULL);
+
+    for (int i = 0; i < slotCount; i++) {
+        AssetSlot* slot = &slots[i];
+        int state = atomic_load(&slot->state);
+        if (state == ASSET_DECODED) FreeDecoded(slot);
+        else if (state == ASSET_READY) UnloadUploaded(slot);
+        if (slot->reload != NULL) {
+            if (atomic_load(&slot->reload->state) == ASSET_DECODED) FreeDecoded(slot->reload);
+            free(slot->reload);
+        }
+        free(slot->fileName);
+    }
+    if (watching) DestroyFileWatcher(&watcher);
+    watching = false;
+    if (placeholder.id > 0) UnloadTexture(placeholder);
+    placeholder = (Texture2D){0};
+    placeholderAtlas = (TextureAtlas){0};
+
+    for (int i = 0; i < mountCount; i++) {
+        CloseAssetArchive(&mounts[i].archive);
+        free(mounts[i].root);
+    }
+    mountCount = 0;
+
+    free(slots);
+    free(requests);
+    free(decoded);
+    slots = NULL;
+    requests = decoded = NULL;
+    slotCount = slotCapacity = 0;
+}
+
+bool MountAssetArchive(const char* fileName, const char* root) {
+    if (mountCount == ASSET_MAX_ARCHIVES) return false;
+
+    AssetMount* mount = &mounts[mountCount];
+    if (!OpenAssetArchive(&mount->archive, fileName)) return false;
+    mount->root = strdup(root);
+    if (mount->root == NULL) {
+        CloseAssetArchive(&mount->archive);
+        return false;
+    }
+    mount->rootLength = strlen(root);
+    mountCount++;
+    return true;
+}
+
+// Points the slot at its data in a mounted archive, if one holds it.
+static bool MapAsset(AssetSlot* slot) {
+    static const ArchiveEntryType entryTypes[] = {
+        [ASSET_TEXTURE] = ARCHIVE_IMAGE, [ASSET_SOUND] = ARCHIVE_WAVE, [ASSET_ATLAS] = ARCHIVE_ATLAS,
+        [ASSET_CLIP] = ARCHIVE_WAVE, [ASSET_ANIMATIONS] = ARCHIVE_RAW,
+    };
+    for (int i = mountCount - 1; i >= 0; i--) {
+        const AssetMount* mount = &mounts[i];
+        if (strncmp(slot->fileName, mount->root, mount->rootLength) != 0 || slot->fileName[mount->rootLength] != '/') continue;
+
+        int entry = FindArchiveEntry(&mount->archive, slot->fileName + mount->rootLength + 1);
+        if (entry < 0 || mount->archive.entries[entry].type != entryTypes[slot->type]) continue;
+
+        switch (slot->type) {
+            case ASSET_TEXTURE: slot->image = GetArchiveImage(&mount->archive, entry); break;
+            case ASSET_SOUND:
+            case ASSET_CLIP: slot->wave = GetArchiveWave(&mount->archive, entry); break;
+            case ASSET_ATLAS:
+                if (!GetArchiveAtlas(&mount->archive, entry, &slot->atlas, &slot->image)) continue;
+                break;
+            case ASSET_ANIMATIONS: {
+                // Frame tables are tiny and get written when bound, so they are
+                // copied out of the read-only mapping.
+                size_t size = 0;
+                const unsigned char* data = GetArchiveData(&mount->archive, entry, &size);
+                if (!LoadAnimationTableFromMemory(data, size, &slot->animations)) continue;
+                break;
+            }
+        }
+        slot->mapped = true;
+        return true;
+    }
+    return false;
+}
+
+static AssetHandle RequestAsset(AssetType type, const char* fileName) {
+    // Several games may ask for the same file; hand out one handle.
+    for (int i = 0; i < slotCount; i++) {
+        if (slots[i].type == type && strcmp(slots[i].fileName, fileName) == 0) return i;
+    }
+    if (!running || slotCount == slotCapacity) {
+        TraceLog(LOG_WARNING, "ASSETS: [%s] Loader full or not initialized", fileName);
+        return ASSET_INVALID;
+    }
+
+    char* name = strdup(fileName);
+    if (name == NULL) return ASSET_INVALID;
+
+    pthread_mutex_lock(&lock);
+    int id = slotCount++;
+    slots[id] = (AssetSlot){ .type = type, .fileName = name, .watch = -1, .requestTime = GetClockNanos() };
+    if (watching) slots[id].watch = AddFileWatch(&watcher, name);
+    if (MapAsset(&slots[id])) {
+        // Already decoded in the archive: skip the I/O thread.
+        atomic_init(&slots[id].state, ASSET_DECODED);
+        PushIndex(decoded, &decodedCount, &decodedNext, id);
+    } else {
+        atomic_init(&slots[id].state, ASSET_QUEUED);
+        PushIndex(requests, &requestCount, &requestNext, id);
+        pthread_cond_signal(&wake);
+    }
+    pthread_mutex_unlock(&lock);
+    return id;
+}
+
+AssetHandle RequestTexture(const char* fileName) {
+    return RequestAsset(ASSET_TEXTURE, fileName);
+}
+
+AssetHandle RequestSound(const char* fileName) {
+    return RequestAsset(ASSET_SOUND, fileName);
+}
+
+AssetHandle RequestTextureAtlas(const char* fileName) {
+    return RequestAsset(ASSET_ATLAS, fileName);
+}
+
+AssetHandle RequestAudioClip(const char* fileName) {
+    return RequestAsset(ASSET_CLIP, fileName);
+}
+
+AssetHandle RequestAnimationTable(const char* fileName) {
+    return RequestAsset(ASSET_ANIMATIONS, fileName);
+}
+
+static void UploadAsset(AssetSlot* slot) {
+    bool ok = false;
+    switch (slot->type) {
+        case ASSET_TEXTURE:
+            slot->texture = LoadTextureFromImage(slot->image);
+            if (!slot->mapped) UnloadImage(slot->image);
+            ok = slot->texture.id > 0;
+            break;
+        case ASSET_SOUND:
+            slot->sound = LoadSoundFromWave(slot->wave);
+            if (!slot->mapped) UnloadWave(slot->wave);
+            ok = slot->sound.frameCount > 0;
+            break;
+        case ASSET_CLIP:
+            // Archive waves arrive unconverted; file ones were converted by the worker.
+            if (slot->wave.data != NULL) slot->clip = LoadAudioClipFromWave(slot->wave);
+            ok = slot->clip.frameCount > 0;
+            break;
+        case ASSET_ATLAS:
+            slot->atlas.texture = LoadTextureFromImage(slot->image);
+            if (!slot->mapped) UnloadImage(slot->image);
+            ok = slot->atlas.texture.id > 0;
+            if (!ok) UnloadTextureAtlas(&slot->atlas);
+            break;
+        case ASSET_ANIMATIONS:
+            ok = true;
+            break;
+    }
+    slot->image = (Image){0};
+    slot->wave = (Wave){0};
+    atomic_store(&slot->state, ok ? ASSET_READY : ASSET_FAILED);
+}
+
+// Swaps a reloaded copy in. The old version is unloaded only now, on the
+// main thread, so nothing a getter returned earlier in the frame dangles.
+static void UploadReload(AssetSlot* slot) {
+    AssetSlot* staged = slot->reload;
+    if (atomic_load(&staged->state) == ASSET_DECODED) UploadAsset(staged);
+    if (atomic_load(&staged->state) == ASSET_READY) {
+        UnloadUploaded(slot);
+        slot->texture = staged->texture;
+        slot->sound = staged->sound;
+        slot->atlas = staged->atlas;
+        slot->animations = staged->animations;
+        slot->mapped = false;
+        TraceLog(LOG_INFO, "ASSETS: [%s] Reloaded", slot->fileName);
+    } else {
+        TraceLog(LOG_WARNING, "ASSETS: [%s] Failed to reload, keeping the loaded version", slot->fileName);
+    }
+    slot->reload = NULL;
+    free(staged);
+}
+
+int ProcessAssetUploads(double budgetSeconds) {
+    // Always upload at least one asset per call so loading makes progress.
+    double start = GetClockSeconds();
+    int uploaded = 0;
+    for (;;) {
+        pthread_mutex_lock(&lock);
+        int id = (decodedNext < decodedCount) ? decoded[decodedNext++] : -1;
+        pthread_mutex_unlock(&lock);
+        if (id < 0) break;
+
+        if (slots[id].reload != NULL) {
+            UploadReload(&slots[id]);
+        } else {
+            UploadAsset(&slots[id]);
+            if (atomic_load(&slots[id].state) == ASSET_READY) {
+                RecordMetricSample(METRIC_ASSET_LOAD_TIME, (GetClockNanos() - slots[id].requestTime) / 1000u);
+            } else {
+                AddMetricCount(METRIC_ASSET_FAILURES, 1);
+            }
+        }
+        uploaded++;
+        if (GetClockSeconds() - start >= budgetSeconds) break;
+    }
+    return uploaded;
+}
+
+AssetState GetAssetState(AssetHandle handle) {
+    if (handle < 0 || handle >= slotCount) return ASSET_FAILED;
+    return (AssetState)atomic_load(&slots[handle].state);
+}
+
+int GetPendingAssetCount(void) {
+    int pending = 0;
+    for (int i = 0; i < slotCount; i++) {
+        int state = atomic_load(&slots[i].state);
+        if (state == ASSET_QUEUED || state == ASSET_DECODED || slots[i].reload != NULL) pending++;
+    }
+    return pending;
+}
+
+Texture2D GetAssetTexture(AssetHandle handle) {
+    if (GetAssetState(handle) != ASSET_READY || slots[handle].type != ASSET_TEXTURE) return placeholder;
+    return slots[handle].texture;
+}
+
+Sound GetAssetSound(AssetHandle handle) {
+    if (GetAssetState(handle) != ASSET_READY || slots[handle].type != ASSET_SOUND) return (Sound){0};
+    return slots[handle].sound;
+}
+
+const TextureAtlas* GetAssetAtlas(AssetHandle handle) {
+    if (GetAssetState(handle) != ASSET_READY || slots[handle].type != ASSET_ATLAS) return &placeholderAtlas;
+    return &slots[handle].atlas;
+}
+
+const AudioClip* GetAssetClip(AssetHandle handle) {
+    if (GetAssetState(handle) != ASSET_READY || slots[handle].type != ASSET_CLIP) return &placeholderClip;
+    return &slots[handle].clip;
+}
+
+const AnimationTable* GetAssetAnimations(AssetHandle handle) {
+    if (GetAssetState(handle) != ASSET_READY || slots[handle].type != ASSET_ANIMATIONS) return &placeholderAnimations;
+    return &slots[handle].animations;
+}
+
+// Watches the file behind every asset requested so far and from now on.
+bool EnableAssetHotReload(void) {
+    if (watching) return true;
+    if (!running) return false;
+    watcher = CreateFileWatcher();
+    watching = true;
+    for (int i = 0; i < slotCount; i++) slots[i].watch = AddFileWatch(&watcher, slots[i].fileName);
+    return true;
+}
+
+// Loads the slot's file again. A failed asset is simply retried; a loaded
+// one is decoded into a copy that replaces it once uploaded.
+static bool QueueReload(int id) {
+    AssetSlot* slot = &slots[id];
+    int state = atomic_load(&slot->state);
+    if (slot->reload != NULL || state == ASSET_QUEUED || state == ASSET_DECODED) return false;
+
+    pthread_mutex_lock(&lock);
+    if (state == ASSET_FAILED) {
+        slot->mapped = false;
+        atomic_store(&slot->state, ASSET_QUEUED);
+    } else {
+        slot->reload = calloc(1, sizeof(AssetSlot));
+        if (slot->reload == NULL) {
+            pthread_mutex_unlock(&lock);
+            return false;
+        }
+        slot->reload->type = slot->type;
+        slot->reload->fileName = slot->fileName;
+        slot->reload->watch = -1;
+        atomic_init(&slot->reload->state, ASSET_QUEUED);
+    }
+    PushIndex(requests, &requestCount, &requestNext, id);
+    pthread_cond_signal(&wake);
+    pthread_mutex_unlock(&lock);
+    return true;
+}
+
+// Queues every changed file for a reload and returns how many were queued.
+// They arrive through ProcessAssetUploads like first loads. Audio clips are
+// skipped: the mixer reads their samples on the audio thread without a lock.
+int ReloadChangedAssets(void) {
+    if (!watching) return 0;
+    int changed[32];
+    int count = PollFileWatcher(&watcher, changed, 32);
+
+    int queued = 0;
+    for (int c = 0; c < count; c++) {
+        for (int i = 0; i < slotCount; i++) {
+            if (slots[i].watch != changed[c] || slots[i].type == ASSET_CLIP) continue;
+            if (QueueReload(i)) queued++;
+        }
+    }
+    return queued;
+}
@@ -0,0 +1,101 @@
+#include "corelib/atlas.h"
+#include <stdlib.h>
+
+static uint16_t ReadU16(const unsigned char* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ReadU32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// 32-bit FNV-1a.
+uint32_t HashAtlasName(const char* name) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* c = (const unsigned char*)name; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool LoadTextureAtlasImage(const char* fileName, TextureAtlas* atlas, Image* image) {
+    *atlas = (TextureAtlas){0};
+    *image = (Image){0};
+
+    int size = 0;
+    unsigned char* data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+
+    if (size < ATLAS_HEADER_SIZE || ReadU32(data) != ATLAS_MAGIC || ReadU16(data + 4) != ATLAS_VERSION) {
+        TraceLog(LOG_WARNING, "ATLAS: [%s] Not a version %d atlas", fileName, ATLAS_VERSION);
+        UnloadFileData(data);
+        return false;
+    }
+
+    int regionCount = ReadU16(data + 6);
+    uint32_t imageSize = ReadU32(data + 12);
+    long tableEnd = ATLAS_HEADER_SIZE + (long)regionCount * ATLAS_REGION_SIZE;
+    if (tableEnd + (long)imageSize > size) {
+        TraceLog(LOG_WARNING, "ATLAS: [%s] File is truncated", fileName);
+        UnloadFileData(data);
+        return false;
+    }
+
+    atlas->regions = malloc(sizeof(AtlasRegion) * (size_t)(regionCount > 0 ? regionCount : 1));
+    if (atlas->regions == NULL) {
+        UnloadFileData(data);
+        return false;
+    }
+    for (int i = 0; i < regionCount; i++) {
+        const unsigned char* r = data + ATLAS_HEADER_SIZE + i * ATLAS_REGION_SIZE;
+        atlas->regions[i].nameHash = ReadU32(r);
+        atlas->regions[i].source = (Rectangle){ ReadU16(r + 4), ReadU16(r + 6), ReadU16(r + 8), ReadU16(r + 10) };
+    }
+    atlas->regionCount = regionCount;
+
+    *image = LoadImageFromMemory(".png", data + tableEnd, (int)imageSize);
+    UnloadFileData(data);
+    return true;
+}
+
+TextureAtlas LoadTextureAtlas(const char* fileName) {
+    TextureAtlas atlas;
+    Image image;
+    if (!LoadTextureAtlasImage(fileName, &atlas, &image)) return atlas;
+
+    atlas.texture = LoadTextureFromImage(image);
+    UnloadImage(image);
+
+    TraceLog(LOG_INFO, "ATLAS: [%s] Loaded %d regions (%d x %d)", fileName, atlas.regionCount,
+             atlas.texture.width, atlas.texture.height);
+    return atlas;
+}
+
+void UnloadTextureAtlas(TextureAtlas* atlas) {
+    if (atlas->texture.id > 0) UnloadTexture(atlas->texture);
+    free(atlas->regions);
+    *atlas = (TextureAtlas){0};
+}
+
+int FindAtlasRegion(const TextureAtlas* atlas, const char* name) {
+    return FindAtlasRegionHash(atlas, HashAtlasName(name));
+}
+
+int FindAtlasRegionHash(const TextureAtlas* atlas, uint32_t hash) {
+    int lo = 0;
+    int hi = atlas->regionCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        uint32_t h = atlas->regions[mid].nameHash;
+        if (h == hash) return mid;
+        if (h < hash) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+Rectangle GetAtlasRegionRec(const TextureAtlas* atlas, int regionId) {
+    if (regionId < 0 || regionId >= atlas->regionCount) return (Rectangle){ 0 };
+    return atlas->regions[regionId].source;
+}
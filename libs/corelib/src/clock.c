@@ -0,0 +1,14 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/clock.h"
+#include <time.h>
+
+uint64_t GetClockNanos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+double GetClockSeconds(void) {
+    return (double)GetClockNanos() * 1e-9;
+}
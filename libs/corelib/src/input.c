@@ -0,0 +1,288 @@
+#include "corelib/input.h"
+#include "corelib/clock.h"
+#include "raylib.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INPUT_HEADER_SIZE 40
+#define INPUT_FLAG_OUTCOME 0x1u
+
+static void PutU32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint32_t GetU32(const unsigned char* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int PutVarint(unsigned char* p, uint32_t v) {
+    int n = 0;
+    while (v >= 0x80) {
+        p[n++] = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (unsigned char)v;
+    return n;
+}
+
+static bool GetVarint(const unsigned char** p, const unsigned char* end, uint32_t* out) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35 && *p < end; shift += 7) {
+        unsigned char b = *(*p)++;
+        v |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            *out = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+void StartInputRecording(InputStream* stream, uint64_t seed, float tickRate) {
+    CloseInputStream(stream);
+    stream->mode = INPUT_MODE_RECORD;
+    stream->recording.seed = seed;
+    stream->recording.tickRate = tickRate;
+}
+
+bool StartInputReplay(InputStream* stream, const char* fileName) {
+    CloseInputStream(stream);
+    if (!LoadInputRecording(&stream->recording, fileName)) return false;
+    stream->mode = INPUT_MODE_REPLAY;
+    return true;
+}
+
+void CloseInputStream(InputStream* stream) {
+    UnloadInputRecording(&stream->recording);
+    *stream = (InputStream){0};
+}
+
+void PushInput(InputStream* stream, InputBits pressed) {
+    if (stream->mode != INPUT_MODE_REPLAY) stream->pending |= pressed;
+}
+
+void PushTimedInput(InputStream* stream, InputBits pressed, int tickOffset) {
+    if (stream->mode == INPUT_MODE_REPLAY) return;
+    if (tickOffset <= 0) {
+        stream->pending |= pressed;
+        return;
+    }
+    if (tickOffset > INPUT_SCHEDULE_TICKS) tickOffset = INPUT_SCHEDULE_TICKS;
+    stream->scheduled[(stream->scheduleHead + tickOffset - 1) % INPUT_SCHEDULE_TICKS] |= pressed;
+}
+
+InputBits NextTickInput(InputStream* stream) {
+    InputBits bits = 0;
+    if (stream->mode == INPUT_MODE_REPLAY) {
+        const InputRecording* rec = &stream->recording;
+        if (stream->replayRun < rec->runCount) {
+            bits = rec->runs[stream->replayRun].bits;
+            if (++stream->replayOffset >= rec->runs[stream->replayRun].length) {
+                stream->replayRun++;
+                stream->replayOffset = 0;
+            }
+        }
+    } else {
+        bits = stream->pending;
+        stream->pending = stream->scheduled[stream->scheduleHead];
+        stream->scheduled[stream->scheduleHead] = 0;
+        stream->scheduleHead = (stream->scheduleHead + 1) % INPUT_SCHEDULE_TICKS;
+        if (stream->mode == INPUT_MODE_RECORD) AppendInputTick(&stream->recording, bits);
+    }
+    stream->tick++;
+    return bits;
+}
+
+bool IsInputReplayFinished(const InputStream* stream) {
+    return stream->mode == INPUT_MODE_REPLAY && stream->replayRun >= stream->recording.runCount;
+}
+
+// Whether a finished replay ended where its recording did. A recording with
+// no outcome only has its tick count to compare.
+bool CheckInputReplayOutcome(const InputStream* stream, int32_t score, uint32_t stateChecksum) {
+    const InputRecording* rec = &stream->recording;
+    if (stream->tick != rec->tickCount) {
+        TraceLog(LOG_WARNING, "INPUT: Replay ended on tick %u, the recording on tick %u", stream->tick, rec->tickCount);
+        return false;
+    }
+    if (!rec->hasOutcome) return true;
+    if (score != rec->finalScore || stateChecksum != rec->stateChecksum) {
+        TraceLog(LOG_WARNING, "INPUT: Replay diverged: score %d, state %08X; recorded score %d, state %08X",
+                 (int)score, (unsigned)stateChecksum, (int)rec->finalScore, (unsigned)rec->stateChecksum);
+        return false;
+    }
+    return true;
+}
+
+// Saves or loads the cursor: the latched presses, the replay position and
+// the tick. The recording itself is not part of the snapshot.
+void SnapshotInputStream(Snapshot* snap, InputStream* stream) {
+    SNAPSHOT_VALUE(snap, stream->pending);
+    SNAPSHOT_VALUE(snap, stream->scheduled);
+    SNAPSHOT_VALUE(snap, stream->scheduleHead);
+    SNAPSHOT_VALUE(snap, stream->replayRun);
+    SNAPSHOT_VALUE(snap, stream->replayOffset);
+    SNAPSHOT_VALUE(snap, stream->tick);
+    if (snap->loading && !snap->failed && stream->mode == INPUT_MODE_RECORD) {
+        TruncateInputRecording(&stream->recording, stream->tick);
+    }
+}
+
+InputQueue CreateInputQueue(InputSampler sample) {
+    return (InputQueue){ .sample = sample };
+}
+
+void SampleInputQueue(InputQueue* queue) {
+    InputBits bits = queue->sample ? queue->sample() : 0;
+    if (bits == 0) return;
+    if (queue->count == INPUT_QUEUE_CAPACITY) {
+        queue->dropped++;
+        return;
+    }
+    queue->events[queue->count++] = (InputEvent){ bits, GetClockSeconds() };
+}
+
+void PollInputQueue(InputQueue* queue) {
+    PollInputEvents();
+    SampleInputQueue(queue);
+}
+
+int DrainInputQueue(InputQueue* queue, InputEvent* events, int maxEvents) {
+    int count = queue->count < maxEvents ? queue->count : maxEvents;
+    for (int i = 0; i < count; i++) events[i] = queue->events[i];
+    queue->count = 0;
+    return count;
+}
+
+void AppendInputTick(InputRecording* recording, InputBits bits) {
+    recording->tickCount++;
+    if (recording->runCount > 0 && recording->runs[recording->runCount - 1].bits == bits &&
+        recording->runs[recording->runCount - 1].length < UINT32_MAX) {
+        recording->runs[recording->runCount - 1].length++;
+        return;
+    }
+    if (recording->runCount == recording->runCapacity) {
+        int capacity = recording->runCapacity ? recording->runCapacity * 2 : 256;
+        InputRun* runs = realloc(recording->runs, sizeof(InputRun) * (size_t)capacity);
+        if (runs == NULL) {
+            recording->tickCount--;
+            return;
+        }
+        recording->runs = runs;
+        recording->runCapacity = capacity;
+    }
+    recording->runs[recording->runCount++] = (InputRun){ bits, 1 };
+}
+
+// Drops every tick after the first tickCount.
+void TruncateInputRecording(InputRecording* recording, uint32_t tickCount) {
+    while (recording->tickCount > tickCount && recording->runCount > 0) {
+        InputRun* last = &recording->runs[recording->runCount - 1];
+        uint32_t excess = recording->tickCount - tickCount;
+        if (last->length > excess) {
+            last->length -= excess;
+            recording->tickCount = tickCount;
+        } else {
+            recording->tickCount -= last->length;
+            recording->runCount--;
+        }
+    }
+}
+
+void SetInputRecordingOutcome(InputRecording* recording, int32_t score, uint32_t stateChecksum) {
+    recording->hasOutcome = true;
+    recording->finalScore = score;
+    recording->stateChecksum = stateChecksum;
+}
+
+bool SaveInputRecording(const InputRecording* recording, const char* fileName) {
+    // Each run is at most two 5-byte varints.
+    size_t capacity = INPUT_HEADER_SIZE + (size_t)recording->runCount * 10;
+    unsigned char* data = malloc(capacity);
+    if (data == NULL) return false;
+
+    uint32_t rateBits;
+    memcpy(&rateBits, &recording->tickRate, sizeof(rateBits));
+    PutU32(data, INPUT_RECORDING_MAGIC);
+    PutU32(data + 4, INPUT_RECORDING_VERSION | (recording->hasOutcome ? INPUT_FLAG_OUTCOME << 16 : 0));
+    PutU32(data + 8, rateBits);
+    PutU32(data + 12, (uint32_t)(recording->seed & 0xFFFFFFFFu));
+    PutU32(data + 16, (uint32_t)(recording->seed >> 32));
+    PutU32(data + 20, recording->tickCount);
+    PutU32(data + 24, (uint32_t)recording->runCount);
+    PutU32(data + 28, (uint32_t)recording->finalScore);
+    PutU32(data + 32, recording->stateChecksum);
+    PutU32(data + 36, 0);
+
+    size_t size = INPUT_HEADER_SIZE;
+    for (int i = 0; i < recording->runCount; i++) {
+        size += (size_t)PutVarint(data + size, recording->runs[i].bits);
+        size += (size_t)PutVarint(data + size, recording->runs[i].length);
+    }
+
+    bool ok = SaveFileData(fileName, data, (int)size);
+    free(data);
+    return ok;
+}
+
+bool LoadInputRecording(InputRecording* recording, const char* fileName) {
+    *recording = (InputRecording){0};
+
+    int size = 0;
+    unsigned char* data = LoadFileData(fileName, &size);
+    if (data == NULL) return false;
+
+    if (size < INPUT_HEADER_SIZE || GetU32(data) != INPUT_RECORDING_MAGIC ||
+        (GetU32(data + 4) & 0xFFFF) != INPUT_RECORDING_VERSION) {
+        TraceLog(LOG_WARNING, "INPUT: [%s] Not a version %d input recording", fileName, INPUT_RECORDING_VERSION);
+        UnloadFileData(data);
+        return false;
+    }
+
+    uint32_t rateBits = GetU32(data + 8);
+    memcpy(&recording->tickRate, &rateBits, sizeof(rateBits));
+    recording->seed = (uint64_t)GetU32(data + 12) | ((uint64_t)GetU32(data + 16) << 32);
+    uint32_t tickCount = GetU32(data + 20);
+    uint32_t runCount = GetU32(data + 24);
+    recording->hasOutcome = (GetU32(data + 4) >> 16) & INPUT_FLAG_OUTCOME;
+    recording->finalScore = (int32_t)GetU32(data + 28);
+    recording->stateChecksum = GetU32(data + 32);
+
+    // A run takes at least two bytes, which bounds a sane runCount.
+    if (runCount > (uint32_t)(size - INPUT_HEADER_SIZE) / 2) {
+        TraceLog(LOG_WARNING, "INPUT: [%s] Recording is truncated", fileName);
+        UnloadFileData(data);
+        return false;
+    }
+    recording->runs = malloc(sizeof(InputRun) * (runCount ? runCount : 1));
+    if (recording->runs == NULL) {
+        UnloadFileData(data);
+        return false;
+    }
+    recording->runCapacity = (int)runCount;
+
+    const unsigned char* p = data + INPUT_HEADER_SIZE;
+    const unsigned char* end = data + size;
+    uint32_t ticks = 0;
+    for (uint32_t i = 0; i < runCount; i++) {
+        InputRun run;
+        if (!GetVarint(&p, end, &run.bits) || !GetVarint(&p, end, &run.length)) {
+            TraceLog(LOG_WARNING, "INPUT: [%s] Recording is truncated", fileName);
+            UnloadFileData(data);
+            UnloadInputRecording(recording);
+            return false;
+        }
+        recording->runs[recording->runCount++] = run;
+        ticks += run.length;
+    }
+    recording->tickCount = ticks;
+    if (ticks != tickCount) TraceLog(LOG_WARNING, "INPUT: [%s] Header tick count does not match runs", fileName);
+
+    UnloadFileData(data);
+    return true;
+}
+
+void UnloadInputRecording(InputRecording* recording) {
+    free(recording->runs);
+    *recording = (InputRecording){0};
+}
@@ -0,0 +1,336 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/jobs.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct Job {
+    JobFunc func;
+    void* data;
+    Job* parent;
+    atomic_int unfinished;      // The job itself plus its unfinished children.
+    atomic_int blockers;        // Unfinished dependencies, plus one until submitted.
+    atomic_flag lock;           // Orders AddJobDependency against the finish.
+    bool finished;              // Guarded by lock.
+    int continuationCount;      // Guarded by lock.
+    Job* continuations[JOB_MAX_CONTINUATIONS];
+};
+
+// A Chase-Lev deque: the owner pushes and pops at the bottom, thieves take
+// from the top. Every index access is sequentially consistent, which keeps
+// the single-item race between a pop and a steal down to one CAS on top.
+typedef struct {
+    atomic_long top;
+    atomic_long bottom;
+    _Atomic(Job*) items[JOB_CAPACITY];
+} JobDeque;
+
+typedef struct {
+    JobDeque deque;
+    Job jobs[JOB_CAPACITY];     // The ring the thread's jobs come from.
+    unsigned int nextJob;
+    uint32_t stealSeed;         // Picks the first victim when stealing.
+    pthread_t thread;
+} JobThread;
+
+static JobThread* threads[JOB_MAX_THREADS];
+static int threadCount = 0;
+static _Thread_local JobThread* currentThread = NULL;
+
+// Idle workers sleep until a job is queued or the system closes.
+static atomic_int queuedJobs = 0;
+static atomic_int sleepingWorkers = 0;
+static atomic_bool running = false;
+static pthread_mutex_t sleepLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+
+static bool PushDeque(JobDeque* deque, Job* job) {
+    long b = atomic_load(&deque->bottom);
+    long t = atomic_load(&deque->top);
+    if (b - t >= JOB_CAPACITY) return false;
+    atomic_store_explicit(&deque->items[b & (JOB_CAPACITY - 1)], job, memory_order_relaxed);
+    atomic_store(&deque->bottom, b + 1);
+    return true;
+}
+
+static Job* PopDeque(JobDeque* deque) {
+    long b = atomic_load(&deque->bottom) - 1;
+    atomic_store(&deque->bottom, b);
+    long t = atomic_load(&deque->top);
+    if (t > b) {
+        atomic_store(&deque->bottom, b + 1);
+        return NULL;
+    }
+
+    // The last job may be stolen at the same time; whoever moves top wins.
+    Job* job = atomic_load_explicit(&deque->items[b & (JOB_CAPACITY - 1)], memory_order_relaxed);
+    if (t == b) {
+        if (!atomic_compare_exchange_strong(&deque->top, &t, t + 1)) job = NULL;
+        atomic_store(&deque->bottom, b + 1);
+    }
+    return job;
+}
+
+static Job* StealDeque(JobDeque* deque) {
+    long t = atomic_load(&deque->top);
+    long b = atomic_load(&deque->bottom);
+    if (t >= b) return NULL;
+    Job* job = atomic_load_explicit(&deque->items[t & (JOB_CAPACITY - 1)], memory_order_relaxed);
+    return atomic_compare_exchange_strong(&deque->top, &t, t + 1) ? job : NULL;
+}
+
+static void RunJob(Job* job);
+
+// Queues a runnable job on the calling thread, or runs it now if the deque is full.
+static void QueueJob(Job* job) {
+    atomic_fetch_add(&queuedJobs, 1);
+    if (!PushDeque(&currentThread->deque, job)) {
+        atomic_fetch_sub(&queuedJobs, 1);
+        RunJob(job);
+        return;
+    }
+    if (atomic_load(&sleepingWorkers) > 0) {
+        pthread_mutex_lock(&sleepLock);
+        pthread_cond_signal(&wake);
+        pthread_mutex_unlock(&sleepLock);
+    }
+}
+
+// Takes a job from the calling thread's deque, or steals one from another.
+static Job* FindJob(void) {
+    JobThread* self = currentThread;
+    Job* job = PopDeque(&self->deque);
+    if (job == NULL && threadCount > 1) {
+        self->stealSeed ^= self->stealSeed << 13;
+        self->stealSeed ^= self->stealSeed >> 17;
+        self->stealSeed ^= self->stealSeed << 5;
+        int first = (int)(self->stealSeed % (uint32_t)threadCount);
+        for (int i = 0; i < threadCount && job == NULL; i++) {
+            JobThread* victim = threads[(first + i) % threadCount];
+            if (victim != self) job = StealDeque(&victim->deque);
+        }
+    }
+    if (job != NULL) atomic_fetch_sub(&queuedJobs, 1);
+    return job;
+}
+
+static void ReleaseBlocker(Job* job) {
+    if (atomic_fetch_sub(&job->blockers, 1) == 1) QueueJob(job);
+}
+
+static void FinishJob(Job* job) {
+    if (atomic_fetch_sub(&job->unfinished, 1) != 1) return;
+
+    // Take the continuations under the lock so none is added after this.
+    while (atomic_flag_test_and_set_explicit(&job->lock, memory_order_acquire)) {}
+    job->finished = true;
+    int count = job->continuationCount;
+    Job* continuations[JOB_MAX_CONTINUATIONS];
+    for (int i = 0; i < count; i++) continuations[i] = job->continuations[i];
+    atomic_flag_clear_explicit(&job->lock, memory_order_release);
+
+    for (int i = 0; i < count; i++) ReleaseBlocker(continuations[i]);
+    if (job->parent != NULL) FinishJob(job->parent);
+}
+
+static void RunJob(Job* job) {
+    if (job->func != NULL) job->func(job->data);
+    FinishJob(job);
+}
+
+static void* JobWorkerMain(void* arg) {
+    currentThread = arg;
+    while (atomic_load(&running)) {
+        Job* job = FindJob();
+        if (job != NULL) {
+            RunJob(job);
+            continue;
+        }
+
+        // Sleep until something is queued. Counting ourselves asleep before
+        // checking the queue means a push either sees us or we see it.
+        pthread_mutex_lock(&sleepLock);
+        atomic_fetch_add(&sleepingWorkers, 1);
+        while (atomic_load(&running) && atomic_load(&queuedJobs) <= 0) pthread_cond_wait(&wake, &sleepLock);
+        atomic_fetch_sub(&sleepingWorkers, 1);
+        pthread_mutex_unlock(&sleepLock);
+    }
+    return NULL;
+}
+
+// Clears running, wakes the workers and waits for threads 1..count-1 to exit.
+static void StopWorkers(int count) {
+    pthread_mutex_lock(&sleepLock);
+    atomic_store(&running, false);
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&sleepLock);
+    for (int i = 1; i < count; i++) pthread_join(threads[i]->thread, NULL);
+}
+
+static void FreeThreads(int count) {
+    for (int i = 0; i < count; i++) {
+        free(threads[i]);
+        threads[i] = NULL;
+    }
+    threadCount = 0;
+}
+
+bool InitJobSystem(int workerCount) {
+    if (atomic_load(&running)) return true;
+    if (workerCount < 0) workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    if (workerCount < 0) workerCount = 0;
+    if (workerCount > JOB_MAX_THREADS - 1) workerCount = JOB_MAX_THREADS - 1;
+
+    // Thread 0 is the caller; the workers steal from it and each other.
+    for (int i = 0; i <= workerCount; i++) {
+        threads[i] = calloc(1, sizeof(JobThread));
+        if (threads[i] == NULL) {
+            FreeThreads(i);
+            return false;
+        }
+        threads[i]->stealSeed = 0x9E3779B9u * (uint32_t)(i + 1);
+    }
+    currentThread = threads[0];
+    atomic_store(&queuedJobs, 0);
+
+    // Workers read threadCount and threads[] without a lock, so both are
+    // final before the first worker starts. If a worker fails to start, the
+    // ones that did are stopped and the system starts again with that many.
+    for (;;) {
+        threadCount = workerCount + 1;
+        atomic_store(&running, true);
+        int started = 1;
+        while (started < threadCount
+               && pthread_create(&threads[started]->thread, NULL, JobWorkerMain, threads[started]) == 0) {
+            started++;
+        }
+        if (started == threadCount) return true;
+
+        StopWorkers(started);
+        for (int i = started; i < threadCount; i++) {
+            free(threads[i]);
+            threads[i] = NULL;
+        }
+        workerCount = started - 1;
+    }
+}
+
+void CloseJobSystem(void) {
+    // Finish what is still queued here, then stop the workers.
+    if (atomic_load(&running) && currentThread != NULL) {
+        Job* job;
+        while ((job = FindJob()) != NULL) RunJob(job);
+    }
+    StopWorkers(threadCount);
+    FreeThreads(threadCount);
+    currentThread = NULL;
+}
+
+int GetJobThreadCount(void) {
+    return threadCount;
+}
+
+Job* CreateJob(JobFunc func, void* data) {
+    JobThread* self = currentThread;
+    if (self == NULL) return NULL;
+
+    Job* job = &self->jobs[self->nextJob++ & (JOB_CAPACITY - 1)];
+    job->func = func;
+    job->data = data;
+    job->parent = NULL;
+    atomic_init(&job->unfinished, 1);
+    atomic_init(&job->blockers, 1);
+    atomic_flag_clear(&job->lock);
+    job->finished = false;
+    job->continuationCount = 0;
+    return job;
+}
+
+Job* CreateChildJob(Job* parent, JobFunc func, void* data) {
+    Job* job = CreateJob(func, data);
+    if (job != NULL && parent != NULL) {
+        atomic_fetch_add(&parent->unfinished, 1);
+        job->parent = parent;
+    }
+    return job;
+}
+
+void AddJobDependency(Job* job, Job* dependency) {
+    if (job == NULL || dependency == NULL) return;
+
+    while (atomic_flag_test_and_set_explicit(&dependency->lock, memory_order_acquire)) {}
+    bool added = false;
+    bool done = dependency->finished;
+    if (!done && dependency->continuationCount < JOB_MAX_CONTINUATIONS) {
+        dependency->continuations[dependency->continuationCount++] = job;
+        atomic_fetch_add(&job->blockers, 1);
+        added = true;
+    }
+    atomic_flag_clear_explicit(&dependency->lock, memory_order_release);
+
+    // With no room left for another continuation, wait for it here instead.
+    if (!added && !done) WaitForJob(dependency);
+}
+
+void SubmitJob(Job* job) {
+    if (job == NULL) return;
+    if (!atomic_load(&running)) {
+        // Without the system the job runs inline, dependencies already met.
+        RunJob(job);
+        return;
+    }
+    ReleaseBlocker(job);
+}
+
+bool IsJobFinished(const Job* job) {
+    return job == NULL || atomic_load(&((Job*)job)->unfinished) == 0;
+}
+
+void WaitForJob(const Job* job) {
+    while (!IsJobFinished(job)) {
+        Job* other = FindJob();
+        if (other != NULL) RunJob(other);
+        else sched_yield();
+    }
+}
+
+typedef struct {
+    JobRangeFunc func;
+    void* data;
+    int count;
+    int grain;
+    atomic_int next;
+} ParallelRange;
+
+// Every slice job claims grains from the shared counter until none are left.
+static void RunParallelRange(void* data) {
+    ParallelRange* range = data;
+    for (;;) {
+        int begin = atomic_fetch_add(&range->next, range->grain);
+        if (begin >= range->count) break;
+        int end = begin + range->grain < range->count ? begin + range->grain : range->count;
+        range->func(begin, end, range->data);
+    }
+}
+
+void ParallelFor(int count, int grain, JobRangeFunc func, void* data) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    int chunks = (count + grain - 1) / grain;
+    if (threadCount <= 1 || chunks == 1) {
+        func(0, count, data);
+        return;
+    }
+
+    ParallelRange range = { func, data, count, grain, 0 };
+    int slices = chunks < threadCount ? chunks : threadCount;
+    Job* root = CreateJob(NULL, NULL);
+    for (int i = 1; i < slices; i++) SubmitJob(CreateChildJob(root, RunParallelRange, &range));
+    RunParallelRange(&range);
+    SubmitJob(root);
+    WaitForJob(root);
+}
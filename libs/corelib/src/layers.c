@@ -0,0 +1,45 @@
+#include "corelib/layers.h"
+
+CachedLayer LoadCachedLayer(Rectangle bounds) {
+    CachedLayer layer = {0};
+    layer.bounds = bounds;
+    layer.target = LoadRenderTexture((int)bounds.width, (int)bounds.height);
+    if (layer.target.id == 0) TraceLog(LOG_WARNING, "LAYERS: Cannot create a %dx%d layer", (int)bounds.width, (int)bounds.height);
+    return layer;
+}
+
+void UnloadCachedLayer(CachedLayer* layer) {
+    if (layer->target.id != 0) UnloadRenderTexture(layer->target);
+    *layer = (CachedLayer){0};
+}
+
+void InvalidateCachedLayer(CachedLayer* layer) {
+    layer->valid = false;
+}
+
+// Returns true when the layer must be drawn again: the target is then bound
+// and cleared, and the caller draws and finishes with EndCachedLayer.
+bool BeginCachedLayer(CachedLayer* layer, uint64_t key) {
+    if (layer->valid && layer->key == key) return false;
+
+    layer->key = key;
+    layer->valid = false;
+    BeginTextureMode(layer->target);
+    ClearBackground(BLANK);
+    BeginMode2D((Camera2D){ .offset = { -layer->bounds.x, -layer->bounds.y }, .zoom = 1.0f });
+    return true;
+}
+
+void EndCachedLayer(CachedLayer* layer) {
+    EndMode2D();
+    EndTextureMode();
+    layer->valid = (layer->target.id != 0);
+    layer->redraws++;
+}
+
+void SubmitCachedLayer(SpriteBatch* batch, const CachedLayer* layer, Color tint, int zLayer) {
+    if (!layer->valid) return;
+    // Render textures are stored bottom-up, so flip the source vertically.
+    Rectangle source = { 0, 0, layer->bounds.width, -layer->bounds.height };
+    SubmitSprite(batch, layer->target.texture, source, layer->bounds, tint, zLayer);
+}
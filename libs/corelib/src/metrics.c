@@ -0,0 +1,487 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/metrics.h"
+#include "raylib.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if !defined(_WIN32)
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#define METRICS_HEADER_SIZE 20
+#define METRICS_DEFAULT_INTERVAL 10.0
+
+typedef struct {
+    char name[METRIC_NAME_LENGTH];
+    MetricKind kind;
+    int histogram;          // The histogram slot, or -1.
+} MetricInfo;
+
+// Bucket counts only ever grow, so the exporter diffs them with its last
+// totals. The bucket counts are the sample count; there is no separate one
+// to fall out of step with them.
+typedef struct {
+    _Atomic uint32_t buckets[METRIC_HISTOGRAM_BUCKETS];
+    _Atomic uint64_t sum;
+    _Atomic uint64_t max;   // The largest sample since the exporter last took it.
+} MetricsHistogram;
+
+// Written only by the thread that owns it, read by the exporter.
+typedef struct {
+    _Atomic int64_t values[METRICS_MAX];    // Counter totals and gauge sums.
+    MetricsHistogram histograms[METRICS_MAX_HISTOGRAMS];
+} MetricsThread;
+
+typedef struct {
+    unsigned char data[METRICS_PACKET_SIZE];
+    size_t size;
+    int count;              // Metrics in a binary packet.
+} MetricsPacket;
+
+// The registry. Entries below metricCount never change once published.
+static MetricInfo metrics[METRICS_MAX] = {
+    [METRIC_FRAME_TIME] = { "corelib.frame.time_us", METRIC_HISTOGRAM, 0 },
+    [METRIC_FRAMES_MISSED] = { "corelib.frame.missed", METRIC_COUNTER, -1 },
+    [METRIC_DRAW_CALLS] = { "corelib.draw_calls", METRIC_COUNTER, -1 },
+    [METRIC_HEAP_OBJECTS] = { "corelib.heap.objects", METRIC_GAUGE, -1 },
+    [METRIC_ARENA_BYTES] = { "corelib.arena.bytes", METRIC_GAUGE, -1 },
+    [METRIC_POOL_OBJECTS] = { "corelib.pool.objects", METRIC_GAUGE, -1 },
+    [METRIC_ASSET_LOAD_TIME] = { "corelib.asset.load_us", METRIC_HISTOGRAM, 1 },
+    [METRIC_ASSET_FAILURES] = { "corelib.asset.failures", METRIC_COUNTER, -1 },
+};
+static atomic_int metricCount = METRIC_BUILTIN_COUNT;
+static int histogramCount = 2;
+
+// Thread blocks outlive their threads: a new thread takes over a free one
+// and its totals carry on from where they were.
+static _Thread_local MetricsThread* currentThread = NULL;
+static _Thread_local bool threadRefused = false;
+static MetricsThread* threads[METRICS_MAX_THREADS];
+static bool threadFree[METRICS_MAX_THREADS];
+static int threadCount = 0;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t threadKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t threadKey;
+
+// Exporter state. The last* totals belong to whichever thread is flushing.
+atomic_bool metricsRecording_ = false;
+static bool exporting = false;
+static pthread_t exporter;
+static pthread_mutex_t exportLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t exportWake = PTHREAD_COND_INITIALIZER;
+static double flushInterval = METRICS_DEFAULT_INTERVAL;
+static MetricsFormat outputFormat = METRICS_FORMAT_STATSD;
+static char namePrefix[METRIC_NAME_LENGTH];
+static FILE* outputFile = NULL;
+static int outputSocket = -1;
+static uint32_t sequence = 0;
+static int64_t lastValues[METRICS_MAX];
+static uint32_t lastBuckets[METRICS_MAX_HISTOGRAMS][METRIC_HISTOGRAM_BUCKETS];
+static uint64_t lastSums[METRICS_MAX_HISTOGRAMS];
+
+static void ReleaseThread(void* block) {
+    pthread_mutex_lock(&lock);
+    for (int i = 0; i < threadCount; i++) {
+        if (threads[i] == block) threadFree[i] = true;
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+static void CreateThreadKey(void) {
+    pthread_key_create(&threadKey, ReleaseThread);
+}
+
+static MetricsThread* GetThread(void) {
+    if (threadRefused) return NULL;
+    pthread_once(&threadKeyOnce, CreateThreadKey);
+
+    pthread_mutex_lock(&lock);
+    MetricsThread* t = NULL;
+    for (int i = 0; i < threadCount && t == NULL; i++) {
+        if (!threadFree[i]) continue;
+        threadFree[i] = false;
+        t = threads[i];
+    }
+    if (t == NULL && threadCount < METRICS_MAX_THREADS) {
+        t = calloc(1, sizeof(MetricsThread));
+        if (t != NULL) threads[threadCount++] = t;
+    }
+    pthread_mutex_unlock(&lock);
+
+    if (t == NULL) {
+        TraceLog(LOG_WARNING, "METRICS: More than %d threads recording, dropping this one's", METRICS_MAX_THREADS);
+        threadRefused = true;
+        return NULL;
+    }
+    pthread_setspecific(threadKey, t);
+    currentThread = t;
+    return t;
+}
+
+// The block to record id into, or NULL when id is unknown.
+static inline MetricsThread* GetRecordingThread(int id) {
+    if ((unsigned)id >= (unsigned)atomic_load_explicit(&metricCount, memory_order_acquire)) return NULL;
+    return currentThread != NULL ? currentThread : GetThread();
+}
+
+// A plain load and store: this thread is the only writer.
+void AddMetricValue_(int id, int64_t delta) {
+    MetricsThread* t = GetRecordingThread(id);
+    if (t == NULL) return;
+    _Atomic int64_t* value = &t->values[id];
+    atomic_store_explicit(value, atomic_load_explicit(value, memory_order_relaxed) + delta, memory_order_relaxed);
+}
+
+void RecordMetricValue_(int id, uint64_t value) {
+    MetricsThread* t = GetRecordingThread(id);
+    if (t == NULL || metrics[id].histogram < 0) return;
+
+    MetricsHistogram* h = &t->histograms[metrics[id].histogram];
+    _Atomic uint32_t* bucket = &h->buckets[GetMetricBucket(value)];
+    atomic_store_explicit(bucket, atomic_load_explicit(bucket, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store_explicit(&h->sum, atomic_load_explicit(&h->sum, memory_order_relaxed) + value, memory_order_relaxed);
+    // The exporter swaps max for 0, so a sample landing at that moment may
+    // be missed from the maximum, though never from the buckets.
+    if (value > atomic_load_explicit(&h->max, memory_order_relaxed)) {
+        atomic_store_explicit(&h->max, value, memory_order_relaxed);
+    }
+}
+
+// Four buckets per power of two: 0 to 3 exactly, then each octave split in
+// quarters, so a bucket is never wider than a quarter of its lower bound.
+int GetMetricBucket(uint64_t value) {
+    if (value < 4) return (int)value;
+    int octave = 63 - __builtin_clzll(value);
+    int bucket = (octave - 1) * 4 + (int)((value >> (octave - 2)) & 3);
+    return bucket < METRIC_HISTOGRAM_BUCKETS ? bucket : METRIC_HISTOGRAM_BUCKETS - 1;
+}
+
+uint64_t GetMetricBucketLow(int bucket) {
+    if (bucket < 4) return (uint64_t)bucket;
+    return (uint64_t)(4 + bucket % 4) << (bucket / 4 - 1);
+}
+
+int RegisterMetric(const char* name, MetricKind kind) {
+    if (strlen(name) >= METRIC_NAME_LENGTH) {
+        TraceLog(LOG_WARNING, "METRICS: [%s] Name is longer than %d characters", name, METRIC_NAME_LENGTH - 1);
+        return -1;
+    }
+
+    pthread_mutex_lock(&lock);
+    int count = atomic_load_explicit(&metricCount, memory_order_relaxed);
+    int id = -1;
+    for (int i = 0; i < count && id == -1; i++) {
+        if (strcmp(metrics[i].name, name) == 0) id = metrics[i].kind == kind ? i : -2;
+    }
+    if (id == -1 && count < METRICS_MAX && (kind != METRIC_HISTOGRAM || histogramCount < METRICS_MAX_HISTOGRAMS)) {
+        MetricInfo* info = &metrics[count];
+        snprintf(info->name, sizeof(info->name), "%s", name);
+        info->kind = kind;
+        info->histogram = kind == METRIC_HISTOGRAM ? histogramCount++ : -1;
+        id = count;
+        atomic_store_explicit(&metricCount, count + 1, memory_order_release);
+    }
+    pthread_mutex_unlock(&lock);
+
+    if (id == -2) TraceLog(LOG_WARNING, "METRICS: [%s] Already registered as another kind", name);
+    else if (id < 0) TraceLog(LOG_WARNING, "METRICS: [%s] No room for another metric", name);
+    return id < 0 ? -1 : id;
+}
+
+static void PutLittleEndian(unsigned char* p, uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static void BeginPacket(MetricsPacket* packet) {
+    packet->size = 0;
+    packet->count = 0;
+    if (outputFormat != METRICS_FORMAT_BINARY) return;
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    uint64_t ms = (uint64_t)now.tv_sec * 1000u + (uint64_t)now.tv_nsec / 1000000u;
+    memcpy(packet->data, "CLMT", 4);
+    PutLittleEndian(packet->data + 4, METRICS_BINARY_VERSION, 2);
+    PutLittleEndian(packet->data + 8, sequence, 4);
+    PutLittleEndian(packet->data + 12, ms, 8);
+    packet->size = METRICS_HEADER_SIZE;
+}
+
+static void SendPacket(MetricsPacket* packet) {
+    if (outputFormat == METRICS_FORMAT_BINARY) {
+        if (packet->count == 0) return;
+        PutLittleEndian(packet->data + 6, (uint64_t)packet->count, 2);
+    } else if (packet->size == 0) {
+        return;
+    }
+
+#if !defined(_WIN32)
+    // A lost datagram is a gap in the graphs, not an error.
+    if (outputSocket >= 0) (void)send(outputSocket, packet->data, packet->size, 0);
+#endif
+    if (outputFile != NULL) {
+        fwrite(packet->data, 1, packet->size, outputFile);
+        fflush(outputFile);
+    }
+    BeginPacket(packet);
+}
+
+// Adds one metric's bytes, starting a new packet if they do not fit.
+static void AppendPacket(MetricsPacket* packet, const void* data, size_t size) {
+    if (packet->size + size > METRICS_PACKET_SIZE) SendPacket(packet);
+    if (packet->size + size > METRICS_PACKET_SIZE) return;
+    memcpy(packet->data + packet->size, data, size);
+    packet->size += size;
+    packet->count++;
+}
+
+// The value below which pct percent of the samples fall, at the middle of
+// its bucket and no more than the largest sample.
+static uint64_t GetBucketPercentile(const uint32_t* buckets, uint64_t count, int pct, uint64_t max) {
+    uint64_t rank = (count * (uint64_t)pct + 99) / 100;
+    uint64_t seen = 0;
+    for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen < rank) continue;
+        uint64_t low = GetMetricBucketLow(b);
+        uint64_t high = b + 1 < METRIC_HISTOGRAM_BUCKETS ? GetMetricBucketLow(b + 1) : max + 1;
+        uint64_t mid = low + (high - low - 1) / 2;
+        return mid < max ? mid : max;
+    }
+    return max;
+}
+
+static void WriteStatsdLine(MetricsPacket* packet, const char* name, const char* suffix, int64_t value, char type) {
+    char line[160];
+    const char* dot = namePrefix[0] != '\0' ? "." : "";
+    int n;
+    if (type == 'g' && value < 0) {
+        // A signed gauge value is read as a change, so set it to 0 first.
+        n = snprintf(line, sizeof(line), "%s%s%s%s:0|g\n%s%s%s%s:%" PRId64 "|g\n",
+                     namePrefix, dot, name, suffix, namePrefix, dot, name, suffix, value);
+    } else {
+        n = snprintf(line, sizeof(line), "%s%s%s%s:%" PRId64 "|%c\n", namePrefix, dot, name, suffix, value, type);
+    }
+    if (n > 0 && (size_t)n < sizeof(line)) AppendPacket(packet, line, (size_t)n);
+}
+
+static void WriteHistogram(MetricsPacket* packet, const MetricInfo* info, const uint32_t* buckets,
+                           uint64_t sum, uint64_t max) {
+    uint64_t count = 0;
+    int used = 0;
+    for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+        count += buckets[b];
+        used += buckets[b] > 0;
+    }
+    if (count == 0) return;
+
+    if (outputFormat == METRICS_FORMAT_STATSD) {
+        WriteStatsdLine(packet, info->name, ".count", (int64_t)count, 'c');
+        WriteStatsdLine(packet, info->name, ".p50", (int64_t)GetBucketPercentile(buckets, count, 50, max), 'g');
+        WriteStatsdLine(packet, info->name, ".p99", (int64_t)GetBucketPercentile(buckets, count, 99, max), 'g');
+        WriteStatsdLine(packet, info->name, ".max", (int64_t)max, 'g');
+        return;
+    }
+
+    unsigned char entry[2 + METRIC_NAME_LENGTH + 26 + METRIC_HISTOGRAM_BUCKETS * 5];
+    size_t nameLength = strlen(info->name);
+    size_t n = 0;
+    entry[n++] = (unsigned char)info->kind;
+    entry[n++] = (unsigned char)nameLength;
+    memcpy(entry + n, info->name, nameLength);
+    n += nameLength;
+    PutLittleEndian(entry + n, count, 8);
+    PutLittleEndian(entry + n + 8, sum, 8);
+    PutLittleEndian(entry + n + 16, max, 8);
+    PutLittleEndian(entry + n + 24, (uint64_t)used, 2);
+    n += 26;
+    for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+        if (buckets[b] == 0) continue;
+        entry[n] = (unsigned char)b;
+        PutLittleEndian(entry + n + 1, buckets[b], 4);
+        n += 5;
+    }
+    AppendPacket(packet, entry, n);
+}
+
+static void WriteValue(MetricsPacket* packet, const MetricInfo* info, int64_t value) {
+    if (outputFormat == METRICS_FORMAT_STATSD) {
+        WriteStatsdLine(packet, info->name, "", value, info->kind == METRIC_COUNTER ? 'c' : 'g');
+        return;
+    }
+
+    unsigned char entry[2 + METRIC_NAME_LENGTH + 8];
+    size_t nameLength = strlen(info->name);
+    entry[0] = (unsigned char)info->kind;
+    entry[1] = (unsigned char)nameLength;
+    memcpy(entry + 2, info->name, nameLength);
+    PutLittleEndian(entry + 2 + nameLength, (uint64_t)value, 8);
+    AppendPacket(packet, entry, 2 + nameLength + 8);
+}
+
+// Totals every thread's blocks and writes what changed since the last call.
+static void FlushMetrics(void) {
+    pthread_mutex_lock(&lock);
+    int blocks = threadCount;
+    pthread_mutex_unlock(&lock);
+    int count = atomic_load_explicit(&metricCount, memory_order_acquire);
+
+    MetricsPacket packet;
+    BeginPacket(&packet);
+    for (int id = 0; id < count; id++) {
+        const MetricInfo* info = &metrics[id];
+        if (info->kind == METRIC_HISTOGRAM) {
+            int slot = info->histogram;
+            uint32_t buckets[METRIC_HISTOGRAM_BUCKETS] = {0};
+            uint64_t sum = 0, max = 0;
+            for (int i = 0; i < blocks; i++) {
+                MetricsHistogram* h = &threads[i]->histograms[slot];
+                for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+                    buckets[b] += atomic_load_explicit(&h->buckets[b], memory_order_relaxed);
+                }
+                sum += atomic_load_explicit(&h->sum, memory_order_relaxed);
+                uint64_t threadMax = atomic_exchange_explicit(&h->max, 0, memory_order_relaxed);
+                if (threadMax > max) max = threadMax;
+            }
+
+            // Unsigned differences stay right when a total wraps.
+            for (int b = 0; b < METRIC_HISTOGRAM_BUCKETS; b++) {
+                uint32_t total = buckets[b];
+                buckets[b] = total - lastBuckets[slot][b];
+                lastBuckets[slot][b] = total;
+            }
+            uint64_t sumDelta = sum - lastSums[slot];
+            lastSums[slot] = sum;
+            WriteHistogram(&packet, info, buckets, sumDelta, max);
+            continue;
+        }
+
+        int64_t total = 0;
+        for (int i = 0; i < blocks; i++) total += atomic_load_explicit(&threads[i]->values[id], memory_order_relaxed);
+        if (info->kind == METRIC_GAUGE) {
+            WriteValue(&packet, info, total);
+        } else if (total != lastValues[id]) {
+            WriteValue(&packet, info, total - lastValues[id]);
+        }
+        lastValues[id] = total;
+    }
+    SendPacket(&packet);
+    sequence++;
+}
+
+static void* MetricsExporterMain(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&exportLock);
+    while (exporting) {
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        double whole = (double)(time_t)flushInterval;
+        until.tv_sec += (time_t)flushInterval;
+        until.tv_nsec += (long)((flushInterval - whole) * 1e9);
+        if (until.tv_nsec >= 1000000000L) {
+            until.tv_sec++;
+            until.tv_nsec -= 1000000000L;
+        }
+        int result = 0;
+        while (exporting && result != ETIMEDOUT) result = pthread_cond_timedwait(&exportWake, &exportLock, &until);
+        if (!exporting) break;
+
+        pthread_mutex_unlock(&exportLock);
+        FlushMetrics();
+        pthread_mutex_lock(&exportLock);
+    }
+    pthread_mutex_unlock(&exportLock);
+    return NULL;
+}
+
+// Connects a datagram socket to "host:port"; the port follows the last colon.
+static int OpenMetricsSocket(const char* address) {
+#if defined(_WIN32)
+    TraceLog(LOG_WARNING, "METRICS: [udp:%s] UDP export is not supported on Windows", address);
+    return -1;
+#else
+    char host[256];
+    const char* colon = strrchr(address, ':');
+    if (colon == NULL || colon == address || (size_t)(colon - address) >= sizeof(host)) return -1;
+    memcpy(host, address, (size_t)(colon - address));
+    host[colon - address] = '\0';
+
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_DGRAM };
+    struct addrinfo* found = NULL;
+    if (getaddrinfo(host, colon + 1, &hints, &found) != 0) return -1;
+    int fd = -1;
+    for (struct addrinfo* a = found; a != NULL && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(found);
+    return fd;
+#endif
+}
+
+static void CloseMetricsOutput(void) {
+    if (outputFile != NULL) fclose(outputFile);
+#if !defined(_WIN32)
+    if (outputSocket >= 0) close(outputSocket);
+#endif
+    outputFile = NULL;
+    outputSocket = -1;
+}
+
+// target is a file to append to or "udp:host:port". prefix, which may be
+// NULL, goes in front of every StatsD name. interval is in seconds.
+bool InitMetrics(const char* target, MetricsFormat format, const char* prefix, double interval) {
+    if (exporting) return true;
+
+    if (strncmp(target, "udp:", 4) == 0) outputSocket = OpenMetricsSocket(target + 4);
+    else outputFile = fopen(target, "ab");
+    if (outputFile == NULL && outputSocket < 0) {
+        TraceLog(LOG_WARNING, "METRICS: [%s] Cannot open the metrics target", target);
+        return false;
+    }
+
+    snprintf(namePrefix, sizeof(namePrefix), "%s", prefix != NULL ? prefix : "");
+    outputFormat = format;
+    flushInterval = interval > 0.0 ? interval : METRICS_DEFAULT_INTERVAL;
+    exporting = true;
+    atomic_store(&metricsRecording_, true);
+    if (pthread_create(&exporter, NULL, MetricsExporterMain, NULL) != 0) {
+        atomic_store(&metricsRecording_, false);
+        exporting = false;
+        CloseMetricsOutput();
+        return false;
+    }
+    TraceLog(LOG_INFO, "METRICS: [%s] Exporting %s every %.1f s", target,
+             format == METRICS_FORMAT_BINARY ? "binary records" : "StatsD", flushInterval);
+    return true;
+}
+
+// Stops recording and writes what was recorded since the last flush.
+void CloseMetrics(void) {
+    if (!exporting) return;
+
+    atomic_store(&metricsRecording_, false);
+    pthread_mutex_lock(&exportLock);
+    exporting = false;
+    pthread_cond_signal(&exportWake);
+    pthread_mutex_unlock(&exportLock);
+    pthread_join(exporter, NULL);
+
+    FlushMetrics();
+    CloseMetricsOutput();
+}
+
+bool IsMetricsEnabled(void) {
+    return atomic_load_explicit(&metricsRecording_, memory_order_relaxed);
+}
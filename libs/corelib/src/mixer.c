@@ -0,0 +1,260 @@
+#include "corelib/mixer.h"
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    MIXER_PLAY,
+    MIXER_STOP_CLIP,
+    MIXER_STOP_ALL,
+    MIXER_SET_VOLUME
+} MixerCommandType;
+
+typedef struct {
+    MixerCommandType type;
+    const AudioClip* clip;
+    ClipPlayback playback;
+} MixerCommand;
+
+typedef struct {
+    const AudioClip* clip;      // NULL when the voice is free.
+    unsigned int position;      // The next frame to mix.
+    float gainLeft;
+    float gainRight;
+    int priority;
+    uint32_t order;             // When the voice started, for oldest-first stealing.
+} Voice;
+
+// The ring is written only by the game thread and read only by the audio
+// callback: each side owns one index and publishes it with release order.
+static MixerCommand queue[MIXER_QUEUE_CAPACITY];
+static atomic_uint queueHead = 0;   // Next slot to read (audio thread).
+static atomic_uint queueTail = 0;   // Next slot to write (game thread).
+
+// Everything below is owned by the audio thread once the stream plays.
+static Voice* voices = NULL;
+static int voiceCount = 0;
+static uint32_t nextOrder = 0;
+static float masterVolume = 1.0f;
+
+static AudioStream stream = {0};
+static bool running = false;
+
+static atomic_int activeVoices = 0;
+static atomic_int stolenVoices = 0;
+static atomic_int restartedVoices = 0;
+static atomic_int rejectedPlays = 0;
+static int droppedCommands = 0;         // Game thread only.
+
+static void StartVoice(Voice* voice, const AudioClip* clip, ClipPlayback playback) {
+    float volume = playback.volume < 0.0f ? 0.0f : (playback.volume > 1.0f ? 1.0f : playback.volume);
+    float pan = playback.pan < -1.0f ? -1.0f : (playback.pan > 1.0f ? 1.0f : playback.pan);
+    voice->clip = clip;
+    voice->position = 0;
+    voice->gainLeft = volume * (pan > 0.0f ? 1.0f - pan : 1.0f);
+    voice->gainRight = volume * (pan < 0.0f ? 1.0f + pan : 1.0f);
+    voice->priority = playback.priority;
+    voice->order = nextOrder++;
+}
+
+// Older voices have smaller orders; the wrapping difference keeps that true
+// across overflow as long as no voice outlives two billion plays.
+static bool IsOlder(const Voice* a, const Voice* b) {
+    return (int32_t)(a->order - b->order) < 0;
+}
+
+static void Play(const AudioClip* clip, ClipPlayback playback) {
+    if (clip == NULL || clip->frameCount == 0) return;
+
+    Voice* idle = NULL;
+    Voice* oldestInstance = NULL;
+    Voice* victim = NULL;
+    int instances = 0;
+    for (int i = 0; i < voiceCount; i++) {
+        Voice* v = &voices[i];
+        if (v->clip == NULL) {
+            if (idle == NULL) idle = v;
+            continue;
+        }
+        if (v->clip == clip) {
+            instances++;
+            if (oldestInstance == NULL || IsOlder(v, oldestInstance)) oldestInstance = v;
+        }
+        if (victim == NULL || v->priority < victim->priority || (v->priority == victim->priority && IsOlder(v, victim))) {
+            victim = v;
+        }
+    }
+
+    // The instance limit wins over free voices, so rapid repeats stay bounded.
+    if (playback.maxInstances > 0 && instances >= playback.maxInstances) {
+        StartVoice(oldestInstance, clip, playback);
+        atomic_fetch_add_explicit(&restartedVoices, 1, memory_order_relaxed);
+    } else if (idle != NULL) {
+        StartVoice(idle, clip, playback);
+    } else if (victim != NULL && victim->priority <= playback.priority) {
+        StartVoice(victim, clip, playback);
+        atomic_fetch_add_explicit(&stolenVoices, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&rejectedPlays, 1, memory_order_relaxed);
+    }
+}
+
+static void DrainCommands(void) {
+    unsigned int head = atomic_load_explicit(&queueHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&queueTail, memory_order_acquire);
+    for (; head != tail; head++) {
+        const MixerCommand* cmd = &queue[head & (MIXER_QUEUE_CAPACITY - 1)];
+        switch (cmd->type) {
+            case MIXER_PLAY:
+                Play(cmd->clip, cmd->playback);
+                break;
+            case MIXER_STOP_CLIP:
+                for (int i = 0; i < voiceCount; i++) {
+                    if (voices[i].clip == cmd->clip) voices[i].clip = NULL;
+                }
+                break;
+            case MIXER_STOP_ALL:
+                for (int i = 0; i < voiceCount; i++) voices[i].clip = NULL;
+                break;
+            case MIXER_SET_VOLUME:
+                masterVolume = cmd->playback.volume;
+                break;
+        }
+    }
+    atomic_store_explicit(&queueHead, head, memory_order_release);
+}
+
+// Runs on the audio thread whenever the stream needs more frames.
+static void MixAudio(void* bufferData, unsigned int frames) {
+    float* out = bufferData;
+    memset(out, 0, sizeof(float) * MIXER_CHANNELS * frames);
+    DrainCommands();
+
+    int active = 0;
+    for (int i = 0; i < voiceCount; i++) {
+        Voice* v = &voices[i];
+        if (v->clip == NULL) continue;
+
+        unsigned int remaining = v->clip->frameCount - v->position;
+        unsigned int n = remaining < frames ? remaining : frames;
+        const float* in = v->clip->samples + (size_t)v->position * MIXER_CHANNELS;
+        float gl = v->gainLeft * masterVolume;
+        float gr = v->gainRight * masterVolume;
+        for (unsigned int f = 0; f < n; f++) {
+            out[2 * f] += in[2 * f] * gl;
+            out[2 * f + 1] += in[2 * f + 1] * gr;
+        }
+
+        v->position += n;
+        if (v->position >= v->clip->frameCount) v->clip = NULL;
+        else active++;
+    }
+
+    // Hard-limit the sum so overlapping voices clip instead of wrapping.
+    for (unsigned int s = 0; s < MIXER_CHANNELS * frames; s++) {
+        if (out[s] > 1.0f) out[s] = 1.0f;
+        else if (out[s] < -1.0f) out[s] = -1.0f;
+    }
+    atomic_store_explicit(&activeVoices, active, memory_order_relaxed);
+}
+
+bool InitAudioMixer(int count) {
+    if (running) return true;
+    if (count < 1) count = 1;
+
+    voices = calloc((size_t)count, sizeof(Voice));
+    if (voices == NULL) return false;
+    voiceCount = count;
+    masterVolume = 1.0f;
+    atomic_store(&queueHead, 0);
+    atomic_store(&queueTail, 0);
+
+    SetAudioStreamBufferSizeDefault(MIXER_BUFFER_FRAMES);
+    stream = LoadAudioStream(MIXER_SAMPLE_RATE, 32, MIXER_CHANNELS);
+    SetAudioStreamBufferSizeDefault(0);
+    if (stream.buffer == NULL) {
+        TraceLog(LOG_WARNING, "MIXER: Cannot open the mixer stream");
+        free(voices);
+        voices = NULL;
+        voiceCount = 0;
+        return false;
+    }
+    SetAudioStreamCallback(stream, MixAudio);
+    PlayAudioStream(stream);
+    running = true;
+    return true;
+}
+
+void CloseAudioMixer(void) {
+    if (!running) return;
+    // Unloading the stream waits out any callback still in flight.
+    StopAudioStream(stream);
+    UnloadAudioStream(stream);
+    stream = (AudioStream){0};
+    free(voices);
+    voices = NULL;
+    voiceCount = 0;
+    running = false;
+}
+
+AudioClip LoadAudioClipFromWave(Wave wave) {
+    AudioClip clip = {0};
+    if (wave.data == NULL || wave.frameCount == 0) return clip;
+
+    Wave converted = WaveCopy(wave);
+    if (converted.data == NULL) return clip;
+    WaveFormat(&converted, MIXER_SAMPLE_RATE, 32, MIXER_CHANNELS);
+    clip.samples = LoadWaveSamples(converted);
+    clip.frameCount = clip.samples ? converted.frameCount : 0;
+    UnloadWave(converted);
+    return clip;
+}
+
+void UnloadAudioClip(AudioClip* clip) {
+    if (clip->samples != NULL) UnloadWaveSamples(clip->samples);
+    *clip = (AudioClip){0};
+}
+
+static bool PushCommand(MixerCommand cmd) {
+    if (!running) return false;
+    unsigned int tail = atomic_load_explicit(&queueTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&queueHead, memory_order_acquire);
+    if (tail - head == MIXER_QUEUE_CAPACITY) {
+        droppedCommands++;
+        return false;
+    }
+    queue[tail & (MIXER_QUEUE_CAPACITY - 1)] = cmd;
+    atomic_store_explicit(&queueTail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool PlayAudioClip(const AudioClip* clip, ClipPlayback playback) {
+    if (clip == NULL || clip->frameCount == 0) return false;
+    return PushCommand((MixerCommand){ .type = MIXER_PLAY, .clip = clip, .playback = playback });
+}
+
+bool StopAudioClip(const AudioClip* clip) {
+    return PushCommand((MixerCommand){ .type = MIXER_STOP_CLIP, .clip = clip });
+}
+
+bool StopAllAudioVoices(void) {
+    return PushCommand((MixerCommand){ .type = MIXER_STOP_ALL });
+}
+
+// The master gain, clamped to 0 to 1 like a voice's.
+bool SetAudioMixerVolume(float volume) {
+    volume = volume < 0.0f ? 0.0f : (volume > 1.0f ? 1.0f : volume);
+    return PushCommand((MixerCommand){ .type = MIXER_SET_VOLUME, .playback = { .volume = volume } });
+}
+
+MixerStats GetAudioMixerStats(void) {
+    return (MixerStats){
+        .voices = voiceCount,
+        .activeVoices = atomic_load_explicit(&activeVoices, memory_order_relaxed),
+        .stolen = atomic_load_explicit(&stolenVoices, memory_order_relaxed),
+        .restarted = atomic_load_explicit(&restartedVoices, memory_order_relaxed),
+        .rejected = atomic_load_explicit(&rejectedPlays, memory_order_relaxed),
+        .queueFull = droppedCommands,
+    };
+}
@@ -0,0 +1,405 @@
+#include "corelib/obstacles.h"
+#include "corelib/metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define OBSTACLES_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define OBSTACLES_NEON
+#endif
+
+#define OBSTACLE_ALIGN 16
+#define OBSTACLE_LANES 4
+
+// Allocates a zeroed, SIMD-aligned block from the arena or the heap.
+static void* AllocLanes(Arena* arena, size_t bytes) {
+    bytes = (bytes + OBSTACLE_ALIGN - 1) & ~(size_t)(OBSTACLE_ALIGN - 1);
+    void* p = arena ? ArenaAllocAligned(arena, bytes, OBSTACLE_ALIGN) : aligned_alloc(OBSTACLE_ALIGN, bytes);
+    if (p != NULL) memset(p, 0, bytes);
+    return p;
+}
+
+#if defined(OBSTACLES_SSE2) || defined(OBSTACLES_NEON)
+// The arrays hold whole lanes, so the kernels run the last partial lane too
+// and drop the bits of the dead slots past count.
+static inline uint32_t LiveLanes(int i, int n) {
+    return n - i >= OBSTACLE_LANES ? (1u << OBSTACLE_LANES) - 1u : (1u << (n - i)) - 1u;
+}
+#endif
+
+static inline float ClampFloat(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static void SetScoredBit(ObstacleField* field, int index, bool value) {
+    uint32_t bit = 1u << (index & 31);
+    if (value) field->scored[index >> 5] |= bit;
+    else field->scored[index >> 5] &= ~bit;
+}
+
+#if defined(OBSTACLES_NEON)
+// Packs the four comparison lanes into the low bits, like _mm_movemask_ps.
+static inline uint32_t MoveMaskNeon(uint32x4_t m) {
+    static const uint32_t weights[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(m, vld1q_u32(weights)));
+}
+#endif
+
+ObstacleField CreateObstacleField(Arena* arena, int capacity, float gap, float height) {
+    ObstacleField field = {0};
+    if (capacity < 1) capacity = 1;
+    capacity = (capacity + OBSTACLE_LANES - 1) / OBSTACLE_LANES * OBSTACLE_LANES;
+
+    field.ownsMemory = (arena == NULL);
+    field.x = AllocLanes(arena, (size_t)capacity * sizeof(float));
+    field.prevX = AllocLanes(arena, (size_t)capacity * sizeof(float));
+    field.gapY = AllocLanes(arena, (size_t)capacity * sizeof(float));
+    field.width = AllocLanes(arena, (size_t)capacity * sizeof(float));
+    field.scored = AllocLanes(arena, (size_t)(capacity + 31) / 32 * sizeof(uint32_t));
+    field.gap = gap;
+    field.height = height;
+
+    if (!field.x || !field.prevX || !field.gapY || !field.width || !field.scored) {
+        DestroyObstacleField(&field);
+        return field;
+    }
+    field.capacity = capacity;
+    if (field.ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return field;
+}
+
+void DestroyObstacleField(ObstacleField* field) {
+    if (field->ownsMemory && field->capacity > 0) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (field->ownsMemory) {
+        free(field->x);
+        free(field->prevX);
+        free(field->gapY);
+        free(field->width);
+        free(field->scored);
+    }
+    *field = (ObstacleField){0};
+}
+
+void ClearObstacles(ObstacleField* field) {
+    field->count = 0;
+    if (field->scored) memset(field->scored, 0, (size_t)(field->capacity + 31) / 32 * sizeof(uint32_t));
+}
+
+int AddObstacle(ObstacleField* field, float x, float gapY, float width) {
+    if (field->count >= field->capacity) return -1;
+    int i = field->count++;
+    field->x[i] = x;
+    field->prevX[i] = x;
+    field->gapY[i] = gapY;
+    field->width[i] = width;
+    SetScoredBit(field, i, false);
+    return i;
+}
+
+void ResetObstacle(ObstacleField* field, int index, float x, float gapY) {
+    field->x[index] = x;
+    field->prevX[index] = x;
+    field->gapY[index] = gapY;
+    SetScoredBit(field, index, false);
+}
+
+void RemoveObstacle(ObstacleField* field, int index) {
+    int last = --field->count;
+    if (index != last) {
+        field->x[index] = field->x[last];
+        field->prevX[index] = field->prevX[last];
+        field->gapY[index] = field->gapY[last];
+        field->width[index] = field->width[last];
+        SetScoredBit(field, index, IsObstacleScored(field, last));
+    }
+    SetScoredBit(field, last, false);
+}
+
+bool IsObstacleScored(const ObstacleField* field, int index) {
+    return (field->scored[index >> 5] >> (index & 31)) & 1u;
+}
+
+Rectangle GetObstacleTopRec(const ObstacleField* field, int index) {
+    return (Rectangle){ field->x[index], 0, field->width[index], field->gapY[index] };
+}
+
+Rectangle GetObstacleBottomRec(const ObstacleField* field, int index) {
+    float bottomY = field->gapY[index] + field->gap;
+    return (Rectangle){ field->x[index], bottomY, field->width[index], field->height - bottomY };
+}
+
+void ScrollObstacles(ObstacleField* field, float dx) {
+    int n = field->count;
+    int i = 0;
+#if defined(OBSTACLES_SSE2)
+    __m128 d = _mm_set1_ps(dx);
+    for (; i < n; i += OBSTACLE_LANES) {
+        __m128 x = _mm_load_ps(field->x + i);
+        _mm_store_ps(field->prevX + i, x);
+        _mm_store_ps(field->x + i, _mm_sub_ps(x, d));
+    }
+#elif defined(OBSTACLES_NEON)
+    float32x4_t d = vdupq_n_f32(dx);
+    for (; i < n; i += OBSTACLE_LANES) {
+        float32x4_t x = vld1q_f32(field->x + i);
+        vst1q_f32(field->prevX + i, x);
+        vst1q_f32(field->x + i, vsubq_f32(x, d));
+    }
+#endif
+    for (; i < n; i++) {
+        field->prevX[i] = field->x[i];
+        field->x[i] -= dx;
+    }
+}
+
+int CollectOffscreenObstacles(const ObstacleField* field, float minX, int* indices, int maxIndices) {
+    int n = field->count;
+    int found = 0;
+    int i = 0;
+#if defined(OBSTACLES_SSE2) || defined(OBSTACLES_NEON)
+    for (; i < n && found < maxIndices; i += OBSTACLE_LANES) {
+#if defined(OBSTACLES_SSE2)
+        __m128 right = _mm_add_ps(_mm_load_ps(field->x + i), _mm_load_ps(field->width + i));
+        uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_cmplt_ps(right, _mm_set1_ps(minX))) & LiveLanes(i, n);
+#else
+        float32x4_t right = vaddq_f32(vld1q_f32(field->x + i), vld1q_f32(field->width + i));
+        uint32_t mask = MoveMaskNeon(vcltq_f32(right, vdupq_n_f32(minX))) & LiveLanes(i, n);
+#endif
+        while (mask && found < maxIndices) {
+            int lane = __builtin_ctz(mask);
+            indices[found++] = i + lane;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < n && found < maxIndices; i++) {
+        if (field->x[i] + field->width[i] < minX) indices[found++] = i;
+    }
+    return found;
+}
+
+int ScoreObstacles(ObstacleField* field, float passX) {
+    int n = field->count;
+    int newlyScored = 0;
+
+    // Work one bitset word (32 obstacles) at a time.
+    for (int base = 0; base < n; base += 32) {
+        int end = (base + 32 < n) ? base + 32 : n;
+        uint32_t passed = 0;
+        int i = base;
+#if defined(OBSTACLES_SSE2)
+        __m128 p = _mm_set1_ps(passX);
+        for (; i < end; i += OBSTACLE_LANES) {
+            __m128 right = _mm_add_ps(_mm_load_ps(field->x + i), _mm_load_ps(field->width + i));
+            passed |= ((uint32_t)_mm_movemask_ps(_mm_cmpgt_ps(p, right)) & LiveLanes(i, end)) << (i - base);
+        }
+#elif defined(OBSTACLES_NEON)
+        float32x4_t p = vdupq_n_f32(passX);
+        for (; i < end; i += OBSTACLE_LANES) {
+            float32x4_t right = vaddq_f32(vld1q_f32(field->x + i), vld1q_f32(field->width + i));
+            passed |= (MoveMaskNeon(vcgtq_f32(p, right)) & LiveLanes(i, end)) << (i - base);
+        }
+#endif
+        for (; i < end; i++) {
+            if (passX > field->x[i] + field->width[i]) passed |= 1u << (i - base);
+        }
+
+        uint32_t* word = &field->scored[base >> 5];
+        uint32_t fresh = passed & ~*word;
+        *word |= fresh;
+        newlyScored += __builtin_popcount(fresh);
+    }
+
+    return newlyScored;
+}
+
+int CollideObstaclesRec(const ObstacleField* field, Rectangle rec) {
+    int n = field->count;
+    float left = rec.x;
+    float right = rec.x + rec.width;
+    float top = rec.y;
+    float bottom = rec.y + rec.height;
+
+    // The top columns start at y = 0 and the bottom ones end at field->height,
+    // so those edges reduce to per-query constants.
+    bool topReach = bottom > 0.0f;
+    bool bottomReach = top < field->height;
+    if (!topReach && !bottomReach) return -1;
+
+    int i = 0;
+#if defined(OBSTACLES_SSE2)
+    __m128 vLeft = _mm_set1_ps(left);
+    __m128 vRight = _mm_set1_ps(right);
+    __m128 vTop = _mm_set1_ps(top);
+    __m128 vBottom = _mm_set1_ps(bottom);
+    __m128 vGap = _mm_set1_ps(field->gap);
+    __m128 topMask = _mm_castsi128_ps(_mm_set1_epi32(topReach ? -1 : 0));
+    __m128 bottomMask = _mm_castsi128_ps(_mm_set1_epi32(bottomReach ? -1 : 0));
+    for (; i < n; i += OBSTACLE_LANES) {
+        __m128 x = _mm_load_ps(field->x + i);
+        __m128 gy = _mm_load_ps(field->gapY + i);
+        __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(vLeft, _mm_add_ps(x, _mm_load_ps(field->width + i))),
+                                     _mm_cmpgt_ps(vRight, x));
+        __m128 hitTop = _mm_and_ps(_mm_cmplt_ps(vTop, gy), topMask);
+        __m128 hitBottom = _mm_and_ps(_mm_cmpgt_ps(vBottom, _mm_add_ps(gy, vGap)), bottomMask);
+        uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_and_ps(overlapX, _mm_or_ps(hitTop, hitBottom))) & LiveLanes(i, n);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#elif defined(OBSTACLES_NEON)
+    float32x4_t vLeft = vdupq_n_f32(left);
+    float32x4_t vRight = vdupq_n_f32(right);
+    float32x4_t vTop = vdupq_n_f32(top);
+    float32x4_t vBottom = vdupq_n_f32(bottom);
+    float32x4_t vGap = vdupq_n_f32(field->gap);
+    uint32x4_t topMask = vdupq_n_u32(topReach ? 0xFFFFFFFFu : 0);
+    uint32x4_t bottomMask = vdupq_n_u32(bottomReach ? 0xFFFFFFFFu : 0);
+    for (; i < n; i += OBSTACLE_LANES) {
+        float32x4_t x = vld1q_f32(field->x + i);
+        float32x4_t gy = vld1q_f32(field->gapY + i);
+        uint32x4_t overlapX = vandq_u32(vcltq_f32(vLeft, vaddq_f32(x, vld1q_f32(field->width + i))),
+                                        vcgtq_f32(vRight, x));
+        uint32x4_t hitTop = vandq_u32(vcltq_f32(vTop, gy), topMask);
+        uint32x4_t hitBottom = vandq_u32(vcgtq_f32(vBottom, vaddq_f32(gy, vGap)), bottomMask);
+        uint32_t mask = MoveMaskNeon(vandq_u32(overlapX, vorrq_u32(hitTop, hitBottom))) & LiveLanes(i, n);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++) {
+        if (!(left < field->x[i] + field->width[i] && right > field->x[i])) continue;
+        if ((topReach && top < field->gapY[i]) || (bottomReach && bottom > field->gapY[i] + field->gap)) return i;
+    }
+    return -1;
+}
+
+// Circle against both solid parts of each column: clamp the center into each
+// rectangle and compare the squared distance with the squared radius.
+int CollideObstaclesCircle(const ObstacleField* field, Vector2 center, float radius) {
+    int n = field->count;
+    float cx = center.x;
+    float cy = center.y;
+    float r2 = radius * radius;
+    // The top parts span y in [0, gapY] and the bottom ones [gapY + gap, height],
+    // so each column's vertical clamps need only its gapY.
+
+    int i = 0;
+#if defined(OBSTACLES_SSE2)
+    __m128 vCx = _mm_set1_ps(cx);
+    __m128 vCy = _mm_set1_ps(cy);
+    __m128 vR2 = _mm_set1_ps(r2);
+    __m128 vGap = _mm_set1_ps(field->gap);
+    __m128 vZero = _mm_setzero_ps();
+    __m128 vHeight = _mm_set1_ps(field->height);
+    for (; i < n; i += OBSTACLE_LANES) {
+        __m128 x = _mm_load_ps(field->x + i);
+        __m128 gy = _mm_load_ps(field->gapY + i);
+        __m128 dx = _mm_sub_ps(vCx, _mm_min_ps(_mm_max_ps(vCx, x), _mm_add_ps(x, _mm_load_ps(field->width + i))));
+        __m128 dyTop = _mm_sub_ps(vCy, _mm_min_ps(_mm_max_ps(vCy, vZero), gy));
+        __m128 dyBottom = _mm_sub_ps(vCy, _mm_min_ps(_mm_max_ps(vCy, _mm_add_ps(gy, vGap)), vHeight));
+        __m128 dx2 = _mm_mul_ps(dx, dx);
+        __m128 hitTop = _mm_cmplt_ps(_mm_add_ps(dx2, _mm_mul_ps(dyTop, dyTop)), vR2);
+        __m128 hitBottom = _mm_cmplt_ps(_mm_add_ps(dx2, _mm_mul_ps(dyBottom, dyBottom)), vR2);
+        uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_or_ps(hitTop, hitBottom)) & LiveLanes(i, n);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#elif defined(OBSTACLES_NEON)
+    float32x4_t vCx = vdupq_n_f32(cx);
+    float32x4_t vCy = vdupq_n_f32(cy);
+    float32x4_t vR2 = vdupq_n_f32(r2);
+    float32x4_t vGap = vdupq_n_f32(field->gap);
+    float32x4_t vZero = vdupq_n_f32(0.0f);
+    float32x4_t vHeight = vdupq_n_f32(field->height);
+    for (; i < n; i += OBSTACLE_LANES) {
+        float32x4_t x = vld1q_f32(field->x + i);
+        float32x4_t gy = vld1q_f32(field->gapY + i);
+        float32x4_t dx = vsubq_f32(vCx, vminq_f32(vmaxq_f32(vCx, x), vaddq_f32(x, vld1q_f32(field->width + i))));
+        float32x4_t dyTop = vsubq_f32(vCy, vminq_f32(vmaxq_f32(vCy, vZero), gy));
+        float32x4_t dyBottom = vsubq_f32(vCy, vminq_f32(vmaxq_f32(vCy, vaddq_f32(gy, vGap)), vHeight));
+        float32x4_t dx2 = vmulq_f32(dx, dx);
+        uint32x4_t hitTop = vcltq_f32(vaddq_f32(dx2, vmulq_f32(dyTop, dyTop)), vR2);
+        uint32x4_t hitBottom = vcltq_f32(vaddq_f32(dx2, vmulq_f32(dyBottom, dyBottom)), vR2);
+        uint32_t mask = MoveMaskNeon(vorrq_u32(hitTop, hitBottom)) & LiveLanes(i, n);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < n; i++) {
+        float x = field->x[i];
+        float gy = field->gapY[i];
+        float dx = cx - ClampFloat(cx, x, x + field->width[i]);
+        float dyTop = cy - ClampFloat(cy, 0.0f, gy);
+        float dyBottom = cy - ClampFloat(cy, gy + field->gap, field->height);
+        if (dx * dx + dyTop * dyTop < r2 || dx * dx + dyBottom * dyBottom < r2) return i;
+    }
+    return -1;
+}
+
+// Many circles of one radius against every column, vectorized over the
+// circles. Sets bit i of hits (cleared first, (count + 31) / 32 words) for
+// each circle that touches a column, and returns how many do.
+int CollideObstaclesCircles(const ObstacleField* field, const float* cx, const float* cy, int count, float radius,
+                            uint32_t* hits) {
+    int words = (count + 31) / 32;
+    memset(hits, 0, sizeof(uint32_t) * (size_t)words);
+    float r2 = radius * radius;
+
+    for (int j = 0; j < field->count; j++) {
+        float left = field->x[j];
+        float right = left + field->width[j];
+        float gapTop = field->gapY[j];
+        float gapBottom = gapTop + field->gap;
+
+        int i = 0;
+#if defined(OBSTACLES_SSE2)
+        __m128 vLeft = _mm_set1_ps(left);
+        __m128 vRight = _mm_set1_ps(right);
+        __m128 vGapTop = _mm_set1_ps(gapTop);
+        __m128 vGapBottom = _mm_set1_ps(gapBottom);
+        __m128 vZero = _mm_setzero_ps();
+        __m128 vHeight = _mm_set1_ps(field->height);
+        __m128 vR2 = _mm_set1_ps(r2);
+        for (; i + OBSTACLE_LANES <= count; i += OBSTACLE_LANES) {
+            __m128 x = _mm_loadu_ps(cx + i);
+            __m128 y = _mm_loadu_ps(cy + i);
+            __m128 dx = _mm_sub_ps(x, _mm_min_ps(_mm_max_ps(x, vLeft), vRight));
+            __m128 dyTop = _mm_sub_ps(y, _mm_min_ps(_mm_max_ps(y, vZero), vGapTop));
+            __m128 dyBottom = _mm_sub_ps(y, _mm_min_ps(_mm_max_ps(y, vGapBottom), vHeight));
+            __m128 dx2 = _mm_mul_ps(dx, dx);
+            __m128 hitTop = _mm_cmplt_ps(_mm_add_ps(dx2, _mm_mul_ps(dyTop, dyTop)), vR2);
+            __m128 hitBottom = _mm_cmplt_ps(_mm_add_ps(dx2, _mm_mul_ps(dyBottom, dyBottom)), vR2);
+            hits[i >> 5] |= (uint32_t)_mm_movemask_ps(_mm_or_ps(hitTop, hitBottom)) << (i & 31);
+        }
+#elif defined(OBSTACLES_NEON)
+        float32x4_t vLeft = vdupq_n_f32(left);
+        float32x4_t vRight = vdupq_n_f32(right);
+        float32x4_t vGapTop = vdupq_n_f32(gapTop);
+        float32x4_t vGapBottom = vdupq_n_f32(gapBottom);
+        float32x4_t vZero = vdupq_n_f32(0.0f);
+        float32x4_t vHeight = vdupq_n_f32(field->height);
+        float32x4_t vR2 = vdupq_n_f32(r2);
+        for (; i + OBSTACLE_LANES <= count; i += OBSTACLE_LANES) {
+            float32x4_t x = vld1q_f32(cx + i);
+            float32x4_t y = vld1q_f32(cy + i);
+            float32x4_t dx = vsubq_f32(x, vminq_f32(vmaxq_f32(x, vLeft), vRight));
+            float32x4_t dyTop = vsubq_f32(y, vminq_f32(vmaxq_f32(y, vZero), vGapTop));
+            float32x4_t dyBottom = vsubq_f32(y, vminq_f32(vmaxq_f32(y, vGapBottom), vHeight));
+            float32x4_t dx2 = vmulq_f32(dx, dx);
+            uint32x4_t hitTop = vcltq_f32(vaddq_f32(dx2, vmulq_f32(dyTop, dyTop)), vR2);
+            uint32x4_t hitBottom = vcltq_f32(vaddq_f32(dx2, vmulq_f32(dyBottom, dyBottom)), vR2);
+            hits[i >> 5] |= MoveMaskNeon(vorrq_u32(hitTop, hitBottom)) << (i & 31);
+        }
+#endif
+        // The callers' arrays are not lane-padded, so the tail runs scalar.
+        for (; i < count; i++) {
+            float dx = cx[i] - ClampFloat(cx[i], left, right);
+            float dyTop = cy[i] - ClampFloat(cy[i], 0.0f, gapTop);
+            float dyBottom = cy[i] - ClampFloat(cy[i], gapBottom, field->height);
+            if (dx * dx + dyTop * dyTop < r2 || dx * dx + dyBottom * dyBottom < r2) hits[i >> 5] |= 1u << (i & 31);
+        }
+    }
+
+    int hitCount = 0;
+    for (int w = 0; w < words; w++) hitCount += __builtin_popcount(hits[w]);
+    return hitCount;
+}
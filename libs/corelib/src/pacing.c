@@ -0,0 +1,105 @@
+#include "corelib/pacing.h"
+#include "corelib/clock.h"
+#include "corelib/metrics.h"
+#include "raylib.h"
+#include <math.h>
+#include <stddef.h>
+
+// Sleeps until the given time, polling the pacer's input queue meanwhile.
+static void SleepUntil(FramePacer* pacer, double wake) {
+    for (;;) {
+        double left = wake - GetClockSeconds();
+        if (left <= 0.0) return;
+        if (pacer->input == NULL) {
+            WaitTime(left);
+            return;
+        }
+        WaitTime(left < INPUT_POLL_INTERVAL ? left : INPUT_POLL_INTERVAL);
+        PollInputQueue(pacer->input);
+    }
+}
+
+void SetFramePacerHints(PacingMode mode) {
+    if (mode == PACING_VSYNC) SetConfigFlags(FLAG_VSYNC_HINT);
+}
+
+FramePacer CreateFramePacer(PacingMode mode, double maxRate) {
+    FramePacer pacer = { .mode = mode };
+    int refresh = GetMonitorRefreshRate(GetCurrentMonitor());
+    pacer.refreshRate = refresh > 0 ? (double)refresh : 60.0;
+
+    if (maxRate > 0.0) {
+        if (mode == PACING_VSYNC) {
+            // Show every frame for the same whole number of refreshes.
+            double interval = ceil(pacer.refreshRate / maxRate - 1e-3);
+            pacer.period = (interval < 1.0 ? 1.0 : interval) / pacer.refreshRate;
+        } else {
+            pacer.period = 1.0 / (maxRate < pacer.refreshRate ? maxRate : pacer.refreshRate);
+        }
+    }
+    pacer.deadline = GetClockSeconds();
+    return pacer;
+}
+
+void DestroyFramePacer(FramePacer* pacer) {
+    DestroySampleSet(&pacer->latencyMs);
+    *pacer = (FramePacer){0};
+}
+
+void MarkFrameInput(FramePacer* pacer, double time) {
+    // Measure one press at a time; presses during a measurement are not timed.
+    if (pacer->inputTime <= 0.0) pacer->inputTime = time;
+}
+
+bool EndFramePacing(FramePacer* pacer, bool respondsToInput) {
+    // EndDrawing has just presented and polled.
+    double now = GetClockSeconds();
+    pacer->presents++;
+    if (pacer->input != NULL) SampleInputQueue(pacer->input);
+    if (pacer->lastPresent > 0.0) RecordMetricSample(METRIC_FRAME_TIME, (uint64_t)((now - pacer->lastPresent) * 1e6));
+    pacer->lastPresent = now;
+
+    bool measured = respondsToInput && pacer->inputTime > 0.0;
+    if (measured) {
+        pacer->lastLatencyMs = (now - pacer->inputTime) * 1000.0;
+        AddSample(&pacer->latencyMs, pacer->lastLatencyMs);
+        pacer->inputTime = 0.0;
+    }
+    if (pacer->period <= 0.0) return measured;
+
+    // Keep the cadence unless a frame ran a whole period late; then restart it.
+    if (now - pacer->deadline > pacer->period) {
+        pacer->missed++;
+        AddMetricCount(METRIC_FRAMES_MISSED, 1);
+        pacer->deadline = now;
+    }
+    pacer->deadline += pacer->period;
+
+    // Under vsync the swap waits for vblank itself, so only sleep through the
+    // refreshes the frame should stay up for.
+    double wake = pacer->deadline;
+    if (pacer->mode == PACING_VSYNC) wake -= 0.75 / pacer->refreshRate;
+    SleepUntil(pacer, wake);
+    return measured;
+}
+
+void WaitForFrameEvents(FramePacer* pacer, bool block, double pollRate) {
+    if (block) {
+        // raylib's poll sleeps in the window system until an event arrives.
+        EnableEventWaiting();
+        PollInputEvents();
+        DisableEventWaiting();
+        if (pacer->input != NULL) SampleInputQueue(pacer->input);
+        pacer->idleWaits++;
+    } else {
+        // Wait first, so the poll is as fresh as possible.
+        SleepUntil(pacer, GetClockSeconds() + 1.0 / pollRate);
+        if (pacer->input != NULL) PollInputQueue(pacer->input);
+        else PollInputEvents();
+    }
+
+    // The next drawn frame is due as soon as it is ready. The wait is not
+    // part of any frame's time.
+    pacer->deadline = GetClockSeconds();
+    pacer->lastPresent = 0.0;
+}
@@ -0,0 +1,242 @@
+#include "corelib/particles.h"
+#include "corelib/metrics.h"
+#include "corelib/profiler.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define PARTICLES_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PARTICLES_NEON
+#endif
+
+#define PARTICLE_ALIGN 16
+#define PARTICLE_LANES 4
+#define PARTICLE_DRAW_CHUNK 1024    // Quads reserved in rlgl's batch at a time.
+
+// Allocates a zeroed, SIMD-aligned block from the arena or the heap.
+static void* AllocParticleLanes(Arena* arena, size_t bytes) {
+    bytes = (bytes + PARTICLE_ALIGN - 1) & ~(size_t)(PARTICLE_ALIGN - 1);
+    void* p = arena ? ArenaAllocAligned(arena, bytes, PARTICLE_ALIGN) : aligned_alloc(PARTICLE_ALIGN, bytes);
+    if (p != NULL) memset(p, 0, bytes);
+    return p;
+}
+
+static inline uint32_t PackColor(Color c) {
+    return (uint32_t)c.r | (uint32_t)c.g << 8 | (uint32_t)c.b << 16 | (uint32_t)c.a << 24;
+}
+
+static inline unsigned char LerpChannel(uint32_t from, uint32_t to, int shift, int t) {
+    int a = (int)(from >> shift & 0xFF);
+    int b = (int)(to >> shift & 0xFF);
+    return (unsigned char)(a + (((b - a) * t) >> 8));
+}
+
+ParticleSystem CreateParticleSystem(Arena* arena, int capacity, float gravity, float drag) {
+    ParticleSystem system = {0};
+    if (capacity < 1) capacity = 1;
+    capacity = (capacity + PARTICLE_LANES - 1) / PARTICLE_LANES * PARTICLE_LANES;
+
+    size_t floats = (size_t)capacity * sizeof(float);
+    system.ownsMemory = (arena == NULL);
+    system.x = AllocParticleLanes(arena, floats);
+    system.y = AllocParticleLanes(arena, floats);
+    system.vx = AllocParticleLanes(arena, floats);
+    system.vy = AllocParticleLanes(arena, floats);
+    system.age = AllocParticleLanes(arena, floats);
+    system.ageRate = AllocParticleLanes(arena, floats);
+    system.size = AllocParticleLanes(arena, floats);
+    system.sizeDelta = AllocParticleLanes(arena, floats);
+    system.colorStart = AllocParticleLanes(arena, (size_t)capacity * sizeof(uint32_t));
+    system.colorEnd = AllocParticleLanes(arena, (size_t)capacity * sizeof(uint32_t));
+    system.gravity = gravity;
+    system.drag = drag;
+    system.source = (Rectangle){ 0.0f, 0.0f, 1.0f, 1.0f };
+
+    if (!system.x || !system.y || !system.vx || !system.vy || !system.age || !system.ageRate ||
+        !system.size || !system.sizeDelta || !system.colorStart || !system.colorEnd) {
+        DestroyParticleSystem(&system);
+        return system;
+    }
+    system.capacity = capacity;
+    if (system.ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return system;
+}
+
+void DestroyParticleSystem(ParticleSystem* system) {
+    if (system->ownsMemory && system->capacity > 0) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (system->ownsMemory) {
+        free(system->x);
+        free(system->y);
+        free(system->vx);
+        free(system->vy);
+        free(system->age);
+        free(system->ageRate);
+        free(system->size);
+        free(system->sizeDelta);
+        free(system->colorStart);
+        free(system->colorEnd);
+    }
+    *system = (ParticleSystem){0};
+}
+
+void ClearParticles(ParticleSystem* system) {
+    system->count = 0;
+}
+
+void SetParticleTexture(ParticleSystem* system, Texture2D texture, Rectangle source) {
+    system->texture = texture;
+    system->source = source;
+}
+
+int EmitParticles(ParticleSystem* system, const ParticleBurst* burst, Vector2 position, Vector2 velocity,
+                  int count, Rng* rng) {
+    int room = system->capacity - system->count;
+    if (count > room) {
+        system->dropped += count - room;
+        count = room;
+    }
+
+    uint32_t colorStart = PackColor(burst->colorStart);
+    uint32_t colorEnd = PackColor(burst->colorEnd);
+    for (int k = 0; k < count; k++) {
+        int i = system->count++;
+        float angle = burst->direction + (RandomFloat(rng) * 2.0f - 1.0f) * burst->spread;
+        float speed = burst->speedMin + RandomFloat(rng) * (burst->speedMax - burst->speedMin);
+        float life = burst->lifeMin + RandomFloat(rng) * (burst->lifeMax - burst->lifeMin);
+
+        system->x[i] = position.x;
+        system->y[i] = position.y;
+        system->vx[i] = velocity.x + cosf(angle) * speed;
+        system->vy[i] = velocity.y + sinf(angle) * speed;
+        system->age[i] = 0.0f;
+        system->ageRate[i] = 1.0f / (life > 0.001f ? life : 0.001f);
+        system->size[i] = burst->sizeStart;
+        system->sizeDelta[i] = burst->sizeEnd - burst->sizeStart;
+        system->colorStart[i] = colorStart;
+        system->colorEnd[i] = colorEnd;
+    }
+    return count;
+}
+
+// Moves particle from into slot to, across every array.
+static void MoveParticle(ParticleSystem* system, int to, int from) {
+    system->x[to] = system->x[from];
+    system->y[to] = system->y[from];
+    system->vx[to] = system->vx[from];
+    system->vy[to] = system->vy[from];
+    system->age[to] = system->age[from];
+    system->ageRate[to] = system->ageRate[from];
+    system->size[to] = system->size[from];
+    system->sizeDelta[to] = system->sizeDelta[from];
+    system->colorStart[to] = system->colorStart[from];
+    system->colorEnd[to] = system->colorEnd[from];
+}
+
+void UpdateParticles(ParticleSystem* system, float dt) {
+    int n = system->count;
+    if (n == 0) return;
+    PROFILE_SCOPE("UpdateParticles");
+
+    // Implicit drag stays stable for any dt, unlike v -= v * drag * dt.
+    float damp = 1.0f / (1.0f + system->drag * dt);
+    float fall = system->gravity * dt;
+    int i = 0;
+
+    // The arrays hold whole lanes, so the kernels run the last partial lane
+    // too; the slots past count are scratch and never read back as live.
+#if defined(PARTICLES_SSE2)
+    __m128 vDamp = _mm_set1_ps(damp), vFall = _mm_set1_ps(fall), vDt = _mm_set1_ps(dt);
+    for (; i < n; i += PARTICLE_LANES) {
+        __m128 vx = _mm_mul_ps(_mm_load_ps(system->vx + i), vDamp);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_load_ps(system->vy + i), vFall), vDamp);
+        _mm_store_ps(system->vx + i, vx);
+        _mm_store_ps(system->vy + i, vy);
+        _mm_store_ps(system->x + i, _mm_add_ps(_mm_load_ps(system->x + i), _mm_mul_ps(vx, vDt)));
+        _mm_store_ps(system->y + i, _mm_add_ps(_mm_load_ps(system->y + i), _mm_mul_ps(vy, vDt)));
+        _mm_store_ps(system->age + i,
+                     _mm_add_ps(_mm_load_ps(system->age + i), _mm_mul_ps(_mm_load_ps(system->ageRate + i), vDt)));
+    }
+#elif defined(PARTICLES_NEON)
+    float32x4_t vDamp = vdupq_n_f32(damp), vFall = vdupq_n_f32(fall), vDt = vdupq_n_f32(dt);
+    for (; i < n; i += PARTICLE_LANES) {
+        float32x4_t vx = vmulq_f32(vld1q_f32(system->vx + i), vDamp);
+        float32x4_t vy = vmulq_f32(vaddq_f32(vld1q_f32(system->vy + i), vFall), vDamp);
+        vst1q_f32(system->vx + i, vx);
+        vst1q_f32(system->vy + i, vy);
+        vst1q_f32(system->x + i, vmlaq_f32(vld1q_f32(system->x + i), vx, vDt));
+        vst1q_f32(system->y + i, vmlaq_f32(vld1q_f32(system->y + i), vy, vDt));
+        vst1q_f32(system->age + i, vmlaq_f32(vld1q_f32(system->age + i), vld1q_f32(system->ageRate + i), vDt));
+    }
+#else
+    for (; i < n; i++) {
+        system->vx[i] *= damp;
+        system->vy[i] = (system->vy[i] + fall) * damp;
+        system->x[i] += system->vx[i] * dt;
+        system->y[i] += system->vy[i] * dt;
+        system->age[i] += system->ageRate[i] * dt;
+    }
+#endif
+
+    // Retire from the back, so the particle swapped into a dead slot has
+    // already been checked and is alive.
+    for (i = n - 1; i >= 0; i--) {
+        if (system->age[i] < 1.0f) continue;
+        if (i != n - 1) MoveParticle(system, i, n - 1);
+        n--;
+    }
+    system->count = n;
+}
+
+void DrawParticles(const ParticleSystem* system) {
+    int n = system->count;
+    if (n == 0) return;
+    PROFILE_SCOPE("DrawParticles");
+
+    unsigned int textureId = system->texture.id;
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (textureId == 0) {
+        textureId = rlGetTextureIdDefault();
+    } else {
+        float w = (float)system->texture.width, h = (float)system->texture.height;
+        u0 = system->source.x / w;
+        v0 = system->source.y / h;
+        u1 = (system->source.x + system->source.width) / w;
+        v1 = (system->source.y + system->source.height) / h;
+    }
+
+    rlSetTexture(textureId);
+    AddMetricCount(METRIC_DRAW_CALLS, (n + PARTICLE_DRAW_CHUNK - 1) / PARTICLE_DRAW_CHUNK);
+    for (int start = 0; start < n; start += PARTICLE_DRAW_CHUNK) {
+        int end = start + PARTICLE_DRAW_CHUNK < n ? start + PARTICLE_DRAW_CHUNK : n;
+        rlCheckRenderBatchLimit((end - start) * 4);
+
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = start; i < end; i++) {
+            float t = system->age[i];
+            float half = 0.5f * (system->size[i] + system->sizeDelta[i] * t);
+            int t8 = (int)(t * 256.0f);
+            uint32_t from = system->colorStart[i], to = system->colorEnd[i];
+            float x0 = system->x[i] - half, y0 = system->y[i] - half;
+            float x1 = system->x[i] + half, y1 = system->y[i] + half;
+
+            rlColor4ub(LerpChannel(from, to, 0, t8), LerpChannel(from, to, 8, t8),
+                       LerpChannel(from, to, 16, t8), LerpChannel(from, to, 24, t8));
+            rlTexCoord2f(u0, v0);
+            rlVertex2f(x0, y0);
+            rlTexCoord2f(u0, v1);
+            rlVertex2f(x0, y1);
+            rlTexCoord2f(u1, v1);
+            rlVertex2f(x1, y1);
+            rlTexCoord2f(u1, v0);
+            rlVertex2f(x1, y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
@@ -0,0 +1,65 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/plugin.h"
+#include "raylib.h"
+#include <stddef.h>
+
+#if defined(_WIN32)
+// windows.h clashes with raylib's names, so declare the three calls needed.
+typedef int (__stdcall* ModuleProc)(void);
+__declspec(dllimport) void* __stdcall LoadLibraryA(const char* fileName);
+__declspec(dllimport) ModuleProc __stdcall GetProcAddress(void* module, const char* name);
+__declspec(dllimport) int __stdcall FreeLibrary(void* module);
+
+static void* OpenModule(const char* fileName) { return LoadLibraryA(fileName); }
+static void* FindModuleSymbol(void* handle, const char* name) { return (void*)GetProcAddress(handle, name); }
+static void CloseModule(void* handle) { FreeLibrary(handle); }
+static const char* GetModuleError(void) { return "cannot load the library"; }
+#else
+#include <dlfcn.h>
+
+// Local binding keeps each game's symbols to itself, so two games may
+// define the same names.
+static void* OpenModule(const char* fileName) { return dlopen(fileName, RTLD_NOW | RTLD_LOCAL); }
+static void* FindModuleSymbol(void* handle, const char* name) { return dlsym(handle, name); }
+static void CloseModule(void* handle) { dlclose(handle); }
+static const char* GetModuleError(void) {
+    const char* error = dlerror();
+    return error != NULL ? error : "unknown error";
+}
+#endif
+
+// Loads a game module and looks up its plugin. On failure the module is
+// closed again and plugin is NULL.
+GameModule LoadGameModule(const char* fileName) {
+    GameModule module = {0};
+    module.handle = OpenModule(fileName);
+    if (module.handle == NULL) {
+        TraceLog(LOG_WARNING, "PLUGIN: [%s] Cannot load module: %s", fileName, GetModuleError());
+        return module;
+    }
+
+    // Function and object pointers convert through the symbol's address.
+    GamePluginEntry entry = NULL;
+    void* symbol = FindModuleSymbol(module.handle, GAME_PLUGIN_ENTRY);
+    *(void**)&entry = symbol;
+    const GamePlugin* plugin = entry != NULL ? entry() : NULL;
+    if (plugin == NULL || plugin->run == NULL) {
+        TraceLog(LOG_WARNING, "PLUGIN: [%s] No %s entry point", fileName, GAME_PLUGIN_ENTRY);
+    } else if (plugin->abiVersion != GAME_PLUGIN_ABI_VERSION) {
+        TraceLog(LOG_WARNING, "PLUGIN: [%s] Built for plugin ABI %u, this host uses %u",
+                 fileName, plugin->abiVersion, GAME_PLUGIN_ABI_VERSION);
+    } else {
+        module.plugin = plugin;
+        TraceLog(LOG_INFO, "PLUGIN: [%s] Loaded %s", fileName, plugin->name != NULL ? plugin->name : "game");
+        return module;
+    }
+    CloseModule(module.handle);
+    return (GameModule){0};
+}
+
+// The game must have returned from run; nothing it created outlives that.
+void UnloadGameModule(GameModule* module) {
+    if (module->handle != NULL) CloseModule(module->handle);
+    *module = (GameModule){0};
+}
@@ -0,0 +1,131 @@
+#include "corelib/pool.h"
+#include "corelib/metrics.h"
+#include "raylib.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_INDEX_MASK ((uint32_t)POOL_MAX_CAPACITY - 1u)
+
+static void* AllocArray(Arena* arena, size_t count, size_t size) {
+    if (count * size == 0) return NULL;
+    return arena ? ArenaAlloc(arena, count * size) : malloc(count * size);
+}
+
+static PoolHandle MakeHandle(int slot, uint16_t generation) {
+    return ((uint32_t)generation << POOL_INDEX_BITS) | (uint32_t)slot;
+}
+
+ObjectPool CreateObjectPool(Arena* arena, int capacity, size_t itemSize) {
+    ObjectPool pool = {0};
+    if (capacity < 1 || capacity > POOL_MAX_CAPACITY) {
+        TraceLog(LOG_WARNING, "POOL: Capacity %d is out of range (1 to %d)", capacity, POOL_MAX_CAPACITY);
+        return pool;
+    }
+
+    pool.ownsMemory = (arena == NULL);
+    pool.items = AllocArray(arena, (size_t)capacity, itemSize);
+    pool.handles = AllocArray(arena, (size_t)capacity, sizeof(PoolHandle));
+    pool.slots = AllocArray(arena, (size_t)capacity, sizeof(int));
+    pool.generations = AllocArray(arena, (size_t)capacity, sizeof(uint16_t));
+    if ((itemSize > 0 && !pool.items) || !pool.handles || !pool.slots || !pool.generations) {
+        DestroyObjectPool(&pool);
+        return pool;
+    }
+
+    pool.itemSize = itemSize;
+    pool.capacity = capacity;
+    for (int i = 0; i < capacity; i++) pool.generations[i] = 1;
+    ClearObjectPool(&pool);
+    if (pool.ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return pool;
+}
+
+void DestroyObjectPool(ObjectPool* pool) {
+    AddMetricGauge(METRIC_POOL_OBJECTS, -pool->count);
+    if (pool->ownsMemory && pool->capacity > 0) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (pool->ownsMemory) {
+        free(pool->items);
+        free(pool->handles);
+        free(pool->slots);
+        free(pool->generations);
+    }
+    *pool = (ObjectPool){0};
+}
+
+void ClearObjectPool(ObjectPool* pool) {
+    // Retire the live handles before the slots go back on the free list.
+    for (int i = 0; i < pool->count; i++) {
+        int slot = (int)(pool->handles[i] & POOL_INDEX_MASK);
+        if (++pool->generations[slot] == 0) pool->generations[slot] = 1;
+    }
+    for (int i = 0; i < pool->capacity; i++) pool->slots[i] = i + 1 < pool->capacity ? i + 1 : -1;
+    pool->freeSlot = pool->capacity > 0 ? 0 : -1;
+    AddMetricGauge(METRIC_POOL_OBJECTS, -pool->count);
+    pool->count = 0;
+}
+
+PoolHandle AcquirePoolObject(ObjectPool* pool) {
+    int slot = pool->freeSlot;
+    if (slot < 0) return POOL_INVALID;
+    pool->freeSlot = pool->slots[slot];
+
+    int index = pool->count++;
+    PoolHandle handle = MakeHandle(slot, pool->generations[slot]);
+    pool->slots[slot] = index;
+    pool->handles[index] = handle;
+    if (pool->itemSize > 0) memset(pool->items + (size_t)index * pool->itemSize, 0, pool->itemSize);
+    AddMetricGauge(METRIC_POOL_OBJECTS, 1);
+    return handle;
+}
+
+// Returns the dense index that was vacated and refilled from the end, so the
+// caller can make the same move in its own arrays, or -1 for a stale handle.
+int ReleasePoolObject(ObjectPool* pool, PoolHandle handle) {
+    int index = GetPoolIndex(pool, handle);
+    if (index < 0) return -1;
+
+    int last = --pool->count;
+    AddMetricGauge(METRIC_POOL_OBJECTS, -1);
+    if (index != last) {
+        PoolHandle moved = pool->handles[last];
+        pool->handles[index] = moved;
+        pool->slots[moved & POOL_INDEX_MASK] = index;
+        if (pool->itemSize > 0) {
+            memcpy(pool->items + (size_t)index * pool->itemSize, pool->items + (size_t)last * pool->itemSize, pool->itemSize);
+        }
+    }
+
+    // Generation 0 is skipped so no handle ever equals POOL_INVALID.
+    int slot = (int)(handle & POOL_INDEX_MASK);
+    if (++pool->generations[slot] == 0) pool->generations[slot] = 1;
+    pool->slots[slot] = pool->freeSlot;
+    pool->freeSlot = slot;
+    return index;
+}
+
+bool IsPoolHandleValid(const ObjectPool* pool, PoolHandle handle) {
+    return GetPoolIndex(pool, handle) >= 0;
+}
+
+int GetPoolIndex(const ObjectPool* pool, PoolHandle handle) {
+    int slot = (int)(handle & POOL_INDEX_MASK);
+    if (handle == POOL_INVALID || slot >= pool->capacity) return -1;
+    // A free slot holds a free-list link, so also confirm the dense entry points back.
+    int index = pool->slots[slot];
+    if (index < 0 || index >= pool->count || pool->handles[index] != handle) return -1;
+    return index;
+}
+
+PoolHandle GetPoolHandle(const ObjectPool* pool, int index) {
+    if (index < 0 || index >= pool->count) return POOL_INVALID;
+    return pool->handles[index];
+}
+
+void* GetPoolObject(ObjectPool* pool, PoolHandle handle) {
+    return GetPoolObjectAt(pool, GetPoolIndex(pool, handle));
+}
+
+void* GetPoolObjectAt(ObjectPool* pool, int index) {
+    if (pool->itemSize == 0 || index < 0 || index >= pool->count) return NULL;
+    return pool->items + (size_t)index * pool->itemSize;
+}
@@ -0,0 +1,248 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "corelib/profiler.h"
+#include "corelib/clock.h"
+#include "raylib.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILER_MAX_THREADS 64
+
+typedef struct {
+    ProfilerEvent events[PROFILER_RING_SIZE];
+    _Atomic uint64_t head;                      // Events written in total.
+    uint64_t stackStart[PROFILER_MAX_DEPTH];
+    const char* stackName[PROFILER_MAX_DEPTH];
+    int depth;
+    int threadId;
+} ProfilerThread;
+
+// A thread's block goes back on the free list when the thread exits and the
+// next new thread takes it over, so short-lived workers do not use up the
+// slots. Its older events stay in the ring under the same track.
+static _Thread_local ProfilerThread* currentThread = NULL;
+static ProfilerThread* threads[PROFILER_MAX_THREADS];
+static bool threadFree[PROFILER_MAX_THREADS];
+static int threadCount = 0;
+static pthread_mutex_t threadLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t threadKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t threadKey;
+static uint64_t traceOrigin = 0;
+
+// Frame state, owned by the thread that calls ProfilerFrameMark.
+static ProfilerStats stats = {0};
+static uint64_t frameStart = 0;
+
+static void ReleaseThread(void* block) {
+    pthread_mutex_lock(&threadLock);
+    for (int i = 0; i < threadCount; i++) {
+        if (threads[i] == block) threadFree[i] = true;
+    }
+    pthread_mutex_unlock(&threadLock);
+}
+
+static void CreateThreadKey(void) {
+    pthread_key_create(&threadKey, ReleaseThread);
+}
+
+static ProfilerThread* GetThread(void) {
+    if (currentThread != NULL) return currentThread;
+    pthread_once(&threadKeyOnce, CreateThreadKey);
+
+    pthread_mutex_lock(&threadLock);
+    ProfilerThread* t = NULL;
+    for (int i = 0; i < threadCount && t == NULL; i++) {
+        if (!threadFree[i]) continue;
+        threadFree[i] = false;
+        t = threads[i];
+        t->depth = 0;       // The last owner may have exited inside a zone.
+    }
+    if (t == NULL && threadCount < PROFILER_MAX_THREADS) {
+        t = calloc(1, sizeof(ProfilerThread));
+        if (t != NULL) {
+            t->threadId = threadCount;
+            threads[threadCount++] = t;
+            if (traceOrigin == 0) traceOrigin = GetClockNanos();
+        }
+    }
+    pthread_mutex_unlock(&threadLock);
+
+    if (t != NULL) pthread_setspecific(threadKey, t);
+    currentThread = t;
+    return currentThread;
+}
+
+void ProfilerBeginZone(const char* name) {
+    ProfilerThread* t = GetThread();
+    if (t == NULL) return;
+    if (t->depth < PROFILER_MAX_DEPTH) {
+        t->stackName[t->depth] = name;
+        t->stackStart[t->depth] = GetClockNanos();
+    }
+    t->depth++;
+}
+
+void ProfilerEndZone(void) {
+    uint64_t end = GetClockNanos();
+    ProfilerThread* t = currentThread;
+    if (t == NULL || t->depth == 0) return;
+
+    int depth = --t->depth;
+    if (depth >= PROFILER_MAX_DEPTH) return;
+
+    // Publish the event only once it is written, since other threads total it.
+    uint64_t head = atomic_load_explicit(&t->head, memory_order_relaxed);
+    ProfilerEvent* e = &t->events[head % PROFILER_RING_SIZE];
+    e->name = t->stackName[depth];
+    e->start = t->stackStart[depth];
+    e->end = end;
+    e->depth = depth;
+    atomic_store_explicit(&t->head, head + 1, memory_order_release);
+}
+
+static int CompareFloats(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static ProfilerZoneStats* FindZone(const char* name) {
+    for (int i = 0; i < stats.zoneCount; i++) {
+        if (stats.zones[i].name == name || strcmp(stats.zones[i].name, name) == 0) return &stats.zones[i];
+    }
+    if (stats.zoneCount >= PROFILER_MAX_ZONES) return NULL;
+    ProfilerZoneStats* zone = &stats.zones[stats.zoneCount++];
+    *zone = (ProfilerZoneStats){ .name = name, .avgMs = -1.0f };
+    return zone;
+}
+
+// Adds the zones a thread closed in [from, to). Each ring is in end order,
+// so the walk goes back from the newest event and stops at the first older
+// one. It stays half a ring behind the writer so no slot it reads is reused.
+static void TotalThreadZones(ProfilerThread* t, uint64_t from, uint64_t to) {
+    uint64_t head = atomic_load_explicit(&t->head, memory_order_acquire);
+    uint64_t oldest = (head > PROFILER_RING_SIZE / 2) ? head - PROFILER_RING_SIZE / 2 : 0;
+    for (uint64_t i = head; i > oldest; i--) {
+        ProfilerEvent e = t->events[(i - 1) % PROFILER_RING_SIZE];
+        if (e.end < from) break;
+        if (e.end >= to || e.end < e.start) continue;
+        ProfilerZoneStats* zone = FindZone(e.name);
+        if (zone == NULL) continue;
+        zone->ms += (float)(e.end - e.start) * 1e-6f;
+        zone->calls++;
+    }
+}
+
+void ProfilerFrameMark(void) {
+    uint64_t now = GetClockNanos();
+    ProfilerThread* t = GetThread();
+    if (t == NULL) return;
+
+    if (frameStart != 0) {
+        stats.frameMs[stats.frameCount % PROFILER_HISTORY] = (float)(now - frameStart) * 1e-6f;
+        stats.frameCount++;
+
+        // Total up the zones every thread closed during the frame, so work
+        // handed to job workers shows up next to the main thread's.
+        for (int i = 0; i < stats.zoneCount; i++) {
+            stats.zones[i].ms = 0.0f;
+            stats.zones[i].calls = 0;
+        }
+        pthread_mutex_lock(&threadLock);
+        for (int i = 0; i < threadCount; i++) TotalThreadZones(threads[i], frameStart, now);
+        pthread_mutex_unlock(&threadLock);
+        for (int i = 0; i < stats.zoneCount; i++) {
+            ProfilerZoneStats* zone = &stats.zones[i];
+            zone->avgMs = (zone->avgMs < 0.0f) ? zone->ms : zone->avgMs * 0.95f + zone->ms * 0.05f;
+        }
+
+        // Percentiles over the recent history.
+        int n = (stats.frameCount < PROFILER_HISTORY) ? stats.frameCount : PROFILER_HISTORY;
+        float sorted[PROFILER_HISTORY];
+        memcpy(sorted, stats.frameMs, sizeof(float) * (size_t)n);
+        qsort(sorted, (size_t)n, sizeof(float), CompareFloats);
+        stats.p50Ms = sorted[n / 2];
+        stats.p99Ms = sorted[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+        stats.maxMs = sorted[n - 1];
+    }
+
+    frameStart = now;
+}
+
+const ProfilerStats* GetProfilerStats(void) {
+    return &stats;
+}
+
+void DrawProfilerOverlay(int x, int y) {
+    const int width = 300;
+    const int lineHeight = 14;
+    const int graphHeight = 60;
+    int height = 8 + lineHeight * (stats.zoneCount + 1) + graphHeight + 8;
+
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.75f));
+    DrawText(TextFormat("frame  p50 %.2f  p99 %.2f  max %.2f ms", stats.p50Ms, stats.p99Ms, stats.maxMs),
+             x + 6, y + 4, 10, WHITE);
+
+    for (int i = 0; i < stats.zoneCount; i++) {
+        const ProfilerZoneStats* zone = &stats.zones[i];
+        int ly = y + 4 + lineHeight * (i + 1);
+        DrawText(zone->name, x + 6, ly, 10, LIGHTGRAY);
+        DrawText(TextFormat("%6.2f ms  avg %6.2f  x%d", zone->ms, zone->avgMs, zone->calls), x + 140, ly, 10, LIGHTGRAY);
+    }
+
+    // Frame-time histogram, newest on the right, scaled to at least 33 ms.
+    int gx = x + 6;
+    int gy = y + 8 + lineHeight * (stats.zoneCount + 1);
+    int gw = width - 12;
+    float scale = (stats.maxMs > 33.3f) ? stats.maxMs : 33.3f;
+    int n = (stats.frameCount < PROFILER_HISTORY) ? stats.frameCount : PROFILER_HISTORY;
+    float barWidth = (float)gw / PROFILER_HISTORY;
+    for (int i = 0; i < n; i++) {
+        float ms = stats.frameMs[(stats.frameCount - n + i) % PROFILER_HISTORY];
+        int bh = (int)(ms / scale * graphHeight);
+        if (bh > graphHeight) bh = graphHeight;
+        Color color = (ms <= 16.7f) ? GREEN : (ms <= 33.3f) ? YELLOW : RED;
+        int bx = gx + (int)((PROFILER_HISTORY - n + i) * barWidth);
+        DrawRectangle(bx, gy + graphHeight - bh, (barWidth >= 2.0f) ? (int)barWidth - 1 : 1, bh, color);
+    }
+    int budgetY = gy + graphHeight - (int)(16.7f / scale * graphHeight);
+    DrawLine(gx, budgetY, gx + gw, budgetY, Fade(WHITE, 0.5f));
+}
+
+bool WriteProfilerChromeTrace(const char* fileName) {
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "PROFILER: [%s] Failed to open trace file", fileName);
+        return false;
+    }
+
+    // Threads keep recording while this runs; events overwritten mid-dump
+    // may come out torn, which the trace viewer tolerates.
+    fputs("{\"traceEvents\":[\n", file);
+    bool first = true;
+    int written = 0;
+    pthread_mutex_lock(&threadLock);
+    for (int ti = 0; ti < threadCount; ti++) {
+        const ProfilerThread* t = threads[ti];
+        uint64_t head = atomic_load_explicit(&t->head, memory_order_acquire);
+        uint64_t from = (head > PROFILER_RING_SIZE) ? head - PROFILER_RING_SIZE : 0;
+        for (uint64_t i = from; i < head; i++) {
+            const ProfilerEvent* e = &t->events[i % PROFILER_RING_SIZE];
+            if (e->start < traceOrigin || e->end < e->start) continue;
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    first ? "" : ",\n", e->name, t->threadId,
+                    (double)(e->start - traceOrigin) * 1e-3, (double)(e->end - e->start) * 1e-3);
+            first = false;
+            written++;
+        }
+    }
+    pthread_mutex_unlock(&threadLock);
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+    fclose(file);
+
+    TraceLog(LOG_INFO, "PROFILER: [%s] Wrote %d zone events", fileName, written);
+    return true;
+}
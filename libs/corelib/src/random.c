@@ -0,0 +1,50 @@
+#include "corelib/random.h"
+#include <math.h>
+
+// splitmix64 scrambles the seed so that nearby seeds give unrelated streams.
+static uint64_t SplitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+Rng CreateRng(uint64_t seed) {
+    Rng rng = {0};
+    rng.state = SplitMix64(seed);
+    if (rng.state == 0) rng.state = 0x9E3779B97F4A7C15ull;
+    return rng;
+}
+
+// xorshift64* generator, returning the high 32 bits.
+uint32_t NextRandom(Rng* rng) {
+    uint64_t x = rng->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng->state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+int RandomRange(Rng* rng, int min, int max) {
+    if (min > max) {
+        int tmp = min;
+        min = max;
+        max = tmp;
+    }
+    uint32_t span = (uint32_t)((int64_t)max - (int64_t)min + 1);
+    if (span == 0) return (int)NextRandom(rng);
+    return min + (int)(((uint64_t)NextRandom(rng) * span) >> 32);
+}
+
+float RandomFloat(Rng* rng) {
+    return (float)(NextRandom(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+// Box-Muller transform; the second value of each pair is dropped to keep
+// the generator stateless beyond its seed.
+float RandomNormal(Rng* rng) {
+    float u1 = ((float)(NextRandom(rng) >> 8) + 1.0f) * (1.0f / 16777217.0f);
+    float u2 = RandomFloat(rng);
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.28318530718f * u2);
+}
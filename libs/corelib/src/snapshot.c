@@ -0,0 +1,120 @@
+#include "corelib/snapshot.h"
+#include "corelib/metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+Snapshot CreateSnapshot(Arena* arena, size_t capacity) {
+    Snapshot snap = {0};
+    if (capacity < SNAPSHOT_HEADER_SIZE) capacity = SNAPSHOT_HEADER_SIZE;
+    snap.data = arena ? ArenaAlloc(arena, capacity) : malloc(capacity);
+    if (snap.data == NULL) return snap;
+    snap.capacity = capacity;
+    snap.ownsMemory = (arena == NULL);
+    if (snap.ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return snap;
+}
+
+void DestroySnapshot(Snapshot* snap) {
+    if (snap->ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (snap->ownsMemory) free(snap->data);
+    *snap = (Snapshot){0};
+}
+
+// FNV-1a over 8-byte words with a fold after each, then the tail bytes.
+// Cheap enough to run on every save, and enough to tell two states apart.
+static uint32_t ChecksumBytes(const unsigned char* p, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, p + i, sizeof(word));
+        hash = (hash ^ word) * 1099511628211ull;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; i++) hash = (hash ^ p[i]) * 1099511628211ull;
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static uint32_t ReadHeaderU32(const Snapshot* snap, size_t offset) {
+    uint32_t value;
+    memcpy(&value, snap->data + offset, sizeof(value));
+    return value;
+}
+
+// Starts a save over whatever the buffer held. The header is written by
+// EndSnapshot, once the size is known.
+void BeginSnapshotSave(Snapshot* snap, uint32_t version) {
+    snap->loading = false;
+    snap->failed = snap->data == NULL;
+    snap->size = 0;
+    snap->cursor = SNAPSHOT_HEADER_SIZE;
+    if (!snap->failed) memcpy(snap->data + 4, &version, sizeof(version));
+}
+
+// Starts loading the last snapshot saved. Returns false, touching nothing,
+// if there is none or it was saved with another version or got damaged.
+bool BeginSnapshotLoad(Snapshot* snap, uint32_t version) {
+    snap->loading = true;
+    snap->cursor = SNAPSHOT_HEADER_SIZE;
+    snap->failed = snap->size < SNAPSHOT_HEADER_SIZE || snap->size > snap->capacity
+                || ReadHeaderU32(snap, 0) != SNAPSHOT_MAGIC || ReadHeaderU32(snap, 4) != version
+                || ReadHeaderU32(snap, 8) != snap->size
+                || ReadHeaderU32(snap, 12) != ChecksumBytes(snap->data + SNAPSHOT_HEADER_SIZE, snap->size - SNAPSHOT_HEADER_SIZE);
+    return !snap->failed;
+}
+
+// Finishes a save or load. Returns false if anything overflowed, ran short
+// or was left over; a failed save leaves no snapshot to load.
+bool EndSnapshot(Snapshot* snap) {
+    if (snap->loading) {
+        if (snap->cursor != snap->size) snap->failed = true;
+        return !snap->failed;
+    }
+    if (snap->failed) {
+        snap->size = 0;
+        return false;
+    }
+    uint32_t magic = SNAPSHOT_MAGIC;
+    uint32_t size = (uint32_t)snap->cursor;
+    uint32_t checksum = ChecksumBytes(snap->data + SNAPSHOT_HEADER_SIZE, snap->cursor - SNAPSHOT_HEADER_SIZE);
+    memcpy(snap->data, &magic, sizeof(magic));
+    memcpy(snap->data + 8, &size, sizeof(size));
+    memcpy(snap->data + 12, &checksum, sizeof(checksum));
+    snap->size = snap->cursor;
+    return true;
+}
+
+void SnapshotBytes(Snapshot* snap, void* data, size_t size) {
+    if (snap->failed) return;
+    size_t end = snap->loading ? snap->size : snap->capacity;
+    if (size > end - snap->cursor) {
+        snap->failed = true;
+        return;
+    }
+    if (snap->loading) memcpy(data, snap->data + snap->cursor, size);
+    else memcpy(snap->data + snap->cursor, data, size);
+    snap->cursor += size;
+}
+
+// Saves or loads an arena's used bytes and its offset. The arena must be
+// the one the snapshot was taken from, so pointers into it stay valid.
+void SnapshotArena(Snapshot* snap, Arena* arena) {
+    size_t offset = arena->offset;
+    SNAPSHOT_VALUE(snap, offset);
+    if (snap->failed) return;
+    if (snap->loading && offset > arena->size) {
+        snap->failed = true;
+        return;
+    }
+    SnapshotBytes(snap, arena->base, offset);
+    if (snap->loading && !snap->failed) {
+        arena->offset = offset;
+        if (arena->peak < offset) arena->peak = offset;
+    }
+}
+
+// The checksum of the last snapshot saved, which two peers can compare to
+// find out whether their simulations diverged.
+uint32_t GetSnapshotChecksum(const Snapshot* snap) {
+    return snap->size >= SNAPSHOT_HEADER_SIZE ? ReadHeaderU32(snap, 12) : 0;
+}
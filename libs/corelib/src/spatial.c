@@ -0,0 +1,189 @@
+#include "corelib/spatial.h"
+#include "corelib/metrics.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void* AllocArray(Arena* arena, size_t count, size_t size) {
+    return arena ? ArenaAlloc(arena, count * size) : malloc(count * size);
+}
+
+static int HashCell(const SpatialHash* hash, int cx, int cy) {
+    uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u;
+    return (int)(h & (uint32_t)hash->bucketMask);
+}
+
+static int CellCoord(const SpatialHash* hash, float v) {
+    return (int)floorf(v * hash->invCellSize);
+}
+
+SpatialHash CreateSpatialHash(Arena* arena, int maxEntries, int maxLinks, float cellSize) {
+    SpatialHash hash = {0};
+    if (maxEntries < 1) maxEntries = 1;
+    if (maxLinks < maxEntries) maxLinks = maxEntries;
+
+    // About one bucket per link keeps the chains short.
+    int bucketCount = 16;
+    while (bucketCount < maxLinks) bucketCount <<= 1;
+
+    hash.ownsMemory = (arena == NULL);
+    hash.buckets = AllocArray(arena, (size_t)bucketCount, sizeof(int));
+    hash.entries = AllocArray(arena, (size_t)maxEntries, sizeof(SpatialEntry));
+    hash.links = AllocArray(arena, (size_t)maxLinks, sizeof(SpatialLink));
+    if (!hash.buckets || !hash.entries || !hash.links) {
+        DestroySpatialHash(&hash);
+        return hash;
+    }
+
+    hash.cellSize = cellSize;
+    hash.invCellSize = 1.0f / cellSize;
+    hash.bucketMask = bucketCount - 1;
+    hash.entryCapacity = maxEntries;
+    hash.linkCapacity = maxLinks;
+    ClearSpatialHash(&hash);
+    if (hash.ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return hash;
+}
+
+void DestroySpatialHash(SpatialHash* hash) {
+    if (hash->ownsMemory && hash->entryCapacity > 0) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (hash->ownsMemory) {
+        free(hash->buckets);
+        free(hash->entries);
+        free(hash->links);
+    }
+    *hash = (SpatialHash){0};
+}
+
+void ClearSpatialHash(SpatialHash* hash) {
+    for (int i = 0; i <= hash->bucketMask; i++) hash->buckets[i] = -1;
+    for (int i = 0; i < hash->entryCapacity; i++) hash->entries[i] = (SpatialEntry){ .firstLink = -1 };
+    for (int i = 0; i < hash->linkCapacity; i++) hash->links[i].next = i + 1 < hash->linkCapacity ? i + 1 : -1;
+    hash->freeLink = hash->linkCapacity > 0 ? 0 : -1;
+    hash->queryStamp = 0;
+}
+
+static void UnlinkEntry(SpatialHash* hash, SpatialEntry* e) {
+    int l = e->firstLink;
+    while (l >= 0) {
+        SpatialLink* link = &hash->links[l];
+        if (link->prev >= 0) hash->links[link->prev].next = link->next;
+        else hash->buckets[link->bucket] = link->next;
+        if (link->next >= 0) hash->links[link->next].prev = link->prev;
+
+        int nextOfEntry = link->nextOfEntry;
+        link->next = hash->freeLink;
+        hash->freeLink = l;
+        l = nextOfEntry;
+    }
+    e->firstLink = -1;
+}
+
+static bool LinkEntry(SpatialHash* hash, int id) {
+    SpatialEntry* e = &hash->entries[id];
+    for (int cy = e->minY; cy <= e->maxY; cy++) {
+        for (int cx = e->minX; cx <= e->maxX; cx++) {
+            int l = hash->freeLink;
+            if (l < 0) {
+                TraceLog(LOG_WARNING, "SPATIAL: Link pool exhausted (%d links)", hash->linkCapacity);
+                return false;
+            }
+            SpatialLink* link = &hash->links[l];
+            hash->freeLink = link->next;
+
+            int bucket = HashCell(hash, cx, cy);
+            *link = (SpatialLink){ .entry = id, .bucket = bucket, .prev = -1, .next = hash->buckets[bucket],
+                                   .nextOfEntry = e->firstLink };
+            if (link->next >= 0) hash->links[link->next].prev = l;
+            hash->buckets[bucket] = l;
+            e->firstLink = l;
+        }
+    }
+    return true;
+}
+
+bool SetSpatialEntry(SpatialHash* hash, int id, Rectangle bounds) {
+    if (id < 0 || id >= hash->entryCapacity) return false;
+    SpatialEntry* e = &hash->entries[id];
+
+    int minX = CellCoord(hash, bounds.x);
+    int minY = CellCoord(hash, bounds.y);
+    int maxX = CellCoord(hash, bounds.x + bounds.width);
+    int maxY = CellCoord(hash, bounds.y + bounds.height);
+    e->bounds = bounds;
+
+    // Most moves stay inside the same cells and only need the new box.
+    if (e->active && minX == e->minX && minY == e->minY && maxX == e->maxX && maxY == e->maxY) return true;
+
+    UnlinkEntry(hash, e);
+    e->minX = minX;
+    e->minY = minY;
+    e->maxX = maxX;
+    e->maxY = maxY;
+    e->active = true;
+    if (LinkEntry(hash, id)) return true;
+
+    UnlinkEntry(hash, e);
+    e->active = false;
+    return false;
+}
+
+void RemoveSpatialEntry(SpatialHash* hash, int id) {
+    if (id < 0 || id >= hash->entryCapacity || !hash->entries[id].active) return;
+    UnlinkEntry(hash, &hash->entries[id]);
+    hash->entries[id].active = false;
+}
+
+static bool RecsOverlap(Rectangle a, Rectangle b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+static bool CircleOverlapsRec(Vector2 c, float r, Rectangle rec) {
+    float dx = c.x - fminf(fmaxf(c.x, rec.x), rec.x + rec.width);
+    float dy = c.y - fminf(fmaxf(c.y, rec.y), rec.y + rec.height);
+    return dx * dx + dy * dy < r * r;
+}
+
+// Visits the cells under area and reports each entry that passes the test
+// once. A circle query passes its radius; a box query passes a negative one.
+static int Query(SpatialHash* hash, Rectangle area, Vector2 center, float radius, int* ids, int maxIds) {
+    // Restart the stamps before they wrap, so stale ones never match.
+    if (++hash->queryStamp == 0) {
+        for (int i = 0; i < hash->entryCapacity; i++) hash->entries[i].stamp = 0;
+        hash->queryStamp = 1;
+    }
+    uint32_t stamp = hash->queryStamp;
+
+    int minX = CellCoord(hash, area.x);
+    int minY = CellCoord(hash, area.y);
+    int maxX = CellCoord(hash, area.x + area.width);
+    int maxY = CellCoord(hash, area.y + area.height);
+
+    int found = 0;
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            for (int l = hash->buckets[HashCell(hash, cx, cy)]; l >= 0; l = hash->links[l].next) {
+                int id = hash->links[l].entry;
+                SpatialEntry* e = &hash->entries[id];
+                if (e->stamp == stamp) continue;
+
+                // Buckets mix cells, so filter on the exact box.
+                bool hit = radius >= 0.0f ? CircleOverlapsRec(center, radius, e->bounds) : RecsOverlap(area, e->bounds);
+                if (!hit) continue;
+                e->stamp = stamp;
+                if (found < maxIds) ids[found] = id;
+                found++;
+            }
+        }
+    }
+    return found < maxIds ? found : maxIds;
+}
+
+int QuerySpatialRec(SpatialHash* hash, Rectangle area, int* ids, int maxIds) {
+    return Query(hash, area, (Vector2){ 0 }, -1.0f, ids, maxIds);
+}
+
+int QuerySpatialCircle(SpatialHash* hash, Vector2 center, float radius, int* ids, int maxIds) {
+    Rectangle area = { center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f };
+    return Query(hash, area, center, radius, ids, maxIds);
+}
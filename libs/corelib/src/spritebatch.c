@@ -0,0 +1,169 @@
+#include "corelib/spritebatch.h"
+#include "corelib/metrics.h"
+#include "corelib/profiler.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Sort key layout: | layer (16) | texture (24) | submit order (24) |
+#define KEY_ORDER_BITS 24
+#define KEY_TEXTURE_BITS 24
+#define KEY_INDEX_MASK ((1ull << KEY_ORDER_BITS) - 1)
+
+static int CompareKeys(const void* a, const void* b) {
+    uint64_t ka = *(const uint64_t*)a;
+    uint64_t kb = *(const uint64_t*)b;
+    return (ka > kb) - (ka < kb);
+}
+
+static uint64_t MakeKey(int layer, unsigned int textureId, int index) {
+    // Bias the layer so negative layers sort below zero.
+    uint64_t l = (uint64_t)((layer + 32768) & 0xFFFF);
+    uint64_t t = (uint64_t)(textureId & ((1u << KEY_TEXTURE_BITS) - 1));
+    return (l << (KEY_TEXTURE_BITS + KEY_ORDER_BITS)) | (t << KEY_ORDER_BITS) | (uint64_t)index;
+}
+
+// Writes the four corners of a quad in rlgl's quad order (TL, BL, BR, TR).
+static void ExpandQuad(const SpriteQuad* q, SpriteVertex* out) {
+    float w = q->dest.width;
+    float h = q->dest.height;
+    float tw = (float)q->textureWidth;
+    float th = (float)q->textureHeight;
+
+    float u0 = q->source.x / tw;
+    float u1 = (q->source.x + fabsf(q->source.width)) / tw;
+    float v0 = q->source.y / th;
+    float v1 = (q->source.y + fabsf(q->source.height)) / th;
+    if (q->source.width < 0) { float t = u0; u0 = u1; u1 = t; }
+    if (q->source.height < 0) { float t = v0; v0 = v1; v1 = t; }
+
+    Vector2 tl, tr, bl, br;
+    if (q->rotation == 0.0f) {
+        float x = q->dest.x - q->origin.x;
+        float y = q->dest.y - q->origin.y;
+        tl = (Vector2){ x, y };
+        tr = (Vector2){ x + w, y };
+        bl = (Vector2){ x, y + h };
+        br = (Vector2){ x + w, y + h };
+    } else {
+        float s = sinf(q->rotation * DEG2RAD);
+        float c = cosf(q->rotation * DEG2RAD);
+        float x = q->dest.x;
+        float y = q->dest.y;
+        float dx = -q->origin.x;
+        float dy = -q->origin.y;
+        tl = (Vector2){ x + dx * c - dy * s, y + dx * s + dy * c };
+        tr = (Vector2){ x + (dx + w) * c - dy * s, y + (dx + w) * s + dy * c };
+        bl = (Vector2){ x + dx * c - (dy + h) * s, y + dx * s + (dy + h) * c };
+        br = (Vector2){ x + (dx + w) * c - (dy + h) * s, y + (dx + w) * s + (dy + h) * c };
+    }
+
+    out[0] = (SpriteVertex){ tl.x, tl.y, u0, v0, q->tint };
+    out[1] = (SpriteVertex){ bl.x, bl.y, u0, v1, q->tint };
+    out[2] = (SpriteVertex){ br.x, br.y, u1, v1, q->tint };
+    out[3] = (SpriteVertex){ tr.x, tr.y, u1, v0, q->tint };
+}
+
+SpriteBatch CreateSpriteBatch(int capacity) {
+    SpriteBatch batch = {0};
+    if (capacity < 1) capacity = 1;
+    if (capacity > (int)KEY_INDEX_MASK) capacity = (int)KEY_INDEX_MASK;
+
+    batch.quads = malloc(sizeof(SpriteQuad) * (size_t)capacity);
+    batch.keys = malloc(sizeof(uint64_t) * (size_t)capacity);
+    batch.vertices = malloc(sizeof(SpriteVertex) * 4 * (size_t)capacity);
+    if (!batch.quads || !batch.keys || !batch.vertices) {
+        DestroySpriteBatch(&batch);
+        return batch;
+    }
+    batch.capacity = capacity;
+    AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return batch;
+}
+
+void DestroySpriteBatch(SpriteBatch* batch) {
+    if (batch->capacity > 0) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    free(batch->quads);
+    free(batch->keys);
+    free(batch->vertices);
+    *batch = (SpriteBatch){0};
+}
+
+void BeginSpriteBatch(SpriteBatch* batch) {
+    batch->count = 0;
+    batch->stats = (SpriteBatchStats){0};
+}
+
+void SubmitSprite(SpriteBatch* batch, Texture2D texture, Rectangle source, Rectangle dest, Color tint, int layer) {
+    SubmitSpritePro(batch, texture, source, dest, (Vector2){ 0, 0 }, 0.0f, tint, layer);
+}
+
+void SubmitSpritePro(SpriteBatch* batch, Texture2D texture, Rectangle source, Rectangle dest,
+                     Vector2 origin, float rotation, Color tint, int layer) {
+    if (batch->capacity == 0 || texture.id == 0) return;
+    if (batch->count >= batch->capacity) FlushSpriteBatch(batch);
+
+    int i = batch->count++;
+    batch->quads[i] = (SpriteQuad){
+        .textureId = texture.id,
+        .textureWidth = texture.width,
+        .textureHeight = texture.height,
+        .source = source,
+        .dest = dest,
+        .origin = origin,
+        .rotation = rotation,
+        .tint = tint,
+    };
+    batch->keys[i] = MakeKey(layer, texture.id, i);
+    batch->stats.sprites++;
+}
+
+void FlushSpriteBatch(SpriteBatch* batch) {
+    int n = batch->count;
+    if (n == 0) return;
+    PROFILE_SCOPE("FlushSpriteBatch");
+    batch->stats.flushes++;
+    int drawCalls = batch->stats.drawCalls;
+
+    // Sort by layer, then texture, keeping submit order inside each run.
+    qsort(batch->keys, (size_t)n, sizeof(uint64_t), CompareKeys);
+    for (int i = 0; i < n; i++) {
+        ExpandQuad(&batch->quads[batch->keys[i] & KEY_INDEX_MASK], &batch->vertices[i * 4]);
+    }
+
+    // Emit one rlgl run per texture change.
+    unsigned int lastTexture = 0;
+    for (int start = 0; start < n;) {
+        unsigned int textureId = batch->quads[batch->keys[start] & KEY_INDEX_MASK].textureId;
+        int end = start + 1;
+        while (end < n && batch->quads[batch->keys[end] & KEY_INDEX_MASK].textureId == textureId) end++;
+
+        if (rlCheckRenderBatchLimit((end - start) * 4)) batch->stats.drawCalls++;
+        if (textureId != lastTexture) {
+            if (lastTexture != 0) batch->stats.textureSwitches++;
+            lastTexture = textureId;
+        }
+
+        rlSetTexture(textureId);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int v = start * 4; v < end * 4; v++) {
+            const SpriteVertex* sv = &batch->vertices[v];
+            rlColor4ub(sv->color.r, sv->color.g, sv->color.b, sv->color.a);
+            rlTexCoord2f(sv->u, sv->v);
+            rlVertex2f(sv->x, sv->y);
+        }
+        rlEnd();
+        batch->stats.drawCalls++;
+
+        start = end;
+    }
+    rlSetTexture(0);
+    AddMetricCount(METRIC_DRAW_CALLS, batch->stats.drawCalls - drawCalls);
+
+    batch->count = 0;
+}
+
+SpriteBatchStats GetSpriteBatchStats(const SpriteBatch* batch) {
+    return batch->stats;
+}
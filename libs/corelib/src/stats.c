@@ -0,0 +1,151 @@
+#include "corelib/stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int CompareDoubles(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+void AddSample(SampleSet* set, double value) {
+    if (set->count == set->capacity) {
+        int capacity = set->capacity ? set->capacity * 2 : 1024;
+        double* values = realloc(set->values, sizeof(double) * (size_t)capacity);
+        if (values == NULL) return;
+        set->values = values;
+        set->capacity = capacity;
+    }
+    set->values[set->count++] = value;
+}
+
+// Nearest-rank percentile over sorted values.
+static double Percentile(const double* sorted, int count, double p) {
+    int rank = (int)(p * (double)count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+SampleSummary SummarizeSamples(SampleSet* set) {
+    SampleSummary summary = {0};
+    if (set->count == 0) return summary;
+
+    qsort(set->values, (size_t)set->count, sizeof(double), CompareDoubles);
+    double sum = 0.0;
+    for (int i = 0; i < set->count; i++) sum += set->values[i];
+
+    summary.count = set->count;
+    summary.mean = sum / (double)set->count;
+    summary.min = set->values[0];
+    summary.p50 = Percentile(set->values, set->count, 0.50);
+    summary.p90 = Percentile(set->values, set->count, 0.90);
+    summary.p99 = Percentile(set->values, set->count, 0.99);
+    summary.max = set->values[set->count - 1];
+    return summary;
+}
+
+void ClearSamples(SampleSet* set) {
+    set->count = 0;
+}
+
+void DestroySampleSet(SampleSet* set) {
+    free(set->values);
+    *set = (SampleSet){0};
+}
+
+// Summarizes the samples under a name; the set is left sorted.
+BenchmarkResult CreateBenchmarkResult(const char* name, const char* unit, SampleSet* set) {
+    BenchmarkResult result = {0};
+    snprintf(result.name, sizeof(result.name), "%s", name);
+    snprintf(result.unit, sizeof(result.unit), "%s", unit);
+    result.summary = SummarizeSamples(set);
+    return result;
+}
+
+bool SaveBenchmarkResults(const char* fileName, const BenchmarkResult* results, int count) {
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL) return false;
+
+    fprintf(file, "{\n  \"results\": [\n");
+    for (int i = 0; i < count; i++) {
+        const SampleSummary* s = &results[i].summary;
+        fprintf(file, "    { \"name\": \"%s\", \"unit\": \"%s\", \"count\": %d, \"mean\": %.6g, \"min\": %.6g, "
+                "\"p50\": %.6g, \"p90\": %.6g, \"p99\": %.6g, \"max\": %.6g }%s\n",
+                results[i].name, results[i].unit, s->count, s->mean, s->min, s->p50, s->p90, s->p99, s->max,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+// Finds "key": in one result object and points past the colon.
+static const char* FindJsonValue(const char* object, const char* key) {
+    char quoted[BENCHMARK_NAME_LENGTH];
+    snprintf(quoted, sizeof(quoted), "\"%s\"", key);
+    const char* p = strstr(object, quoted);
+    if (p == NULL) return NULL;
+    p += strlen(quoted);
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+    return *p == ':' ? p + 1 : NULL;
+}
+
+static bool ReadJsonString(const char* object, const char* key, char* out, size_t size) {
+    const char* p = FindJsonValue(object, key);
+    if (p == NULL || (p = strchr(p, '"')) == NULL) return false;
+    const char* end = strchr(++p, '"');
+    if (end == NULL || (size_t)(end - p) >= size) return false;
+    memcpy(out, p, (size_t)(end - p));
+    out[end - p] = '\0';
+    return true;
+}
+
+static double ReadJsonNumber(const char* object, const char* key) {
+    const char* p = FindJsonValue(object, key);
+    return p != NULL ? strtod(p, NULL) : 0.0;
+}
+
+// Reads results SaveBenchmarkResults wrote. This is no general JSON
+// parser: each result must be a flat object with a "name". Returns the
+// number read, or -1 if the file cannot be read.
+int LoadBenchmarkResults(const char* fileName, BenchmarkResult* results, int maxResults) {
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL) return -1;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = size >= 0 ? malloc((size_t)size + 1) : NULL;
+    if (text == NULL || fread(text, 1, (size_t)size, file) != (size_t)size) {
+        free(text);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+    text[size] = '\0';
+
+    int count = 0;
+    char* object = strchr(text, '[');
+    while (object != NULL && count < maxResults && (object = strchr(object, '{')) != NULL) {
+        char* end = strchr(object, '}');
+        if (end == NULL) break;
+        *end = '\0';
+
+        BenchmarkResult* r = &results[count];
+        *r = (BenchmarkResult){0};
+        if (ReadJsonString(object, "name", r->name, sizeof(r->name))) {
+            ReadJsonString(object, "unit", r->unit, sizeof(r->unit));
+            r->summary.count = (int)ReadJsonNumber(object, "count");
+            r->summary.mean = ReadJsonNumber(object, "mean");
+            r->summary.min = ReadJsonNumber(object, "min");
+            r->summary.p50 = ReadJsonNumber(object, "p50");
+            r->summary.p90 = ReadJsonNumber(object, "p90");
+            r->summary.p99 = ReadJsonNumber(object, "p99");
+            r->summary.max = ReadJsonNumber(object, "max");
+            count++;
+        }
+        object = end + 1;
+    }
+    free(text);
+    return count;
+}
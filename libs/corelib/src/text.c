@@ -0,0 +1,111 @@
+#include "corelib/text.h"
+#include "corelib/metrics.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+CachedText CreateCachedText(Arena* arena, Font font, float fontSize, float spacing, int maxGlyphs) {
+    CachedText text = {0};
+    if (maxGlyphs < 1) maxGlyphs = 1;
+
+    size_t bytes = sizeof(Rectangle) * (size_t)maxGlyphs;
+    text.ownsMemory = (arena == NULL);
+    text.sources = arena ? ArenaAlloc(arena, bytes) : malloc(bytes);
+    text.dests = arena ? ArenaAlloc(arena, bytes) : malloc(bytes);
+    if (!text.sources || !text.dests) {
+        DestroyCachedText(&text);
+        return text;
+    }
+
+    text.font = font;
+    text.fontSize = fontSize;
+    text.spacing = spacing;
+    text.glyphCapacity = maxGlyphs;
+    if (text.ownsMemory) AddMetricGauge(METRIC_HEAP_OBJECTS, 1);
+    return text;
+}
+
+void DestroyCachedText(CachedText* text) {
+    if (text->ownsMemory && text->glyphCapacity > 0) AddMetricGauge(METRIC_HEAP_OBJECTS, -1);
+    if (text->ownsMemory) {
+        free(text->sources);
+        free(text->dests);
+    }
+    *text = (CachedText){0};
+}
+
+// Places the glyphs the same way DrawTextEx does, relative to (0, 0).
+static void LayoutText(CachedText* text) {
+    const Font* font = &text->font;
+    float scale = text->fontSize / (float)font->baseSize;
+    float padding = (float)font->glyphPadding;
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 0.0f;
+
+    text->glyphCount = 0;
+    text->size = (Vector2){ 0.0f, text->fontSize };
+    if (font->glyphs == NULL) return;
+
+    for (const char* p = text->text; *p != '\0';) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(p, &codepointSize);
+        p += codepointSize;
+
+        if (codepoint == '\n') {
+            if (x > width) width = x;
+            x = 0.0f;
+            y += text->fontSize + CACHED_TEXT_LINE_SPACING;
+            text->size.y = y + text->fontSize;
+            continue;
+        }
+
+        int index = GetGlyphIndex(*font, codepoint);
+        const GlyphInfo* glyph = &font->glyphs[index];
+        Rectangle rec = font->recs[index];
+        if (codepoint != ' ' && codepoint != '\t' && text->glyphCount < text->glyphCapacity) {
+            int i = text->glyphCount++;
+            text->sources[i] = (Rectangle){ rec.x - padding, rec.y - padding, rec.width + 2.0f * padding,
+                                            rec.height + 2.0f * padding };
+            text->dests[i] = (Rectangle){ x + (glyph->offsetX - padding) * scale, y + (glyph->offsetY - padding) * scale,
+                                          (rec.width + 2.0f * padding) * scale, (rec.height + 2.0f * padding) * scale };
+        }
+        x += (glyph->advanceX == 0 ? rec.width : (float)glyph->advanceX) * scale + text->spacing;
+    }
+
+    // MeasureTextEx leaves out the spacing after the last glyph.
+    if (x > width) width = x;
+    text->size.x = width > 0.0f ? width - text->spacing : 0.0f;
+}
+
+bool SetCachedText(CachedText* text, const char* string) {
+    text->format = NULL;
+    if (strncmp(text->text, string, CACHED_TEXT_MAX_BYTES - 1) == 0 && text->layouts > 0) return false;
+
+    strncpy(text->text, string, CACHED_TEXT_MAX_BYTES - 1);
+    text->text[CACHED_TEXT_MAX_BYTES - 1] = '\0';
+    LayoutText(text);
+    text->layouts++;
+    return true;
+}
+
+// Skips even the formatting while the value and format stay the same.
+bool SetCachedTextInt(CachedText* text, const char* format, int value) {
+    if (text->format == format && text->value == value) return false;
+
+    char buffer[CACHED_TEXT_MAX_BYTES];
+    snprintf(buffer, sizeof(buffer), format, value);
+    bool changed = SetCachedText(text, buffer);
+    text->format = format;
+    text->value = value;
+    return changed;
+}
+
+void SubmitCachedText(SpriteBatch* batch, const CachedText* text, Vector2 position, Color tint, int layer) {
+    for (int i = 0; i < text->glyphCount; i++) {
+        Rectangle dest = text->dests[i];
+        dest.x += position.x;
+        dest.y += position.y;
+        SubmitSprite(batch, text->font.texture, text->sources[i], dest, tint, layer);
+    }
+}
@@ -0,0 +1,47 @@
+#include "corelib/timestep.h"
+#include <math.h>
+
+FixedStep CreateFixedStep(float tickRate, int maxSteps) {
+    FixedStep step = {0};
+    step.tickRate = (tickRate > 0.0f) ? tickRate : 60.0f;
+    step.dt = 1.0f / step.tickRate;
+    step.maxSteps = (maxSteps > 0) ? maxSteps : 1;
+    return step;
+}
+
+void ResetFixedStep(FixedStep* step) {
+    step->accumulator = 0.0f;
+    step->steps = 0;
+    step->tick = 0;
+}
+
+int AdvanceFixedStep(FixedStep* step, float frameTime) {
+    if (frameTime < 0.0f) frameTime = 0.0f;
+    step->accumulator += frameTime;
+
+    int steps = (int)(step->accumulator / step->dt);
+    step->accumulator -= (float)steps * step->dt;
+
+    // Spiral-of-death guard: run at most maxSteps ticks and drop the rest of
+    // the backlog, keeping only the sub-tick remainder for interpolation.
+    if (steps > step->maxSteps) steps = step->maxSteps;
+    if (step->accumulator < 0.0f) step->accumulator = 0.0f;
+
+    step->steps = steps;
+    step->tick += (unsigned long)steps;
+    return steps;
+}
+
+float GetFixedStepAlpha(const FixedStep* step) {
+    float alpha = step->accumulator / step->dt;
+    return (alpha > 1.0f) ? 1.0f : alpha;
+}
+
+int GetFixedStepTickOffset(const FixedStep* step, double time, double now) {
+    // The last advance's ticks end at now minus the leftover accumulator,
+    // one dt apart; tick i covers the dt before its end.
+    double firstEnd = now - (double)step->accumulator - (double)(step->steps - 1) * step->dt;
+    double offset = ceil((time - firstEnd) / step->dt);
+    if (offset < 0.0) return 0;
+    return offset > (double)step->steps ? step->steps : (int)offset;
+}
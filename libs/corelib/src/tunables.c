@@ -0,0 +1,93 @@
+#include "corelib/tunables.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Takes the defaults from values and applies the file on top, if it exists.
+TunableSet CreateTunableSet(const char* fileName, const char* const* names, float* values, int count) {
+    TunableSet set = {0};
+    size_t length = strlen(fileName);
+    set.fileName = malloc(length + 1);
+    set.defaults = malloc(sizeof(float) * (size_t)(count > 0 ? count : 1));
+    if (set.fileName == NULL || set.defaults == NULL) {
+        free(set.fileName);
+        free(set.defaults);
+        return (TunableSet){0};
+    }
+    memcpy(set.fileName, fileName, length + 1);
+    memcpy(set.defaults, values, sizeof(float) * (size_t)count);
+    set.names = names;
+    set.values = values;
+    set.count = count;
+
+    set.watcher = CreateFileWatcher();
+    AddFileWatch(&set.watcher, fileName);
+    ReloadTunables(&set);
+    return set;
+}
+
+void DestroyTunableSet(TunableSet* set) {
+    DestroyFileWatcher(&set->watcher);
+    free(set->fileName);
+    free(set->defaults);
+    *set = (TunableSet){0};
+}
+
+static int FindTunable(const TunableSet* set, const char* name) {
+    for (int i = 0; i < set->count; i++) {
+        if (strcmp(set->names[i], name) == 0) return i;
+    }
+    return -1;
+}
+
+// Reads the file now and returns how many values changed. Lines that do not
+// parse and unknown names are reported and skipped, so a typo mid-edit
+// never takes the other values down with it.
+int ReloadTunables(TunableSet* set) {
+    if (set->fileName == NULL) return 0;
+    float* next = malloc(sizeof(float) * (size_t)(set->count > 0 ? set->count : 1));
+    if (next == NULL) return 0;
+    memcpy(next, set->defaults, sizeof(float) * (size_t)set->count);
+
+    // The last assignment to a name wins.
+    char* text = FileExists(set->fileName) ? LoadFileText(set->fileName) : NULL;
+    char* line = text;
+    for (int lineNumber = 1; line != NULL; lineNumber++) {
+        char* end = strchr(line, '\n');
+        if (end != NULL) *end = '\0';
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        char name[64];
+        float value;
+        int fields = sscanf(line, " %63[A-Za-z0-9_] = %f", name, &value);
+        if (fields == 2) {
+            int index = FindTunable(set, name);
+            if (index >= 0) next[index] = value;
+            else TraceLog(LOG_WARNING, "TUNABLES: [%s] Unknown tunable %s", set->fileName, name);
+        } else if (line[strspn(line, " \t\r")] != '\0') {
+            TraceLog(LOG_WARNING, "TUNABLES: [%s] Line %d is not NAME = value", set->fileName, lineNumber);
+        }
+        line = end != NULL ? end + 1 : NULL;
+    }
+    if (text != NULL) UnloadFileText(text);
+
+    int changed = 0;
+    for (int i = 0; i < set->count; i++) {
+        if (next[i] == set->values[i]) continue;
+        TraceLog(LOG_INFO, "TUNABLES: %s = %g", set->names[i], next[i]);
+        set->values[i] = next[i];
+        changed++;
+    }
+    free(next);
+    return changed;
+}
+
+// Reloads the file if it changed since the last call. Cheap enough to call
+// every frame.
+int UpdateTunables(TunableSet* set) {
+    int id;
+    if (PollFileWatcher(&set->watcher, &id, 1) == 0) return 0;
+    return ReloadTunables(set);
+}
@@ -0,0 +1,204 @@
+#define _POSIX_C_SOURCE 200809L
+#if defined(__APPLE__)
+#define _DARWIN_C_SOURCE
+#endif
+
+#include "corelib/watch.h"
+#include "corelib/clock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#if defined(__linux__)
+#define WATCH_INOTIFY
+#include <sys/inotify.h>
+#include <unistd.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__DragonFly__)
+#define WATCH_KQUEUE
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/event.h>
+#include <unistd.h>
+#ifndef O_EVTONLY
+#define O_EVTONLY O_RDONLY
+#endif
+#endif
+
+static void ReadFileStamp(FileWatchEntry* entry, long long* mtime, long long* size) {
+    struct stat info;
+    if (stat(entry->path, &info) != 0) {
+        *mtime = -1;
+        *size = -1;
+        return;
+    }
+    *mtime = (long long)info.st_mtime;
+    *size = (long long)info.st_size;
+}
+
+#if defined(WATCH_KQUEUE)
+// Opens and registers the file itself. The descriptor follows the inode, so
+// after a delete or a rename-over the file is opened again by path.
+static bool OpenKqueueWatch(FileWatcher* watcher, int id) {
+    FileWatchEntry* entry = &watcher->entries[id];
+    entry->handle = open(entry->path, O_EVTONLY);
+    if (entry->handle < 0) return false;
+
+    struct kevent change;
+    EV_SET(&change, entry->handle, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+           NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME, 0, (void*)(intptr_t)id);
+    if (kevent(watcher->fd, &change, 1, NULL, 0, NULL) < 0) {
+        close(entry->handle);
+        entry->handle = -1;
+        return false;
+    }
+    return true;
+}
+#endif
+
+FileWatcher CreateFileWatcher(void) {
+    FileWatcher watcher = {0};
+    watcher.fd = -1;
+#if defined(WATCH_INOTIFY)
+    watcher.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#elif defined(WATCH_KQUEUE)
+    watcher.fd = kqueue();
+#endif
+    return watcher;
+}
+
+void DestroyFileWatcher(FileWatcher* watcher) {
+    for (int i = 0; i < watcher->count; i++) {
+#if defined(WATCH_KQUEUE)
+        if (watcher->fd >= 0 && watcher->entries[i].handle >= 0) close(watcher->entries[i].handle);
+#endif
+        free(watcher->entries[i].path);
+    }
+#if defined(WATCH_INOTIFY) || defined(WATCH_KQUEUE)
+    if (watcher->fd >= 0) close(watcher->fd);
+#endif
+    free(watcher->entries);
+    *watcher = (FileWatcher){0};
+    watcher->fd = -1;
+}
+
+// Returns the watch ID, or -1 if the file cannot be watched. The ID stays
+// valid until the watcher is destroyed.
+int AddFileWatch(FileWatcher* watcher, const char* fileName) {
+    if (watcher->count == watcher->capacity) {
+        int capacity = watcher->capacity > 0 ? watcher->capacity * 2 : 8;
+        FileWatchEntry* entries = realloc(watcher->entries, sizeof(FileWatchEntry) * (size_t)capacity);
+        if (entries == NULL) return -1;
+        watcher->entries = entries;
+        watcher->capacity = capacity;
+    }
+
+    size_t length = strlen(fileName);
+    char* path = malloc(length + 1);
+    if (path == NULL) return -1;
+    memcpy(path, fileName, length + 1);
+
+    int id = watcher->count;
+    FileWatchEntry* entry = &watcher->entries[id];
+    *entry = (FileWatchEntry){ .path = path, .handle = -1 };
+    char* slash = strrchr(path, '/');
+    entry->name = slash != NULL ? slash + 1 : path;
+    ReadFileStamp(entry, &entry->mtime, &entry->size);
+
+#if defined(WATCH_INOTIFY)
+    // Watching the directory sees files that are created or renamed into
+    // place, which a watch on the file itself would lose.
+    if (watcher->fd >= 0) {
+        const char* directory = ".";
+        if (slash != NULL) {
+            directory = path;
+            *slash = '\0';
+        }
+        entry->handle = inotify_add_watch(watcher->fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (slash != NULL) *slash = '/';
+        if (entry->handle < 0) {
+            free(path);
+            return -1;
+        }
+    }
+#elif defined(WATCH_KQUEUE)
+    if (watcher->fd >= 0) OpenKqueueWatch(watcher, id);
+#endif
+
+    watcher->count++;
+    return id;
+}
+
+// Fills changed with the IDs of files that changed since the last poll,
+// each once, and returns how many there are. Never blocks. IDs that do not
+// fit stay pending for the next poll.
+int PollFileWatcher(FileWatcher* watcher, int* changed, int maxChanged) {
+    double now = GetClockSeconds();
+    bool check = now >= watcher->nextCheck;
+    if (check) watcher->nextCheck = now + FILE_WATCH_POLL_INTERVAL;
+
+#if defined(WATCH_INOTIFY)
+    if (watcher->fd >= 0) {
+        union {
+            struct inotify_event event;
+            char bytes[4096];
+        } buffer;
+        ssize_t n;
+        while ((n = read(watcher->fd, &buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer.bytes; p < buffer.bytes + n;) {
+                struct inotify_event* event = (struct inotify_event*)p;
+                for (int i = 0; i < watcher->count; i++) {
+                    FileWatchEntry* entry = &watcher->entries[i];
+                    if ((event->mask & IN_Q_OVERFLOW) ||
+                        (entry->handle == event->wd && event->len > 0 && strcmp(event->name, entry->name) == 0)) {
+                        entry->changed = true;
+                    }
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        check = false;
+    }
+#elif defined(WATCH_KQUEUE)
+    if (watcher->fd >= 0) {
+        struct kevent events[16];
+        struct timespec zero = { 0, 0 };
+        int n;
+        while ((n = kevent(watcher->fd, NULL, 0, events, 16, &zero)) > 0) {
+            for (int i = 0; i < n; i++) {
+                int id = (int)(intptr_t)events[i].udata;
+                if (id < 0 || id >= watcher->count) continue;
+                FileWatchEntry* entry = &watcher->entries[id];
+                entry->changed = true;
+                if ((events[i].fflags & (NOTE_DELETE | NOTE_RENAME)) && entry->handle >= 0) {
+                    close(entry->handle);
+                    entry->handle = -1;
+                }
+            }
+            if (n < 16) break;
+        }
+        // Files that were missing or replaced come back by path.
+        for (int i = 0; check && i < watcher->count; i++) {
+            if (watcher->entries[i].handle < 0 && OpenKqueueWatch(watcher, i)) watcher->entries[i].changed = true;
+        }
+        check = false;
+    }
+#endif
+
+    // Without notifications, compare modification times and sizes.
+    for (int i = 0; check && i < watcher->count; i++) {
+        FileWatchEntry* entry = &watcher->entries[i];
+        long long mtime, size;
+        ReadFileStamp(entry, &mtime, &size);
+        if (mtime >= 0 && (mtime != entry->mtime || size != entry->size)) entry->changed = true;
+        entry->mtime = mtime;
+        entry->size = size;
+    }
+
+    int count = 0;
+    for (int i = 0; i < watcher->count && count < maxChanged; i++) {
+        if (!watcher->entries[i].changed) continue;
+        watcher->entries[i].changed = false;
+        changed[count++] = i;
+    }
+    return count;
+}
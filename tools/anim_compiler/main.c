@@ -0,0 +1,181 @@
+/**
+ * @file main.c
+ * @brief Build-time animation frame table compiler.
+ * 
+ * Reads a text definition of a game's animation clips and writes them, with
+ * per-frame durations and atlas region hashes, to one .anim file that
+ * corelib's LoadAnimationTable reads back. See corelib/animation.h for the
+ * file layout.
+ * 
+ * Usage: anim_compiler <output.anim> <input.txt>
+ * 
+ * The definition is one directive per line, '#' starting a comment:
+ * 
+ *   clip <name> loop|once
+ *   frame <atlas region> <milliseconds>
+ * 
+ * Frames belong to the clip above them. Regions are named like the atlas
+ * sources they were packed from, without the extension.
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ANIM_MAX_COUNT 65535        /**< Clip counts and frame offsets are stored in u16s. */
+#define ANIM_NAME_LENGTH 64         /**< The longest clip or region name. */
+
+/**
+ * @brief A clip being collected.
+ * 
+ */
+typedef struct {
+    char name[ANIM_NAME_LENGTH];    /**< The clip's name. */
+    uint32_t hash;                  /**< The hash of the name. */
+    int firstFrame;                 /**< The clip's first frame. */
+    int frameCount;                 /**< The clip's frame count. */
+    bool loop;                      /**< Whether the clip loops. */
+} ClipItem;
+
+/**
+ * @brief A frame being collected.
+ * 
+ */
+typedef struct {
+    uint32_t regionHash;    /**< The hash of the frame's atlas region name. */
+    float duration;         /**< The frame's duration in seconds. */
+} FrameItem;
+
+/**
+ * @brief Orders clips by name hash, the order the clip table is stored in.
+ */
+static int CompareHash(const void *a, const void *b) {
+    uint32_t ha = ((const ClipItem *)a)->hash;
+    uint32_t hb = ((const ClipItem *)b)->hash;
+    return (ha > hb) - (ha < hb);
+}
+
+static void PutU16(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)((v >> 8) & 0xFF);
+}
+
+static void PutU32(unsigned char *p, uint32_t v) {
+    PutU16(p, v & 0xFFFF);
+    PutU16(p + 2, v >> 16);
+}
+
+static void PutF32(unsigned char *p, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    PutU32(p, bits);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <output.anim> <input.txt>\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    
+    const char *outPath = argv[1];
+    const char *inPath = argv[2];
+    
+    FILE *in = fopen(inPath, "r");
+    if (in == NULL) {
+        fprintf(stderr, "anim_compiler: cannot read %s\n", inPath);
+        return 1;
+    }
+    ClipItem *clips = calloc(ANIM_MAX_COUNT, sizeof(ClipItem));
+    FrameItem *frames = calloc(ANIM_MAX_COUNT, sizeof(FrameItem));
+    if (clips == NULL || frames == NULL) return 1;
+    
+    // Collect the clips and their frames in file order.
+    int clipCount = 0;
+    int frameCount = 0;
+    char line[256];
+    for (int lineNumber = 1; fgets(line, sizeof(line), in) != NULL; lineNumber++) {
+        char *comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+        
+        char directive[16], name[ANIM_NAME_LENGTH], mode[16];
+        float ms = 0.0f;
+        int fields = sscanf(line, "%15s %63s %15s", directive, name, mode);
+        if (fields <= 0) continue;
+        
+        if (strcmp(directive, "clip") == 0 && fields == 3
+            && (strcmp(mode, "loop") == 0 || strcmp(mode, "once") == 0)) {
+            if (clipCount == ANIM_MAX_COUNT) {
+                fprintf(stderr, "anim_compiler: %s:%d: too many clips\n", inPath, lineNumber);
+                return 1;
+            }
+            ClipItem *clip = &clips[clipCount++];
+            snprintf(clip->name, sizeof(clip->name), "%s", name);
+            clip->hash = HashAtlasName(name);
+            clip->firstFrame = frameCount;
+            clip->loop = strcmp(mode, "loop") == 0;
+        } else if (strcmp(directive, "frame") == 0 && sscanf(line, "%*s %63s %f", name, &ms) == 2 && ms > 0.0f) {
+            if (clipCount == 0) {
+                fprintf(stderr, "anim_compiler: %s:%d: frame before any clip\n", inPath, lineNumber);
+                return 1;
+            }
+            if (frameCount == ANIM_MAX_COUNT) {
+                fprintf(stderr, "anim_compiler: %s:%d: too many frames\n", inPath, lineNumber);
+                return 1;
+            }
+            frames[frameCount++] = (FrameItem){ HashAtlasName(name), ms / 1000.0f };
+            clips[clipCount - 1].frameCount++;
+        } else {
+            fprintf(stderr, "anim_compiler: %s:%d: expected 'clip <name> loop|once' or 'frame <region> <ms>'\n",
+                    inPath, lineNumber);
+            return 1;
+        }
+    }
+    fclose(in);
+    
+    // Clips are found by binary search on their hash, so duplicates would be ambiguous.
+    qsort(clips, (size_t)clipCount, sizeof(ClipItem), CompareHash);
+    for (int i = 0; i < clipCount; i++) {
+        if (clips[i].frameCount == 0) {
+            fprintf(stderr, "anim_compiler: clip %s has no frames\n", clips[i].name);
+            return 1;
+        }
+        if (i > 0 && clips[i].hash == clips[i - 1].hash) {
+            fprintf(stderr, "anim_compiler: clips %s and %s have the same name hash\n", clips[i - 1].name, clips[i].name);
+            return 1;
+        }
+    }
+    
+    // Write the header, the hash-sorted clip table and the frames.
+    int fileSize = ANIMATION_HEADER_SIZE + clipCount * ANIMATION_CLIP_SIZE + frameCount * ANIMATION_FRAME_SIZE;
+    unsigned char *file = calloc((size_t)fileSize, 1);
+    if (file == NULL) return 1;
+    
+    PutU32(file, ANIMATION_MAGIC);
+    PutU16(file + 4, ANIMATION_VERSION);
+    PutU16(file + 6, (uint32_t)clipCount);
+    PutU32(file + 8, (uint32_t)frameCount);
+    for (int i = 0; i < clipCount; i++) {
+        unsigned char *c = file + ANIMATION_HEADER_SIZE + i * ANIMATION_CLIP_SIZE;
+        PutU32(c, clips[i].hash);
+        PutU16(c + 4, (uint32_t)clips[i].firstFrame);
+        PutU16(c + 6, (uint32_t)clips[i].frameCount);
+        PutU32(c + 8, clips[i].loop ? ANIMATION_CLIP_LOOP : 0u);
+    }
+    for (int i = 0; i < frameCount; i++) {
+        unsigned char *f = file + ANIMATION_HEADER_SIZE + clipCount * ANIMATION_CLIP_SIZE + i * ANIMATION_FRAME_SIZE;
+        PutU32(f, frames[i].regionHash);
+        PutF32(f + 4, frames[i].duration);
+    }
+    
+    bool ok = SaveFileData(outPath, file, fileSize);
+    printf("anim_compiler: %s: %d clips, %d frames (%d bytes)\n", outPath, clipCount, frameCount, fileSize);
+    
+    free(file);
+    free(clips);
+    free(frames);
+    return ok ? 0 : 1;
+}
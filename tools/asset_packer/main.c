@@ -0,0 +1,214 @@
+/**
+ * @file main.c
+ * @brief Build-time asset archive packer.
+ * 
+ * Decodes a game's assets once at build time and writes them, with a table
+ * of contents keyed by path, to one archive that corelib maps at runtime.
+ * Images become raw pixels, sounds PCM and atlases a region table plus
+ * pixels; anything else is stored as-is. See corelib/archive.h for the
+ * file layout.
+ * 
+ * Usage: asset_packer <output.pak> <root> <input>...
+ * 
+ * Entries are named by their path relative to root.
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARCHIVE_MAX_ENTRIES 65535   /**< The entry count is stored in a u16. */
+
+/**
+ * @brief An asset waiting to be written.
+ * 
+ */
+typedef struct {
+    const char *path;       /**< The source file. */
+    ArchiveEntry entry;     /**< The table of contents entry (offset set on layout). */
+    unsigned char *data;    /**< The bytes to store. */
+} PackItem;
+
+/**
+ * @brief Orders items by name hash, the order the table is stored in.
+ */
+static int CompareHash(const void *a, const void *b) {
+    uint32_t ha = ((const PackItem *)a)->entry.nameHash;
+    uint32_t hb = ((const PackItem *)b)->entry.nameHash;
+    return (ha > hb) - (ha < hb);
+}
+
+/**
+ * @brief Rounds up to the archive's blob alignment.
+ */
+static uint64_t AlignUp(uint64_t v) {
+    return (v + ARCHIVE_ALIGN - 1) & ~(uint64_t)(ARCHIVE_ALIGN - 1);
+}
+
+/**
+ * @brief Copies size bytes into a new heap block.
+ */
+static unsigned char *CopyBytes(const void *src, size_t size) {
+    unsigned char *copy = malloc(size > 0 ? size : 1);
+    if (copy != NULL) memcpy(copy, src, size);
+    return copy;
+}
+
+/**
+ * @brief Reads and decodes one input into a pack item.
+ * 
+ * @param item The item, with path set.
+ * @return true if the input was decoded, false to skip it.
+ */
+static bool DecodeItem(PackItem *item) {
+    const char *path = item->path;
+    ArchiveEntry *e = &item->entry;
+
+    if (IsFileExtension(path, ".atlas")) {
+        TextureAtlas atlas;
+        Image image;
+        if (!LoadTextureAtlasImage(path, &atlas, &image)) return false;
+        if (image.data == NULL) {
+            UnloadTextureAtlas(&atlas);
+            return false;
+        }
+        size_t pixels = GetArchiveAtlasPixelOffset(atlas.regionCount);
+        size_t pixelSize = (size_t)GetPixelDataSize(image.width, image.height, image.format);
+        item->data = calloc(1, pixels + pixelSize);
+        if (item->data != NULL) {
+            memcpy(item->data, atlas.regions, sizeof(AtlasRegion) * (size_t)atlas.regionCount);
+            memcpy(item->data + pixels, image.data, pixelSize);
+        }
+        e->type = ARCHIVE_ATLAS;
+        e->format = (uint16_t)image.format;
+        e->size = pixels + pixelSize;
+        e->params[0] = (uint32_t)image.width;
+        e->params[1] = (uint32_t)image.height;
+        e->params[2] = 1;
+        e->params[3] = (uint32_t)atlas.regionCount;
+        UnloadImage(image);
+        UnloadTextureAtlas(&atlas);
+    } else if (IsFileExtension(path, ".png;.jpg;.jpeg;.bmp;.tga;.gif;.qoi")) {
+        Image image = LoadImage(path);
+        if (image.data == NULL) return false;
+        e->type = ARCHIVE_IMAGE;
+        e->format = (uint16_t)image.format;
+        e->size = (uint64_t)GetPixelDataSize(image.width, image.height, image.format);
+        e->params[0] = (uint32_t)image.width;
+        e->params[1] = (uint32_t)image.height;
+        e->params[2] = 1;
+        item->data = CopyBytes(image.data, (size_t)e->size);
+        UnloadImage(image);
+    } else if (IsFileExtension(path, ".wav;.ogg;.mp3;.flac;.qoa")) {
+        Wave wave = LoadWave(path);
+        if (wave.data == NULL) return false;
+        e->type = ARCHIVE_WAVE;
+        e->size = (uint64_t)wave.frameCount * wave.channels * (wave.sampleSize / 8);
+        e->params[0] = wave.frameCount;
+        e->params[1] = wave.sampleRate;
+        e->params[2] = wave.sampleSize;
+        e->params[3] = wave.channels;
+        item->data = CopyBytes(wave.data, (size_t)e->size);
+        UnloadWave(wave);
+    } else {
+        int size = 0;
+        unsigned char *bytes = LoadFileData(path, &size);
+        if (bytes == NULL) return false;
+        e->type = ARCHIVE_RAW;
+        e->size = (uint64_t)size;
+        item->data = CopyBytes(bytes, (size_t)size);
+        UnloadFileData(bytes);
+    }
+    return item->data != NULL;
+}
+
+/**
+ * @brief The entry point: packs the inputs into one archive.
+ * 
+ * @param argc The argument count.
+ * @param argv The output path, the asset root, then the input paths.
+ * @return int The exit code.
+ */
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fprintf(stderr, "Usage: %s <output.pak> <root> <input>...\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const char *outPath = argv[1];
+    const char *root = argv[2];
+    size_t rootLength = strlen(root);
+    int inputCount = argc - 3;
+    if (inputCount > ARCHIVE_MAX_ENTRIES) {
+        fprintf(stderr, "asset_packer: too many inputs (%d)\n", inputCount);
+        return 1;
+    }
+
+    PackItem *items = calloc((size_t)inputCount, sizeof(PackItem));
+    if (items == NULL) return 1;
+
+    // Decode the inputs, skipping any that cannot be read.
+    int count = 0;
+    for (int i = 0; i < inputCount; i++) {
+        PackItem *item = &items[count];
+        item->path = argv[i + 3];
+        const char *name = item->path;
+        if (strncmp(name, root, rootLength) == 0 && name[rootLength] == '/') name += rootLength + 1;
+        item->entry.nameHash = HashAtlasName(name);
+
+        if (!DecodeItem(item)) {
+            fprintf(stderr, "asset_packer: warning: cannot read %s, skipping it\n", item->path);
+            free(item->data);
+            *item = (PackItem){0};
+            continue;
+        }
+        count++;
+    }
+
+    // Sort the table by hash and reject collisions, which lookups could not tell apart.
+    qsort(items, (size_t)count, sizeof(PackItem), CompareHash);
+    for (int i = 1; i < count; i++) {
+        if (items[i].entry.nameHash == items[i - 1].entry.nameHash) {
+            fprintf(stderr, "asset_packer: %s and %s have the same name hash\n", items[i - 1].path, items[i].path);
+            return 1;
+        }
+    }
+
+    // Lay out the header, the table and the aligned blobs.
+    uint64_t dataOffset = AlignUp(ARCHIVE_HEADER_SIZE + (uint64_t)count * sizeof(ArchiveEntry));
+    uint64_t fileSize = dataOffset;
+    for (int i = 0; i < count; i++) {
+        items[i].entry.offset = fileSize;
+        fileSize = AlignUp(fileSize + items[i].entry.size);
+    }
+    if (fileSize > (uint64_t)INT32_MAX) {
+        fprintf(stderr, "asset_packer: archive would exceed 2 GiB\n");
+        return 1;
+    }
+
+    unsigned char *file = calloc(1, (size_t)fileSize);
+    if (file == NULL) return 1;
+    uint32_t magic = ARCHIVE_MAGIC;
+    uint16_t version = ARCHIVE_VERSION;
+    uint16_t entryCount = (uint16_t)count;
+    uint32_t dataStart = (uint32_t)dataOffset;
+    memcpy(file, &magic, 4);
+    memcpy(file + 4, &version, 2);
+    memcpy(file + 6, &entryCount, 2);
+    memcpy(file + 8, &dataStart, 4);
+    for (int i = 0; i < count; i++) {
+        memcpy(file + ARCHIVE_HEADER_SIZE + (size_t)i * sizeof(ArchiveEntry), &items[i].entry, sizeof(ArchiveEntry));
+        memcpy(file + items[i].entry.offset, items[i].data, (size_t)items[i].entry.size);
+        free(items[i].data);
+    }
+
+    bool ok = SaveFileData(outPath, file, (int)fileSize);
+    if (ok) printf("asset_packer: %s: %d entries, %llu bytes\n", outPath, count, (unsigned long long)fileSize);
+    free(file);
+    free(items);
+    return ok ? 0 : 1;
+}
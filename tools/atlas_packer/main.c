@@ -0,0 +1,204 @@
+/**
+ * @file main.c
+ * @brief Build-time texture atlas packer.
+ * 
+ * Packs a set of PNG files into a single atlas texture and writes it, with a
+ * region index keyed by file name, to one .atlas file that corelib's
+ * LoadTextureAtlas reads back. See corelib/atlas.h for the file layout.
+ * 
+ * Usage: atlas_packer <output.atlas> <input.png>...
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ATLAS_PADDING 2             /**< Transparent pixels between regions. */
+#define ATLAS_MAX_SIZE 4096         /**< The largest atlas edge allowed. */
+#define PLACEHOLDER_SIZE 16         /**< The size of the stand-in for unreadable images. */
+
+/**
+ * @brief A source image waiting to be packed.
+ * 
+ */
+typedef struct {
+    const char *path;   /**< The source file. */
+    uint32_t hash;      /**< The hash of the file's base name. */
+    Image image;        /**< The decoded pixels. */
+    int x;              /**< The packed x position. */
+    int y;              /**< The packed y position. */
+} PackItem;
+
+/**
+ * @brief Orders items tallest first for shelf packing.
+ */
+static int CompareHeight(const void *a, const void *b) {
+    const PackItem *ia = a;
+    const PackItem *ib = b;
+    if (ia->image.height != ib->image.height) return ib->image.height - ia->image.height;
+    return ib->image.width - ia->image.width;
+}
+
+/**
+ * @brief Orders items by name hash, the order the region table is stored in.
+ */
+static int CompareHash(const void *a, const void *b) {
+    uint32_t ha = ((const PackItem *)a)->hash;
+    uint32_t hb = ((const PackItem *)b)->hash;
+    return (ha > hb) - (ha < hb);
+}
+
+/**
+ * @brief Rounds up to the next power of two.
+ */
+static int NextPow2(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+/**
+ * @brief Shelf-packs the items into the given width.
+ * 
+ * @return int The packed height, or -1 if an item does not fit.
+ */
+static int PackShelves(PackItem *items, int count, int width) {
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+    for (int i = 0; i < count; i++) {
+        int w = items[i].image.width + ATLAS_PADDING;
+        int h = items[i].image.height + ATLAS_PADDING;
+        if (w > width) return -1;
+        if (x + w > width) {
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+        items[i].x = x;
+        items[i].y = y;
+        x += w;
+        if (h > shelfHeight) shelfHeight = h;
+    }
+    return y + shelfHeight;
+}
+
+static void PutU16(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)(v & 0xFF);
+    p[1] = (unsigned char)((v >> 8) & 0xFF);
+}
+
+static void PutU32(unsigned char *p, uint32_t v) {
+    PutU16(p, v & 0xFFFF);
+    PutU16(p + 2, v >> 16);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <output.atlas> <input.png>...\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    
+    const char *outPath = argv[1];
+    int count = argc - 2;
+    if (count > 0xFFFF) {
+        fprintf(stderr, "atlas_packer: too many images (%d)\n", count);
+        return 1;
+    }
+    PackItem *items = calloc((size_t)count, sizeof(PackItem));
+    if (items == NULL) return 1;
+    
+    // Decode every input, standing in a checkerboard for unreadable files.
+    long area = 0;
+    int widest = 1;
+    for (int i = 0; i < count; i++) {
+        items[i].path = argv[i + 2];
+        items[i].hash = HashAtlasName(GetFileNameWithoutExt(items[i].path));
+        items[i].image = LoadImage(items[i].path);
+        if (items[i].image.data == NULL) {
+            fprintf(stderr, "atlas_packer: warning: cannot read %s, using a placeholder\n", items[i].path);
+            items[i].image = GenImageChecked(PLACEHOLDER_SIZE, PLACEHOLDER_SIZE, PLACEHOLDER_SIZE / 2,
+                                             PLACEHOLDER_SIZE / 2, MAGENTA, BLACK);
+        }
+        ImageFormat(&items[i].image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        area += (long)(items[i].image.width + ATLAS_PADDING) * (items[i].image.height + ATLAS_PADDING);
+        if (items[i].image.width + ATLAS_PADDING > widest) widest = items[i].image.width + ATLAS_PADDING;
+    }
+    
+    // Region IDs are table indices, so duplicate names would be ambiguous.
+    qsort(items, (size_t)count, sizeof(PackItem), CompareHash);
+    for (int i = 1; i < count; i++) {
+        if (items[i].hash == items[i - 1].hash) {
+            fprintf(stderr, "atlas_packer: %s and %s have the same name hash\n", items[i - 1].path, items[i].path);
+            return 1;
+        }
+    }
+    
+    // Find the narrowest power-of-two width whose packing is no taller than wide.
+    qsort(items, (size_t)count, sizeof(PackItem), CompareHeight);
+    int width = NextPow2(widest);
+    while (width * width < area) width <<= 1;
+    int height = PackShelves(items, count, width);
+    while (height > width && width < ATLAS_MAX_SIZE) {
+        width <<= 1;
+        height = PackShelves(items, count, width);
+    }
+    height = NextPow2(height);
+    if (height < 1 || width > ATLAS_MAX_SIZE || height > ATLAS_MAX_SIZE) {
+        fprintf(stderr, "atlas_packer: images do not fit in %d x %d\n", ATLAS_MAX_SIZE, ATLAS_MAX_SIZE);
+        return 1;
+    }
+    
+    // Blit the images into the atlas.
+    Image atlas = GenImageColor(width, height, BLANK);
+    for (int i = 0; i < count; i++) {
+        Image img = items[i].image;
+        Rectangle src = { 0, 0, (float)img.width, (float)img.height };
+        Rectangle dst = { (float)items[i].x, (float)items[i].y, (float)img.width, (float)img.height };
+        ImageDraw(&atlas, img, src, dst, WHITE);
+    }
+    
+    int pngSize = 0;
+    unsigned char *png = ExportImageToMemory(atlas, ".png", &pngSize);
+    UnloadImage(atlas);
+    if (png == NULL) {
+        fprintf(stderr, "atlas_packer: failed to encode the atlas\n");
+        return 1;
+    }
+    
+    // Write the header, the hash-sorted region table and the PNG.
+    qsort(items, (size_t)count, sizeof(PackItem), CompareHash);
+    int tableSize = count * ATLAS_REGION_SIZE;
+    int fileSize = ATLAS_HEADER_SIZE + tableSize + pngSize;
+    unsigned char *file = calloc((size_t)fileSize, 1);
+    if (file == NULL) return 1;
+    
+    PutU32(file, ATLAS_MAGIC);
+    PutU16(file + 4, ATLAS_VERSION);
+    PutU16(file + 6, (uint32_t)count);
+    PutU16(file + 8, (uint32_t)width);
+    PutU16(file + 10, (uint32_t)height);
+    PutU32(file + 12, (uint32_t)pngSize);
+    for (int i = 0; i < count; i++) {
+        unsigned char *r = file + ATLAS_HEADER_SIZE + i * ATLAS_REGION_SIZE;
+        PutU32(r, items[i].hash);
+        PutU16(r + 4, (uint32_t)items[i].x);
+        PutU16(r + 6, (uint32_t)items[i].y);
+        PutU16(r + 8, (uint32_t)items[i].image.width);
+        PutU16(r + 10, (uint32_t)items[i].image.height);
+    }
+    memcpy(file + ATLAS_HEADER_SIZE + tableSize, png, (size_t)pngSize);
+    MemFree(png);
+    
+    bool ok = SaveFileData(outPath, file, fileSize);
+    printf("atlas_packer: %s: %d regions in %d x %d (%d bytes)\n", outPath, count, width, height, fileSize);
+    
+    free(file);
+    for (int i = 0; i < count; i++) UnloadImage(items[i].image);
+    free(items);
+    return ok ? 0 : 1;
+}
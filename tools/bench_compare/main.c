@@ -0,0 +1,145 @@
+/**
+ * @file main.c
+ * @brief Benchmark regression gate.
+ * 
+ * Compares benchmark JSON files (see corelib/stats.h) with a stored
+ * baseline and fails if any result's median or 99th percentile grew by
+ * more than its threshold. Results missing from the baseline are listed
+ * as new and never fail, so adding a benchmark does not break the gate.
+ * Baseline results missing from the run are listed as missing and fail,
+ * so a renamed or dropped benchmark does not leave the gate unnoticed.
+ * 
+ * Usage: bench_compare [--p50 PCT] [--p99 PCT] [--allow-missing] <baseline dir> <results.json>...
+ * 
+ * Each results file is compared with the file of the same name in the
+ * baseline directory, which must exist. The thresholds default to 10% for
+ * p50 and 25% for p99, which is tail noise on a quiet machine.
+ * --allow-missing reports every result of a file with no baseline as new,
+ * and missing results without failing, for a first run or a changed suite.
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMPARE_MAX_RESULTS 256     /**< The most results read from one file. */
+#define COMPARE_PATH_LENGTH 1024    /**< The longest baseline path. */
+
+/**
+ * @brief Returns the change from before to after in percent.
+ */
+static double PercentChange(double before, double after) {
+    if (before <= 0.0) return after > 0.0 ? 100.0 : 0.0;
+    return (after - before) / before * 100.0;
+}
+
+static const BenchmarkResult *FindResult(const BenchmarkResult *results, int count, const char *name) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(results[i].name, name) == 0) return &results[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Compares one results file with its baseline and prints each result.
+ * 
+ * @param baselineDir The directory holding the baseline files.
+ * @param fileName The results file.
+ * @param p50Threshold The allowed p50 growth in percent.
+ * @param p99Threshold The allowed p99 growth in percent.
+ * @param allowMissing Whether a missing baseline file is read as empty.
+ * @param missing Incremented for each baseline result the run no longer has.
+ * @return The number of regressions, or -1 if the results or the baseline cannot be read.
+ */
+static int CompareFile(const char *baselineDir, const char *fileName, double p50Threshold, double p99Threshold,
+                       bool allowMissing, int *missing) {
+    static BenchmarkResult current[COMPARE_MAX_RESULTS];
+    static BenchmarkResult baseline[COMPARE_MAX_RESULTS];
+    
+    int currentCount = LoadBenchmarkResults(fileName, current, COMPARE_MAX_RESULTS);
+    if (currentCount < 0) {
+        fprintf(stderr, "bench_compare: cannot read %s\n", fileName);
+        return -1;
+    }
+    
+    // Without a baseline file nothing can be compared, so unless that is
+    // allowed, when every result in it is new, the gate fails.
+    char baselinePath[COMPARE_PATH_LENGTH];
+    const char *slash = strrchr(fileName, '/');
+    snprintf(baselinePath, sizeof(baselinePath), "%s/%s", baselineDir, slash != NULL ? slash + 1 : fileName);
+    int baselineCount = LoadBenchmarkResults(baselinePath, baseline, COMPARE_MAX_RESULTS);
+    if (baselineCount < 0) {
+        if (!allowMissing) {
+            fprintf(stderr, "bench_compare: cannot read baseline %s (make bench-baseline saves one)\n", baselinePath);
+            return -1;
+        }
+        baselineCount = 0;
+    }
+    
+    int regressions = 0;
+    for (int i = 0; i < currentCount; i++) {
+        const BenchmarkResult *now = &current[i];
+        const BenchmarkResult *before = FindResult(baseline, baselineCount, now->name);
+        if (before == NULL) {
+            printf("  %-40s p50 %10.3f %-2s  p99 %10.3f %-2s  new\n",
+                   now->name, now->summary.p50, now->unit, now->summary.p99, now->unit);
+            continue;
+        }
+        
+        double p50Change = PercentChange(before->summary.p50, now->summary.p50);
+        double p99Change = PercentChange(before->summary.p99, now->summary.p99);
+        bool regressed = p50Change > p50Threshold || p99Change > p99Threshold;
+        if (regressed) regressions++;
+        printf("  %-40s p50 %10.3f %-2s %+7.1f%%  p99 %10.3f %-2s %+7.1f%%  %s\n",
+               now->name, now->summary.p50, now->unit, p50Change, now->summary.p99, now->unit, p99Change,
+               regressed ? "REGRESSED" : "ok");
+    }
+    
+    for (int i = 0; i < baselineCount; i++) {
+        const BenchmarkResult *before = &baseline[i];
+        if (FindResult(current, currentCount, before->name) != NULL) continue;
+        printf("  %-40s p50 %10.3f %-2s  p99 %10.3f %-2s  missing\n",
+               before->name, before->summary.p50, before->unit, before->summary.p99, before->unit);
+        (*missing)++;
+    }
+    return regressions;
+}
+
+int main(int argc, char **argv) {
+    double p50Threshold = 10.0;
+    double p99Threshold = 25.0;
+    bool allowMissing = false;
+    int first = 1;
+    for (; first < argc && strncmp(argv[first], "--", 2) == 0; first++) {
+        if (strcmp(argv[first], "--p50") == 0 && first + 1 < argc) p50Threshold = strtod(argv[++first], NULL);
+        else if (strcmp(argv[first], "--p99") == 0 && first + 1 < argc) p99Threshold = strtod(argv[++first], NULL);
+        else if (strcmp(argv[first], "--allow-missing") == 0) allowMissing = true;
+        else break;
+    }
+    if (argc - first < 2) {
+        fprintf(stderr, "Usage: %s [--p50 PCT] [--p99 PCT] [--allow-missing] <baseline dir> <results.json>...\n", argv[0]);
+        return 2;
+    }
+    const char *baselineDir = argv[first];
+    
+    printf("Comparing with %s (p50 +%.0f%%, p99 +%.0f%% allowed)\n", baselineDir, p50Threshold, p99Threshold);
+    int regressions = 0;
+    int missing = 0;
+    for (int i = first + 1; i < argc; i++) {
+        int n = CompareFile(baselineDir, argv[i], p50Threshold, p99Threshold, allowMissing, &missing);
+        if (n < 0) return 2;
+        regressions += n;
+    }
+    
+    if (regressions > 0) printf("✗ %d benchmark%s regressed\n", regressions, regressions == 1 ? "" : "s");
+    if (missing > 0) {
+        printf("%s%d baseline benchmark%s missing from this run%s\n", allowMissing ? "" : "✗ ",
+               missing, missing == 1 ? " is" : "s are", allowMissing ? " (allowed)" : "");
+    }
+    if (regressions > 0 || (missing > 0 && !allowMissing)) return 1;
+    printf("✓ No regressions\n");
+    return 0;
+}
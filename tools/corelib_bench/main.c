@@ -0,0 +1,249 @@
+/**
+ * @file main.c
+ * @brief Microbenchmarks for corelib's per-tick kernels.
+ * 
+ * Times animation updates, obstacle collision, the spatial hash and the
+ * arena and pool allocators on synthetic data sized like a busy game, with
+ * no window or GPU. The spatial hash holds the same columns as the obstacle
+ * field, so its circle query compares directly with the brute-force kernel.
+ * Each sample is one batch of calls long enough to time reliably, reported
+ * as nanoseconds per operation.
+ * 
+ * Usage: corelib_bench [--samples N] [--json FILE]
+ * 
+ * With --json the results are also written as benchmark JSON (see
+ * corelib/stats.h), which bench_compare checks against a baseline.
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_ANIMATIONS 1024           /**< Animations updated per operation batch. */
+#define BENCH_ANIMATION_FRAMES 4        /**< Frames in each animation. */
+#define BENCH_OBSTACLES 8               /**< Columns on screen, a few more than the game keeps. */
+#define BENCH_CIRCLES 256               /**< Circles per collision batch. */
+#define BENCH_ALLOCATIONS 256           /**< Allocations per allocator batch. */
+#define BENCH_SPATIAL_CELL 64.0f        /**< The spatial hash's cell edge. */
+#define BENCH_SCROLL_STEP 1.7f          /**< Pixels the hashed columns scroll per batch, as a game tick does. */
+#define BENCH_MIN_BATCH_NANOS 50000     /**< The shortest batch that is timed, in nanoseconds. */
+#define BENCH_WARMUP_BATCHES 8          /**< Untimed batches before sampling. */
+
+/**
+ * @brief The data every benchmark reads and writes.
+ * 
+ */
+typedef struct {
+    Animation anims[BENCH_ANIMATIONS];  /**< Looping animations with staggered timers. */
+    ObstacleField field;                /**< Columns spread across the screen. */
+    float cx[BENCH_CIRCLES];            /**< Circle centers across the field. */
+    float cy[BENCH_CIRCLES];            /**< Circle centers down the field. */
+    uint32_t hits[(BENCH_CIRCLES + 31) / 32];   /**< The batch collision result. */
+    SpatialHash spatial;                /**< The field's top and bottom parts, entries 2i and 2i + 1. */
+    float scroll;                       /**< How far the scroll benchmark has moved the hashed columns. */
+    Arena arena;                        /**< The arena the allocator benchmark fills and resets. */
+    ObjectPool pool;                    /**< The pool the allocator benchmark fills and drains. */
+    PoolHandle handles[BENCH_ALLOCATIONS];  /**< The handles acquired in one batch. */
+    volatile uintptr_t sink;            /**< Keeps results alive so calls are not optimized out. */
+} BenchState;
+
+/**
+ * @brief One benchmark.
+ * 
+ */
+typedef struct {
+    const char *name;                           /**< The result name. */
+    int ops;                                    /**< Operations per call of run. */
+    void (*run)(BenchState *state);             /**< Runs one batch of ops operations. */
+} BenchCase;
+
+static void BenchUpdateAnimations(BenchState *state) {
+    UpdateAnimations(state->anims, BENCH_ANIMATIONS, 1.0f / 120.0f);
+    state->sink += (uintptr_t)state->anims[0].currentFrame;
+}
+
+static void BenchCollideCircle(BenchState *state) {
+    int hits = 0;
+    for (int i = 0; i < BENCH_CIRCLES; i++) {
+        hits += CollideObstaclesCircle(&state->field, (Vector2){ state->cx[i], state->cy[i] }, 17.0f) >= 0;
+    }
+    state->sink += (uintptr_t)hits;
+}
+
+static void BenchCollideCircles(BenchState *state) {
+    state->sink += (uintptr_t)CollideObstaclesCircles(&state->field, state->cx, state->cy, BENCH_CIRCLES, 17.0f,
+                                                      state->hits);
+}
+
+static void BenchQuerySpatialCircle(BenchState *state) {
+    int ids[2 * BENCH_OBSTACLES];
+    int hits = 0;
+    for (int i = 0; i < BENCH_CIRCLES; i++) {
+        Vector2 center = { state->cx[i], state->cy[i] };
+        hits += QuerySpatialCircle(&state->spatial, center, 17.0f, ids, 2 * BENCH_OBSTACLES) > 0;
+    }
+    state->sink += (uintptr_t)hits;
+}
+
+// Scrolls the hashed columns left and wraps them, so most moves stay in
+// their cells and some relink, as when a game scrolls its obstacles.
+static void BenchScrollSpatial(BenchState *state) {
+    state->scroll += BENCH_SCROLL_STEP;
+    if (state->scroll >= 1000.0f) state->scroll -= 1000.0f;
+    for (int i = 0; i < BENCH_OBSTACLES; i++) {
+        Rectangle top = GetObstacleTopRec(&state->field, i);
+        Rectangle bottom = GetObstacleBottomRec(&state->field, i);
+        top.x -= state->scroll;
+        if (top.x < -top.width) top.x += 1000.0f;
+        bottom.x = top.x;
+        state->sink += SetSpatialEntry(&state->spatial, 2 * i, top);
+        state->sink += SetSpatialEntry(&state->spatial, 2 * i + 1, bottom);
+    }
+}
+
+static void BenchArenaAlloc(BenchState *state) {
+    for (int i = 0; i < BENCH_ALLOCATIONS; i++) {
+        state->sink += (uintptr_t)ArenaAlloc(&state->arena, 48);
+    }
+    ResetArena(&state->arena);
+}
+
+static void BenchPoolAcquireRelease(BenchState *state) {
+    for (int i = 0; i < BENCH_ALLOCATIONS; i++) state->handles[i] = AcquirePoolObject(&state->pool);
+    for (int i = 0; i < BENCH_ALLOCATIONS; i++) ReleasePoolObject(&state->pool, state->handles[i]);
+    state->sink += state->handles[BENCH_ALLOCATIONS - 1];
+}
+
+static const BenchCase benchCases[] = {
+    { "corelib/UpdateAnimations", BENCH_ANIMATIONS, BenchUpdateAnimations },
+    { "corelib/CollideObstaclesCircle", BENCH_CIRCLES, BenchCollideCircle },
+    { "corelib/CollideObstaclesCircles", BENCH_CIRCLES, BenchCollideCircles },
+    { "corelib/QuerySpatialCircle", BENCH_CIRCLES, BenchQuerySpatialCircle },
+    { "corelib/ScrollSpatialEntries", 2 * BENCH_OBSTACLES, BenchScrollSpatial },
+    { "corelib/ArenaAlloc", BENCH_ALLOCATIONS, BenchArenaAlloc },
+    { "corelib/PoolAcquireRelease", BENCH_ALLOCATIONS, BenchPoolAcquireRelease },
+};
+
+/**
+ * @brief Builds the benchmark data from a fixed seed, so runs compare.
+ * 
+ * @param state The state to fill.
+ * @return true on success, false if memory ran out.
+ */
+static bool InitBenchState(BenchState *state) {
+    Rng rng = CreateRng(1);
+    
+    Rectangle frames[BENCH_ANIMATION_FRAMES];
+    for (int i = 0; i < BENCH_ANIMATION_FRAMES; i++) frames[i] = (Rectangle){ 34.0f * (float)i, 0.0f, 34.0f, 24.0f };
+    for (int i = 0; i < BENCH_ANIMATIONS; i++) {
+        state->anims[i] = CreateAnimation(NULL, (Texture2D){0}, frames, BENCH_ANIMATION_FRAMES, 0.1f, true);
+        if (state->anims[i].frames == NULL) return false;
+        state->anims[i].frameTimer = RandomFloat(&rng) * 0.1f;
+    }
+    
+    state->field = CreateObstacleField(NULL, BENCH_OBSTACLES, 150.0f, 600.0f);
+    if (state->field.capacity == 0) return false;
+    for (int i = 0; i < BENCH_OBSTACLES; i++) {
+        AddObstacle(&state->field, 100.0f + 110.0f * (float)i, 50.0f + RandomFloat(&rng) * 350.0f, 52.0f);
+    }
+    for (int i = 0; i < BENCH_CIRCLES; i++) {
+        state->cx[i] = RandomFloat(&rng) * 1000.0f;
+        state->cy[i] = RandomFloat(&rng) * 600.0f;
+    }
+    
+    // A column spans at most two cells across and the screen's height down.
+    int links = 2 * BENCH_OBSTACLES * 2 * ((int)(600.0f / BENCH_SPATIAL_CELL) + 2);
+    state->spatial = CreateSpatialHash(NULL, 2 * BENCH_OBSTACLES, links, BENCH_SPATIAL_CELL);
+    if (state->spatial.entryCapacity == 0) return false;
+    for (int i = 0; i < BENCH_OBSTACLES; i++) {
+        SetSpatialEntry(&state->spatial, 2 * i, GetObstacleTopRec(&state->field, i));
+        SetSpatialEntry(&state->spatial, 2 * i + 1, GetObstacleBottomRec(&state->field, i));
+    }
+    
+    state->arena = CreateArena(64 * BENCH_ALLOCATIONS);
+    state->pool = CreateObjectPool(NULL, BENCH_ALLOCATIONS, 32);
+    return state->arena.base != NULL && state->pool.capacity > 0;
+}
+
+static void DestroyBenchState(BenchState *state) {
+    for (int i = 0; i < BENCH_ANIMATIONS; i++) DestroyAnimation(&state->anims[i]);
+    DestroyObstacleField(&state->field);
+    DestroySpatialHash(&state->spatial);
+    DestroyArena(&state->arena);
+    DestroyObjectPool(&state->pool);
+}
+
+/**
+ * @brief Times one benchmark.
+ * 
+ * Warms up, then repeats the batch until one sample takes at least
+ * BENCH_MIN_BATCH_NANOS, so the clock's resolution stays out of the result.
+ * 
+ * @param state The benchmark data.
+ * @param bench The benchmark.
+ * @param samples The number of samples to take.
+ * @param set Receives nanoseconds per operation, one entry per sample.
+ */
+static void RunBenchCase(BenchState *state, const BenchCase *bench, int samples, SampleSet *set) {
+    for (int i = 0; i < BENCH_WARMUP_BATCHES; i++) bench->run(state);
+    
+    int repeats = 1;
+    for (;;) {
+        uint64_t start = GetClockNanos();
+        for (int i = 0; i < repeats; i++) bench->run(state);
+        if (GetClockNanos() - start >= BENCH_MIN_BATCH_NANOS || repeats >= (1 << 20)) break;
+        repeats *= 2;
+    }
+    
+    for (int s = 0; s < samples; s++) {
+        uint64_t start = GetClockNanos();
+        for (int i = 0; i < repeats; i++) bench->run(state);
+        uint64_t elapsed = GetClockNanos() - start;
+        AddSample(set, (double)elapsed / ((double)repeats * (double)bench->ops));
+    }
+}
+
+int main(int argc, char **argv) {
+    int samples = 200;
+    const char *jsonFile = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) samples = (int)strtol(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonFile = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--samples N] [--json FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (samples < 1) samples = 1;
+    SetTraceLogLevel(LOG_WARNING);
+    
+    BenchState *state = calloc(1, sizeof(BenchState));
+    if (state == NULL || !InitBenchState(state)) {
+        fprintf(stderr, "corelib_bench: out of memory\n");
+        return 1;
+    }
+    
+    int count = (int)(sizeof(benchCases) / sizeof(benchCases[0]));
+    BenchmarkResult results[sizeof(benchCases) / sizeof(benchCases[0])];
+    printf("%-36s %10s %10s %10s %10s\n", "benchmark (ns/op)", "mean", "p50", "p99", "max");
+    for (int i = 0; i < count; i++) {
+        SampleSet set = {0};
+        RunBenchCase(state, &benchCases[i], samples, &set);
+        results[i] = CreateBenchmarkResult(benchCases[i].name, "ns", &set);
+        DestroySampleSet(&set);
+    
+        const SampleSummary *s = &results[i].summary;
+        printf("%-36s %10.2f %10.2f %10.2f %10.2f\n", benchCases[i].name, s->mean, s->p50, s->p99, s->max);
+    }
+    DestroyBenchState(state);
+    free(state);
+    
+    if (jsonFile != NULL && !SaveBenchmarkResults(jsonFile, results, count)) {
+        fprintf(stderr, "corelib_bench: cannot write %s\n", jsonFile);
+        return 1;
+    }
+    return 0;
+}
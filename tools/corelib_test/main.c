@@ -0,0 +1,550 @@
+/**
+ * @file main.c
+ * @brief Behavior tests for corelib modules that run without a window or GPU.
+ * 
+ * Each test builds its input in memory or in a scratch file, calls the
+ * module the way a game does and checks the results. A failed check prints
+ * its file, line and expression, and the run exits non-zero if any failed.
+ * 
+ * Usage: corelib_test [--scratch DIR]
+ * 
+ * Scratch files are written to DIR (default: the current directory) and
+ * removed afterwards.
+ * 
+ */
+
+#include "raylib.h"
+#include "corelib.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_PATH_LENGTH 512    /**< The longest scratch file path. */
+
+static int checksFailed;
+
+#define CHECK(expr) do { \
+        if (!(expr)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+            checksFailed++; \
+        } \
+    } while (0)
+
+/**
+ * @brief One test.
+ * 
+ */
+typedef struct {
+    const char *name;                           /**< The test name. */
+    void (*run)(const char *scratch);           /**< Runs the test, writing any files under scratch. */
+} TestCase;
+
+/**
+ * @brief One entry of a test archive, before it is laid out.
+ * 
+ */
+typedef struct {
+    const char *name;       /**< The entry's path, hashed into its nameHash. */
+    ArchiveEntryType type;  /**< The entry type. */
+    int format;             /**< The PixelFormat of image and atlas entries. */
+    uint64_t size;          /**< The data bytes written for the entry. */
+    uint32_t params[4];     /**< The type-specific fields. */
+} TestEntry;
+
+static int CompareArchiveEntries(const void *a, const void *b) {
+    uint32_t ha = ((const ArchiveEntry *)a)->nameHash;
+    uint32_t hb = ((const ArchiveEntry *)b)->nameHash;
+    return ha < hb ? -1 : ha > hb;
+}
+
+/**
+ * @brief Writes an archive laid out as asset_packer lays it out.
+ * 
+ * Entry data is filled with a byte pattern; only the sizes matter here.
+ * 
+ * @param fileName The file to write.
+ * @param entries The entries.
+ * @param count The number of entries.
+ * @param cut Bytes dropped from the end of the file, to truncate it.
+ * @return true on success, false if the file could not be written.
+ */
+static bool WriteTestArchive(const char *fileName, const TestEntry *entries, int count, size_t cut) {
+    ArchiveEntry table[8] = {0};
+    if (count > 8) return false;
+    
+    size_t dataOffset = (ARCHIVE_HEADER_SIZE + sizeof(ArchiveEntry) * (size_t)count + ARCHIVE_ALIGN - 1)
+                      & ~(size_t)(ARCHIVE_ALIGN - 1);
+    size_t fileSize = dataOffset;
+    for (int i = 0; i < count; i++) {
+        table[i] = (ArchiveEntry){
+            .nameHash = HashAtlasName(entries[i].name),
+            .type = (uint16_t)entries[i].type,
+            .format = (uint16_t)entries[i].format,
+            .offset = fileSize,
+            .size = entries[i].size,
+        };
+        memcpy(table[i].params, entries[i].params, sizeof(table[i].params));
+        fileSize += ((size_t)entries[i].size + ARCHIVE_ALIGN - 1) & ~(size_t)(ARCHIVE_ALIGN - 1);
+    }
+    qsort(table, (size_t)count, sizeof(ArchiveEntry), CompareArchiveEntries);
+    
+    unsigned char *data = malloc(fileSize);
+    if (data == NULL) return false;
+    for (size_t i = 0; i < fileSize; i++) data[i] = (unsigned char)(i * 31);
+    uint32_t magic = ARCHIVE_MAGIC;
+    uint16_t version = ARCHIVE_VERSION;
+    uint16_t entryCount = (uint16_t)count;
+    uint32_t dataStart = (uint32_t)dataOffset;
+    uint32_t reserved = 0;
+    memcpy(data, &magic, 4);
+    memcpy(data + 4, &version, 2);
+    memcpy(data + 6, &entryCount, 2);
+    memcpy(data + 8, &dataStart, 4);
+    memcpy(data + 12, &reserved, 4);
+    memcpy(data + ARCHIVE_HEADER_SIZE, table, sizeof(ArchiveEntry) * (size_t)count);
+    
+    FILE *file = fopen(fileName, "wb");
+    bool ok = file != NULL && fwrite(data, 1, fileSize - cut, file) == fileSize - cut;
+    if (file != NULL && fclose(file) != 0) ok = false;
+    free(data);
+    return ok;
+}
+
+// A well-formed entry of each type: a 4x4 image, 100 stereo 16-bit frames,
+// an 8x8 atlas with two regions and some raw bytes.
+static const TestEntry validEntries[] = {
+    { "textures/bird.png", ARCHIVE_IMAGE, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 4 * 4 * 4, { 4, 4, 1, 0 } },
+    { "audio/flap.wav", ARCHIVE_WAVE, 0, 100 * 2 * 2, { 100, 22050, 16, 2 } },
+    { "textures.atlas", ARCHIVE_ATLAS, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 64 + 8 * 8 * 4, { 8, 8, 1, 2 } },
+    { "animations.anim", ARCHIVE_RAW, 0, 10, { 0 } },
+};
+#define VALID_ENTRY_COUNT ((int)(sizeof(validEntries) / sizeof(validEntries[0])))
+
+static void TestArchiveValid(const char *scratch) {
+    char path[TEST_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%s/corelib_test.pak", scratch);
+    CHECK(WriteTestArchive(path, validEntries, VALID_ENTRY_COUNT, 0));
+    
+    AssetArchive archive;
+    CHECK(OpenAssetArchive(&archive, path));
+    CHECK(archive.entryCount == VALID_ENTRY_COUNT);
+    
+    Image image = GetArchiveImage(&archive, FindArchiveEntry(&archive, "textures/bird.png"));
+    CHECK(image.data != NULL && image.width == 4 && image.height == 4 && image.mipmaps == 1);
+    Wave wave = GetArchiveWave(&archive, FindArchiveEntry(&archive, "audio/flap.wav"));
+    CHECK(wave.data != NULL && wave.frameCount == 100 && wave.sampleSize == 16 && wave.channels == 2);
+    TextureAtlas atlas;
+    Image pixels;
+    CHECK(GetArchiveAtlas(&archive, FindArchiveEntry(&archive, "textures.atlas"), &atlas, &pixels));
+    CHECK(atlas.regionCount == 2 && pixels.width == 8 && pixels.height == 8);
+    free(atlas.regions);
+    size_t size = 0;
+    CHECK(GetArchiveData(&archive, FindArchiveEntry(&archive, "animations.anim"), &size) != NULL && size == 10);
+    CHECK(FindArchiveEntry(&archive, "missing.png") == -1);
+    
+    CloseAssetArchive(&archive);
+    remove(path);
+}
+
+static void TestArchiveCorruptEntries(const char *scratch) {
+    char path[TEST_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%s/corelib_test.pak", scratch);
+    
+    // Each corruption makes one entry's parameters describe more data than
+    // it holds, or describe no valid asset at all.
+    struct {
+        int entry;          /**< The entry to corrupt. */
+        int param;          /**< The parameter to change, or -1 for the size, -2 for the format. */
+        uint64_t value;     /**< Its new value. */
+    } corruptions[] = {
+        { 0, -1, 4 * 4 * 4 - 1 },       // image one byte short
+        { 0, 0, 5 },                    // image wider than its pixels
+        { 0, 2, 2 },                    // image mipmaps that are not stored
+        { 0, 1, 0 },                    // image with no height
+        { 0, -2, 0 },                   // image with no pixel format
+        { 0, 0, 0xFFFFFFFFu },          // image too large for GetPixelDataSize
+        { 1, -1, 100 * 2 * 2 - 1 },     // wave one byte short
+        { 1, 0, 101 },                  // wave with a frame more than stored
+        { 1, 3, 3 },                    // wave with a channel more than stored
+        { 1, 2, 12 },                   // wave with no valid sample size
+        { 1, 0, 0xFFFFFFFFu },          // wave far larger than the file
+        { 2, -1, 64 + 8 * 8 * 4 - 1 },  // atlas pixels one byte short
+        { 2, 3, 4 },                    // atlas table pushing the pixels past the end
+        { 2, 1, 9 },                    // atlas taller than its pixels
+    };
+    
+    for (int i = 0; i < (int)(sizeof(corruptions) / sizeof(corruptions[0])); i++) {
+        TestEntry entries[VALID_ENTRY_COUNT];
+        memcpy(entries, validEntries, sizeof(entries));
+        TestEntry *e = &entries[corruptions[i].entry];
+        if (corruptions[i].param == -1) e->size = corruptions[i].value;
+        else if (corruptions[i].param == -2) e->format = (int)corruptions[i].value;
+        else e->params[corruptions[i].param] = (uint32_t)corruptions[i].value;
+        CHECK(WriteTestArchive(path, entries, VALID_ENTRY_COUNT, 0));
+    
+        AssetArchive archive;
+        bool opened = OpenAssetArchive(&archive, path);
+        if (opened) fprintf(stderr, "corruption %d was accepted\n", i);
+        CHECK(!opened && archive.base == NULL && archive.entryCount == 0);
+        if (opened) CloseAssetArchive(&archive);
+    }
+    remove(path);
+}
+
+static void TestArchiveTruncatedFile(const char *scratch) {
+    char path[TEST_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%s/corelib_test.pak", scratch);
+    
+    // The last entry's data is cut short by the end of the file.
+    TestEntry entries[VALID_ENTRY_COUNT];
+    memcpy(entries, validEntries, sizeof(entries));
+    entries[VALID_ENTRY_COUNT - 1].size = ARCHIVE_ALIGN;
+    CHECK(WriteTestArchive(path, entries, VALID_ENTRY_COUNT, 1));
+    
+    AssetArchive archive;
+    CHECK(!OpenAssetArchive(&archive, path));
+    CHECK(!MountAssetArchive(path, "assets/test"));
+    
+    // A file that ends inside the header is not an archive.
+    CHECK(WriteTestArchive(path, NULL, 0, ARCHIVE_ALIGN - ARCHIVE_HEADER_SIZE + 1));
+    CHECK(!OpenAssetArchive(&archive, path));
+    remove(path);
+}
+
+static void TestInputReplayOutcome(const char *scratch) {
+    char path[TEST_PATH_LENGTH];
+    snprintf(path, sizeof(path), "%s/corelib_test.rec", scratch);
+    
+    // Record a session of a few runs and store how it ended.
+    InputStream stream = {0};
+    StartInputRecording(&stream, 42, 120.0f);
+    for (int t = 0; t < 300; t++) {
+        PushInput(&stream, t % 37 == 0 ? 1u : 0u);
+        NextTickInput(&stream);
+    }
+    SetInputRecordingOutcome(&stream.recording, 7, 0xC0FFEEu);
+    CHECK(SaveInputRecording(&stream.recording, path));
+    CloseInputStream(&stream);
+    
+    // Replay it: the same end passes, and any other score, state or tick fails.
+    CHECK(StartInputReplay(&stream, path));
+    CHECK(stream.recording.seed == 42 && stream.recording.tickCount == 300 && stream.recording.hasOutcome);
+    uint32_t flaps = 0;
+    while (!IsInputReplayFinished(&stream)) flaps += NextTickInput(&stream);
+    CHECK(flaps == 9);
+    CHECK(CheckInputReplayOutcome(&stream, 7, 0xC0FFEEu));
+    CHECK(!CheckInputReplayOutcome(&stream, 8, 0xC0FFEEu));
+    CHECK(!CheckInputReplayOutcome(&stream, 7, 0xC0FFEFu));
+    NextTickInput(&stream);
+    CHECK(!CheckInputReplayOutcome(&stream, 7, 0xC0FFEEu));
+    CloseInputStream(&stream);
+    
+    // A recording saved without an outcome only checks the tick count.
+    StartInputRecording(&stream, 1, 120.0f);
+    for (int t = 0; t < 10; t++) NextTickInput(&stream);
+    CHECK(SaveInputRecording(&stream.recording, path));
+    CHECK(StartInputReplay(&stream, path));
+    CHECK(!stream.recording.hasOutcome);
+    while (!IsInputReplayFinished(&stream)) NextTickInput(&stream);
+    CHECK(CheckInputReplayOutcome(&stream, 0, 0));
+    CloseInputStream(&stream);
+    remove(path);
+}
+
+// Whether ids[0..count) holds id exactly once.
+static bool ContainsOnce(const int *ids, int count, int id) {
+    int seen = 0;
+    for (int i = 0; i < count; i++) seen += ids[i] == id;
+    return seen == 1;
+}
+
+static void TestSpatialInsertMoveRemove(const char *scratch) {
+    (void)scratch;
+    SpatialHash hash = CreateSpatialHash(NULL, 4, 64, 32.0f);
+    CHECK(hash.entryCapacity == 4);
+    int ids[8];
+    
+    // A box spanning a 4x4 block of cells is reported once by a query over
+    // all of them; boxes elsewhere are not reported.
+    CHECK(SetSpatialEntry(&hash, 0, (Rectangle){ 10, 10, 100, 100 }));
+    CHECK(SetSpatialEntry(&hash, 1, (Rectangle){ 300, 300, 10, 10 }));
+    CHECK(SetSpatialEntry(&hash, 2, (Rectangle){ -50, -50, 20, 20 }));
+    int n = QuerySpatialRec(&hash, (Rectangle){ 0, 0, 128, 128 }, ids, 8);
+    CHECK(n == 1 && ContainsOnce(ids, n, 0));
+    n = QuerySpatialRec(&hash, (Rectangle){ -100, -100, 500, 500 }, ids, 8);
+    CHECK(n == 3 && ContainsOnce(ids, n, 0) && ContainsOnce(ids, n, 1) && ContainsOnce(ids, n, 2));
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ -100, -100, 500, 500 }, ids, 2) == 2);
+    
+    // The circle query is exact: it covers the box's cell but misses its corner.
+    CHECK(QuerySpatialCircle(&hash, (Vector2){ 295, 295 }, 6.0f, ids, 8) == 0);
+    n = QuerySpatialCircle(&hash, (Vector2){ 295, 305 }, 6.0f, ids, 8);
+    CHECK(n == 1 && ids[0] == 1);
+    
+    // A move inside the same cells keeps the links but not the old box.
+    int freeLinks = 0;
+    for (int l = hash.freeLink; l >= 0; l = hash.links[l].next) freeLinks++;
+    CHECK(SetSpatialEntry(&hash, 1, (Rectangle){ 305, 305, 4, 4 }));
+    int freeAfter = 0;
+    for (int l = hash.freeLink; l >= 0; l = hash.links[l].next) freeAfter++;
+    CHECK(freeAfter == freeLinks);
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ 300, 300, 4, 4 }, ids, 8) == 0);
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ 306, 306, 1, 1 }, ids, 8) == 1);
+    
+    // A move across cells relinks: the old cells no longer report it.
+    CHECK(SetSpatialEntry(&hash, 1, (Rectangle){ 1000, -400, 10, 10 }));
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ 290, 290, 40, 40 }, ids, 8) == 0);
+    n = QuerySpatialRec(&hash, (Rectangle){ 990, -410, 40, 40 }, ids, 8);
+    CHECK(n == 1 && ids[0] == 1);
+    
+    // Removing returns the links; ids outside the table are refused.
+    RemoveSpatialEntry(&hash, 0);
+    RemoveSpatialEntry(&hash, 0);
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ 0, 0, 128, 128 }, ids, 8) == 0);
+    CHECK(!SetSpatialEntry(&hash, 4, (Rectangle){ 0, 0, 1, 1 }));
+    CHECK(!SetSpatialEntry(&hash, -1, (Rectangle){ 0, 0, 1, 1 }));
+    
+    // A box needing more links than are free is left out whole.
+    CHECK(!SetSpatialEntry(&hash, 3, (Rectangle){ 0, 0, 32 * 20, 32 * 20 }));
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ 0, 0, 64, 64 }, ids, 8) == 0);
+    CHECK(SetSpatialEntry(&hash, 3, (Rectangle){ 0, 0, 100, 100 }));
+    CHECK(QuerySpatialRec(&hash, (Rectangle){ 0, 0, 64, 64 }, ids, 8) == 1);
+    DestroySpatialHash(&hash);
+}
+
+static void TestSpatialMatchesObstacles(const char *scratch) {
+    (void)scratch;
+    enum { COLUMNS = 8, TICKS = 100, CIRCLES_PER_TICK = 20 };
+    Rng rng = CreateRng(7);
+    ObstacleField field = CreateObstacleField(NULL, COLUMNS, 150.0f, 600.0f);
+    SpatialHash hash = CreateSpatialHash(NULL, 2 * COLUMNS, 2 * COLUMNS * 32, 64.0f);
+    CHECK(field.capacity == COLUMNS && hash.entryCapacity == 2 * COLUMNS);
+    
+    // Scroll the columns the way the game does, relinking each tick, and
+    // check every circle against the brute-force kernel as they move.
+    for (int i = 0; i < COLUMNS; i++) {
+        AddObstacle(&field, 100.0f + 110.0f * (float)i, 50.0f + RandomFloat(&rng) * 350.0f, 52.0f);
+    }
+    int ids[2 * COLUMNS];
+    int mismatches = 0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        ScrollObstacles(&field, -1.7f);
+        for (int i = 0; i < COLUMNS; i++) {
+            CHECK(SetSpatialEntry(&hash, 2 * i, GetObstacleTopRec(&field, i)));
+            CHECK(SetSpatialEntry(&hash, 2 * i + 1, GetObstacleBottomRec(&field, i)));
+        }
+        for (int c = 0; c < CIRCLES_PER_TICK; c++) {
+            Vector2 center = { RandomFloat(&rng) * 1000.0f, RandomFloat(&rng) * 590.0f };
+            bool brute = CollideObstaclesCircle(&field, center, 17.0f) >= 0;
+            int n = QuerySpatialCircle(&hash, center, 17.0f, ids, 2 * COLUMNS);
+            mismatches += brute != (n > 0);
+            for (int k = 0; k < n; k++) mismatches += !ContainsOnce(ids, n, ids[k]);
+        }
+    }
+    CHECK(mismatches == 0);
+    DestroySpatialHash(&hash);
+    DestroyObstacleField(&field);
+}
+
+// The stats ProfilerFrameMark last totalled for the zone called name.
+static const ProfilerZoneStats *FindProfilerZone(const char *name) {
+    const ProfilerStats *stats = GetProfilerStats();
+    for (int i = 0; i < stats->zoneCount; i++) {
+        if (strcmp(stats->zones[i].name, name) == 0) return &stats->zones[i];
+    }
+    return NULL;
+}
+
+static void *RecordWorkerZone(void *arg) {
+    (void)arg;
+    ProfilerBeginZone("test/worker");
+    ProfilerEndZone();
+    return NULL;
+}
+
+static void TestProfilerWorkerZones(const char *scratch) {
+    (void)scratch;
+    
+    // A zone closed on another thread counts toward the frame it ended in,
+    // next to the marking thread's own.
+    ProfilerFrameMark();
+    ProfilerBeginZone("test/main");
+    ProfilerEndZone();
+    pthread_t worker;
+    CHECK(pthread_create(&worker, NULL, RecordWorkerZone, NULL) == 0);
+    pthread_join(worker, NULL);
+    ProfilerFrameMark();
+    const ProfilerZoneStats *mainZone = FindProfilerZone("test/main");
+    const ProfilerZoneStats *workerZone = FindProfilerZone("test/worker");
+    CHECK(mainZone != NULL && mainZone->calls == 1);
+    CHECK(workerZone != NULL && workerZone->calls == 1);
+    
+    // The next frame starts empty.
+    ProfilerFrameMark();
+    CHECK(mainZone != NULL && mainZone->calls == 0);
+    CHECK(workerZone != NULL && workerZone->calls == 0);
+}
+
+/**
+ * @brief A ParallelFor range test's shared state.
+ * 
+ */
+typedef struct {
+    unsigned char *visits;      /**< Times each index was run. */
+    atomic_llong sum;           /**< The sum of the indices run. */
+    atomic_int calls;           /**< Ranges run. */
+} SumRange;
+
+static void SumIndices(int begin, int end, void *data) {
+    SumRange *range = data;
+    long long sum = 0;
+    for (int i = begin; i < end; i++) {
+        range->visits[i]++;
+        sum += i;
+    }
+    atomic_fetch_add(&range->sum, sum);
+    atomic_fetch_add(&range->calls, 1);
+}
+
+// Runs ParallelFor over count indices and checks each ran exactly once.
+static bool SumsOnce(int count, int grain, int *calls) {
+    SumRange range = { calloc((size_t)count, 1), 0, 0 };
+    if (range.visits == NULL) return false;
+    ParallelFor(count, grain, SumIndices, &range);
+    bool once = true;
+    for (int i = 0; i < count; i++) once = once && range.visits[i] == 1;
+    free(range.visits);
+    *calls = atomic_load(&range.calls);
+    return once && atomic_load(&range.sum) == (long long)count * (count - 1) / 2;
+}
+
+static void TestJobsParallelFor(const char *scratch) {
+    (void)scratch;
+    enum { COUNT = 100000, GRAIN = 64 };
+    int calls = 0;
+    
+    // With workers the range is split into grains across the threads.
+    CHECK(InitJobSystem(3));
+    CHECK(GetJobThreadCount() == 4);
+    for (int run = 0; run < 20; run++) {
+        CHECK(SumsOnce(COUNT, GRAIN, &calls));
+        CHECK(calls == (COUNT + GRAIN - 1) / GRAIN);
+    }
+    CHECK(SumsOnce(1, GRAIN, &calls) && calls == 1);
+    CloseJobSystem();
+    
+    // Without them it is one inline call.
+    CHECK(GetJobThreadCount() == 0);
+    CHECK(SumsOnce(COUNT, GRAIN, &calls) && calls == 1);
+}
+
+/**
+ * @brief A job test's shared state.
+ * 
+ */
+typedef struct {
+    atomic_int childrenRun;     /**< Child jobs finished. */
+    atomic_int sequence;        /**< Hands out the order jobs ran in. */
+    int childrenSeen;           /**< childrenRun when the dependent job ran. */
+    int order[3];               /**< When each job of the chain ran. */
+} JobRecord;
+
+/**
+ * @brief One job's view of the shared JobRecord.
+ * 
+ */
+typedef struct {
+    JobRecord *record;          /**< The shared record. */
+    int index;                  /**< The job's place in the chain. */
+} JobSlot;
+
+static void RunChildJob(void *data) {
+    JobRecord *record = data;
+    atomic_fetch_add(&record->childrenRun, 1);
+}
+
+static void RunDependentJob(void *data) {
+    JobRecord *record = data;
+    record->childrenSeen = atomic_load(&record->childrenRun);
+}
+
+static void RunChainJob(void *data) {
+    JobSlot *slot = data;
+    slot->record->order[slot->index] = atomic_fetch_add(&slot->record->sequence, 1);
+}
+
+static void TestJobsDependencies(const char *scratch) {
+    (void)scratch;
+    enum { CHILDREN = 200, ROUNDS = 50 };
+    CHECK(InitJobSystem(3));
+    
+    for (int round = 0; round < ROUNDS; round++) {
+        // A parent finishes only after all its children, and a job that
+        // depends on it runs after that, even when submitted first.
+        JobRecord record = { 0 };
+        Job *parent = CreateJob(NULL, NULL);
+        Job *dependent = CreateJob(RunDependentJob, &record);
+        AddJobDependency(dependent, parent);
+        SubmitJob(dependent);
+        for (int i = 0; i < CHILDREN; i++) SubmitJob(CreateChildJob(parent, RunChildJob, &record));
+        SubmitJob(parent);
+        WaitForJob(dependent);
+        CHECK(IsJobFinished(parent));
+        CHECK(record.childrenSeen == CHILDREN);
+        
+        // A chain submitted back to front still runs front to back.
+        JobSlot slots[3] = { { &record, 0 }, { &record, 1 }, { &record, 2 } };
+        Job *chain[3];
+        for (int i = 0; i < 3; i++) chain[i] = CreateJob(RunChainJob, &slots[i]);
+        AddJobDependency(chain[1], chain[0]);
+        AddJobDependency(chain[2], chain[1]);
+        for (int i = 2; i >= 0; i--) SubmitJob(chain[i]);
+        WaitForJob(chain[2]);
+        CHECK(record.order[0] < record.order[1] && record.order[1] < record.order[2]);
+        
+        // A dependency that already finished holds nothing back.
+        Job *late = CreateJob(RunChildJob, &record);
+        AddJobDependency(late, chain[0]);
+        SubmitJob(late);
+        WaitForJob(late);
+        CHECK(atomic_load(&record.childrenRun) == CHILDREN + 1);
+    }
+    CloseJobSystem();
+}
+
+static const TestCase testCases[] = {
+    { "archive/valid", TestArchiveValid },
+    { "archive/corrupt_entries", TestArchiveCorruptEntries },
+    { "archive/truncated_file", TestArchiveTruncatedFile },
+    { "input/replay_outcome", TestInputReplayOutcome },
+    { "spatial/insert_move_remove", TestSpatialInsertMoveRemove },
+    { "spatial/matches_obstacles", TestSpatialMatchesObstacles },
+    { "profiler/worker_zones", TestProfilerWorkerZones },
+    { "jobs/parallel_for", TestJobsParallelFor },
+    { "jobs/dependencies", TestJobsDependencies },
+};
+
+int main(int argc, char **argv) {
+    const char *scratch = ".";
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--scratch") == 0 && i + 1 < argc) scratch = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--scratch DIR]\n", argv[0]);
+            return 1;
+        }
+    }
+    SetTraceLogLevel(LOG_NONE);
+    
+    int count = (int)(sizeof(testCases) / sizeof(testCases[0]));
+    int failed = 0;
+    for (int i = 0; i < count; i++) {
+        int before = checksFailed;
+        testCases[i].run(scratch);
+        bool passed = checksFailed == before;
+        failed += !passed;
+        printf("%-4s %s\n", passed ? "ok" : "FAIL", testCases[i].name);
+    }
+    printf("%d of %d tests passed\n", count - failed, count);
+    return failed > 0 ? 1 : 0;
+}